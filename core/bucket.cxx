@@ -33,6 +33,7 @@
 #include "core/protocol/hello_feature.hxx"
 #include "core/response_handler.hxx"
 #include "core/service_type.hxx"
+#include "core/topology/vbucket_routing_table.hxx"
 #include "core/tracing/tracer_wrapper.hxx"
 #include "core/utils/movable_function.hxx"
 #include "dispatcher.hxx"
@@ -56,6 +57,7 @@
 #include <asio/ssl/context.hpp>
 #include <gsl/span>
 #include <spdlog/fmt/bundled/core.h>
+#include <tao/json/value.hpp>
 
 #include <algorithm>
 #include <chrono>
@@ -75,6 +77,14 @@
 
 namespace couchbase::core
 {
+namespace
+{
+// backoff of replacing the pooled KV sessions, that have been closed or failed to bootstrap
+constexpr std::chrono::milliseconds session_pool_refill_min_backoff{ 100 };
+constexpr std::chrono::milliseconds session_pool_refill_max_backoff{ 10'000 };
+constexpr std::size_t max_session_pool_failures{ 10 };
+} // namespace
+
 class bucket_impl
   : public std::enable_shared_from_this<bucket_impl>
   , public config_listener
@@ -335,9 +345,8 @@ public:
   [[nodiscard]] auto server_by_vbucket(std::uint16_t vbucket, std::size_t node_index)
     -> std::optional<std::size_t>
   {
-    const std::scoped_lock lock(config_mutex_);
-    if (config_) {
-      return config_->server_by_vbucket(vbucket, node_index);
+    if (auto table = routing_table(); table) {
+      return table->server_by_vbucket(vbucket, node_index);
     }
     return std::nullopt;
   }
@@ -345,9 +354,8 @@ public:
   [[nodiscard]] auto map_id(const document_id& id)
     -> std::pair<std::uint16_t, std::optional<std::size_t>>
   {
-    const std::scoped_lock lock(config_mutex_);
-    if (config_) {
-      return config_->map_key(id.key(), id.node_index());
+    if (auto table = routing_table(); table) {
+      return table->map_key(id.key(), id.node_index());
     }
     return { 0, std::nullopt };
   }
@@ -364,13 +372,21 @@ public:
   [[nodiscard]] auto map_id(const std::vector<std::byte>& key, std::size_t node_index)
     -> std::pair<std::uint16_t, std::optional<std::size_t>>
   {
-    const std::scoped_lock lock(config_mutex_);
-    if (config_) {
-      return config_->map_key(key, node_index);
+    if (auto table = routing_table(); table) {
+      return table->map_key(key, node_index);
     }
     return { 0, std::nullopt };
   }
 
+  /**
+   * Returns the routing snapshot of the current configuration without taking config_mutex_.
+   */
+  [[nodiscard]] auto routing_table() const
+    -> std::shared_ptr<const topology::vbucket_routing_table>
+  {
+    return std::atomic_load(&routing_table_);
+  }
+
   void connect_session(std::size_t index)
   {
     const std::scoped_lock lock(config_mutex_, sessions_mutex_);
@@ -413,6 +429,7 @@ public:
           self->remove_session(id);
         });
         self->drain_deferred_queue({});
+        self->fill_session_pool(session);
       },
       true);
     sessions_.insert_or_assign(index, std::move(session));
@@ -511,6 +528,7 @@ public:
             self->remove_session(id);
           });
           self->drain_deferred_queue({});
+          self->fill_session_pool(session);
         },
         true);
       sessions_.insert_or_assign(index, std::move(session));
@@ -518,10 +536,25 @@ public:
     }
   }
 
-  void remove_session(const std::string& id)
+  void remove_session(const std::string& id, bool bootstrap_failed = false)
   {
     bool found{ false };
     const std::scoped_lock lock(sessions_mutex_);
+    for (auto& [address, pool] : session_pools_) {
+      auto ptr = std::find_if(pool.begin(), pool.end(), [&id](const auto& session) {
+        return session.id() == id;
+      });
+      if (ptr != pool.end()) {
+        CB_LOG_DEBUG(R"({} removed pooled session id="{}", address="{}", bootstrap_address="{}")",
+                     log_prefix_,
+                     ptr->id(),
+                     ptr->remote_address(),
+                     address);
+        pool.erase(ptr);
+        schedule_session_pool_refill(address, bootstrap_failed);
+        return;
+      }
+    }
     for (auto ptr = sessions_.cbegin(); ptr != sessions_.cend();) {
       if (ptr->second.id() == id) {
         CB_LOG_DEBUG(R"({} removed session id="{}", address="{}", bootstrap_address="{}:{}")",
@@ -571,11 +604,12 @@ public:
 
         {
           const std::scoped_lock lock(self->sessions_mutex_);
-          self->sessions_.insert_or_assign(this_index, std::move(new_session));
+          self->sessions_.insert_or_assign(this_index, new_session);
         }
         self->update_config(cfg);
         self->drain_deferred_queue({});
         self->poll_config({});
+        self->fill_session_pool(new_session);
       }
       asio::post(
         asio::bind_executor(self->ctx_, [h = std::move(h), ec, cfg = std::move(cfg)]() mutable {
@@ -702,6 +736,7 @@ public:
     }
 
     heartbeat_timer_.cancel();
+    meter_->remove_report_section(report_section_name());
 
     drain_deferred_queue(errc::common::request_canceled);
 
@@ -715,13 +750,26 @@ public:
     }
 
     std::map<size_t, io::mcbp_session> old_sessions;
+    std::map<std::string, std::vector<io::mcbp_session>> old_session_pools;
     {
       const std::scoped_lock lock(sessions_mutex_);
       std::swap(old_sessions, sessions_);
+      std::swap(old_session_pools, session_pools_);
+      for (auto& [address, refill] : session_pool_refills_) {
+        if (refill.timer) {
+          refill.timer->cancel();
+        }
+      }
+      session_pool_refills_.clear();
     }
     for (auto& [index, session] : old_sessions) {
       session.stop(retry_reason::do_not_retry);
     }
+    for (auto& [address, pool] : old_session_pools) {
+      for (auto& session : pool) {
+        session.stop(retry_reason::do_not_retry);
+      }
+    }
   }
 
   /**
@@ -823,6 +871,8 @@ public:
       }
       config_.reset();
       config_ = std::make_shared<topology::configuration>(config);
+      std::atomic_store(&routing_table_,
+                        std::make_shared<const topology::vbucket_routing_table>(*config_));
       configured_ = true;
 
       {
@@ -913,6 +963,7 @@ public:
               self->remove_session(id);
             });
             self->drain_deferred_queue({});
+            self->fill_session_pool(session);
           },
           true);
         new_sessions.insert_or_assign(next_index, std::move(session));
@@ -928,9 +979,19 @@ public:
                      it->second.bootstrap_hostname(),
                      it->second.bootstrap_port(),
                      it->first);
-        asio::post(asio::bind_executor(ctx_, [session = std::move(it->second)]() mutable {
-          return session.stop(retry_reason::do_not_retry);
-        }));
+        std::vector<io::mcbp_session> pool{};
+        if (auto ptr = session_pools_.find(it->second.bootstrap_address());
+            ptr != session_pools_.end()) {
+          pool = std::move(ptr->second);
+          session_pools_.erase(ptr);
+        }
+        asio::post(asio::bind_executor(
+          ctx_, [session = std::move(it->second), pool = std::move(pool)]() mutable {
+            session.stop(retry_reason::do_not_retry);
+            for (auto& pooled : pool) {
+              pooled.stop(retry_reason::do_not_retry);
+            }
+          }));
       }
     }
   }
@@ -939,12 +1000,195 @@ public:
     -> std::optional<io::mcbp_session>
   {
     const std::scoped_lock lock(sessions_mutex_);
-    if (auto ptr = sessions_.find(index); ptr != sessions_.end()) {
-      return ptr->second;
+    auto ptr = sessions_.find(index);
+    if (ptr == sessions_.end()) {
+      return {};
+    }
+    const auto& primary = ptr->second;
+    auto pool = session_pools_.find(primary.bootstrap_address());
+    if (pool == session_pools_.end() || pool->second.empty()) {
+      return primary;
+    }
+
+    // pick the connection with the smallest number of outstanding requests, and among those, with
+    // the smallest number of bytes waiting for the socket, so that a few large values do not hold
+    // back the small ones. The primary session is always a candidate, so that the pool cannot make
+    // routing worse than single connection. Both counters are atomics, so the loop does not take
+    // locks of the sessions.
+    const io::mcbp_session* selected = &primary;
+    auto selected_load = std::make_pair(primary.queue_depth(), primary.pending_write_bytes());
+    for (const auto& session : pool->second) {
+      if (selected_load.first == 0 && selected_load.second == 0) {
+        break;
+      }
+      if (session.is_stopped() || !session.has_config()) {
+        continue;
+      }
+      if (auto load = std::make_pair(session.queue_depth(), session.pending_write_bytes());
+          load < selected_load) {
+        selected = &session;
+        selected_load = load;
+      }
+    }
+    return *selected;
+  }
+
+  [[nodiscard]] auto find_primary_session_by_address(const std::string& address) const
+    -> std::optional<io::mcbp_session>
+  {
+    const std::scoped_lock lock(sessions_mutex_);
+    for (const auto& [index, session] : sessions_) {
+      if (session.bootstrap_address() == address) {
+        return session;
+      }
     }
     return {};
   }
 
+  /**
+   * Opens additional connections to the node of the given session, until the number of
+   * connections reaches kv_connections_per_node.
+   *
+   * @param primary_bootstrapped true if the primary session has just been (re)connected, which
+   * gives the pool another chance after it has been given up because of repeated failures.
+   */
+  void fill_session_pool(const io::mcbp_session& primary, bool primary_bootstrapped = true)
+  {
+    const auto connections_per_node = origin_.options().kv_connections_per_node;
+    if (connections_per_node <= 1 || closed_) {
+      return;
+    }
+
+    std::vector<io::mcbp_session> new_sessions{};
+    {
+      const std::scoped_lock lock(sessions_mutex_);
+      if (std::none_of(sessions_.begin(), sessions_.end(), [&primary](const auto& entry) {
+            return entry.second.id() == primary.id();
+          })) {
+        // the session has been replaced or dropped while it was bootstrapping
+        return;
+      }
+      auto& refill = session_pool_refills_[primary.bootstrap_address()];
+      if (primary_bootstrapped) {
+        refill.failures = 0;
+      } else if (refill.failures >= max_session_pool_failures) {
+        return;
+      }
+      auto& pool = session_pools_[primary.bootstrap_address()];
+      pool.erase(std::remove_if(pool.begin(),
+                                pool.end(),
+                                [](const auto& session) {
+                                  return session.is_stopped();
+                                }),
+                 pool.end());
+      while (pool.size() + 1 < connections_per_node) {
+        const couchbase::core::origin origin(origin_.credentials(),
+                                             primary.bootstrap_hostname(),
+                                             primary.bootstrap_port_number(),
+                                             origin_.options());
+        io::mcbp_session session = origin_.options().enable_tls
+                                     ? io::mcbp_session(client_id_,
+                                                        primary.node_uuid(),
+                                                        ctx_,
+                                                        tls_,
+                                                        origin,
+                                                        state_listener_,
+                                                        name_,
+                                                        known_features_)
+                                     : io::mcbp_session(client_id_,
+                                                        primary.node_uuid(),
+                                                        ctx_,
+                                                        origin,
+                                                        state_listener_,
+                                                        name_,
+                                                        known_features_);
+        CB_LOG_DEBUG(R"({} add pooled session="{}", address="{}", primary="{}", pool_size={})",
+                     log_prefix_,
+                     session.id(),
+                     primary.bootstrap_address(),
+                     primary.id(),
+                     pool.size() + 1);
+        pool.emplace_back(session);
+        new_sessions.emplace_back(std::move(session));
+      }
+    }
+
+    // bootstrap outside of sessions_mutex_, as the handler takes it again
+    for (auto& session : new_sessions) {
+      session.bootstrap(
+        [self = shared_from_this(), session](std::error_code err,
+                                             topology::configuration /* cfg */) mutable {
+          if (err) {
+            CB_LOG_WARNING(R"({} failed to bootstrap pooled session="{}", address="{}", ec={})",
+                           session.log_prefix(),
+                           session.id(),
+                           session.bootstrap_address(),
+                           err.message());
+            return self->remove_session(session.id(), true);
+          }
+          {
+            const std::scoped_lock lock(self->sessions_mutex_);
+            if (auto entry = self->session_pool_refills_.find(session.bootstrap_address());
+                entry != self->session_pool_refills_.end()) {
+              entry->second.failures = 0;
+            }
+          }
+          session.on_configuration_update(self);
+          session.on_stop([id = session.id(), self]() {
+            self->remove_session(id);
+          });
+        },
+        true);
+    }
+  }
+
+  /**
+   * Replaces the pooled session, that has been removed, after exponential backoff. The refills stop
+   * after max_session_pool_failures bootstrap failures in a row, until the primary session of the
+   * node reconnects.
+   *
+   * Must be called with sessions_mutex_ held.
+   */
+  void schedule_session_pool_refill(const std::string& address, bool bootstrap_failed)
+  {
+    if (closed_) {
+      return;
+    }
+    auto& refill = session_pool_refills_[address];
+    if (bootstrap_failed && ++refill.failures >= max_session_pool_failures) {
+      CB_LOG_WARNING(
+        R"({} stop refilling session pool for address="{}" after {} failed bootstrap attempts)",
+        log_prefix_,
+        address,
+        refill.failures);
+      return;
+    }
+    if (refill.timer) {
+      // the refill has been already scheduled
+      return;
+    }
+    const auto backoff =
+      std::min(session_pool_refill_max_backoff,
+               session_pool_refill_min_backoff * (1U << std::min<std::size_t>(refill.failures, 10)));
+    refill.timer = std::make_shared<asio::steady_timer>(ctx_, backoff);
+    refill.timer->async_wait(
+      [self = shared_from_this(), timer = refill.timer, address](std::error_code ec) {
+        if (ec == asio::error::operation_aborted || self->closed_) {
+          return;
+        }
+        {
+          const std::scoped_lock lock(self->sessions_mutex_);
+          if (auto entry = self->session_pool_refills_.find(address);
+              entry != self->session_pool_refills_.end() && entry->second.timer == timer) {
+            entry->second.timer.reset();
+          }
+        }
+        if (auto primary = self->find_primary_session_by_address(address); primary) {
+          self->fill_session_pool(primary.value(), false);
+        }
+      });
+  }
+
   [[nodiscard]] auto find_or_connect_session_by_index(std::size_t index)
     -> std::optional<io::mcbp_session>
   {
@@ -1011,14 +1255,24 @@ public:
     return app_telemetry_meter_;
   }
 
+  /**
+   * Adds the section with the counters of the KV sessions to the periodic metrics report. The
+   * section is removed, when the bucket is closed.
+   */
+  void add_report_section()
+  {
+    meter_->add_report_section(
+      report_section_name(), [self = std::weak_ptr<bucket_impl>(shared_from_this())]() {
+        if (const auto bucket = self.lock(); bucket) {
+          return bucket->sessions_report();
+        }
+        return tao::json::value{ tao::json::null };
+      });
+  }
+
   void export_diag_info(diag::diagnostics_result& res) const
   {
-    std::map<size_t, io::mcbp_session> sessions;
-    {
-      const std::scoped_lock lock(sessions_mutex_);
-      sessions = sessions_;
-    }
-    for (const auto& [index, session] : sessions) {
+    for (const auto& session : all_sessions()) {
       res.services[service_type::key_value].emplace_back(session.diag_info());
     }
   }
@@ -1026,12 +1280,7 @@ public:
   void ping(const std::shared_ptr<diag::ping_collector>& collector,
             std::optional<std::chrono::milliseconds> timeout)
   {
-    std::map<size_t, io::mcbp_session> sessions;
-    {
-      const std::scoped_lock lock(sessions_mutex_);
-      sessions = sessions_;
-    }
-    for (const auto& [index, session] : sessions) {
+    for (const auto& session : all_sessions()) {
       session.ping(collector->build_reporter(), timeout);
     }
   }
@@ -1056,17 +1305,58 @@ public:
 
   void for_each_session(utils::movable_function<void(io::mcbp_session&)> handler)
   {
-    std::map<size_t, io::mcbp_session> sessions;
-    {
-      const std::scoped_lock lock(sessions_mutex_);
-      sessions = sessions_;
-    }
-    for (auto& [index, session] : sessions) {
+    for (auto& session : all_sessions()) {
       handler(session);
     }
   }
 
 private:
+  [[nodiscard]] auto report_section_name() const -> std::string
+  {
+    return fmt::format("kv_sessions/{}", name_);
+  }
+
+  [[nodiscard]] auto sessions_report() const -> tao::json::value
+  {
+    const auto sessions = all_sessions();
+    std::uint64_t number_of_writes{ 0 };
+    std::uint64_t number_of_messages{ 0 };
+    std::size_t max_batch_size{ 0 };
+    std::uint64_t number_of_parsed_configs{ 0 };
+    std::uint64_t number_of_skipped_configs{ 0 };
+    for (const auto& session : sessions) {
+      const auto stats = session.write_stats();
+      number_of_writes += stats.number_of_writes;
+      number_of_messages += stats.number_of_messages;
+      max_batch_size = std::max(max_batch_size, stats.max_batch_size);
+      const auto config_stats = session.config_stats();
+      number_of_parsed_configs += config_stats.number_of_parsed_configs;
+      number_of_skipped_configs += config_stats.number_of_skipped_configs;
+    }
+    return {
+      { "sessions", sessions.size() },
+      { "writes", number_of_writes },
+      { "messages_written", number_of_messages },
+      { "max_write_batch", max_batch_size },
+      { "nmvb_configs_parsed", number_of_parsed_configs },
+      { "nmvb_configs_skipped", number_of_skipped_configs },
+    };
+  }
+
+  [[nodiscard]] auto all_sessions() const -> std::vector<io::mcbp_session>
+  {
+    std::vector<io::mcbp_session> sessions;
+    const std::scoped_lock lock(sessions_mutex_);
+    sessions.reserve(sessions_.size() * origin_.options().kv_connections_per_node);
+    for (const auto& [index, session] : sessions_) {
+      sessions.emplace_back(session);
+    }
+    for (const auto& [address, pool] : session_pools_) {
+      sessions.insert(sessions.end(), pool.begin(), pool.end());
+    }
+    return sessions;
+  }
+
   const std::string client_id_;
   const std::string name_;
   const std::string log_prefix_;
@@ -1091,6 +1381,8 @@ private:
 
   std::shared_ptr<topology::configuration> config_{};
   mutable std::mutex config_mutex_{};
+  // published under config_mutex_, but read without it on the dispatch path
+  std::shared_ptr<const topology::vbucket_routing_table> routing_table_{};
 
   std::vector<std::shared_ptr<config_listener>> config_listeners_{};
   std::mutex config_listeners_mutex_{};
@@ -1099,6 +1391,14 @@ private:
   std::mutex deferred_commands_mutex_{};
 
   std::map<size_t, io::mcbp_session> sessions_{};
+  // additional connections to the same node, keyed by bootstrap address of the primary session
+  std::map<std::string, std::vector<io::mcbp_session>> session_pools_{};
+  struct session_pool_refill {
+    // bootstrap failures of the pooled sessions in a row
+    std::size_t failures{ 0 };
+    std::shared_ptr<asio::steady_timer> timer{};
+  };
+  std::map<std::string, session_pool_refill> session_pool_refills_{};
   mutable std::mutex sessions_mutex_{};
   std::atomic_size_t round_robin_next_{ 0 };
 };
@@ -1127,12 +1427,15 @@ bucket::bucket(std::string client_id,
                                          std::move(state_listener),
                                          ctx,
                                          tls) }
+  , deadline_wheel_{ std::make_shared<io::deadline_wheel>(ctx) }
 {
+  impl_->add_report_section();
 }
 
 bucket::~bucket()
 {
   impl_->close();
+  deadline_wheel_->stop();
 }
 
 void
@@ -1175,7 +1478,9 @@ bucket::name() const -> const std::string&
 void
 bucket::close()
 {
-  return impl_->close();
+  impl_->close();
+  // the commands pending in the wheel refer back to it through their deadlines
+  deadline_wheel_->stop();
 }
 
 auto
@@ -1214,6 +1519,12 @@ bucket::default_retry_strategy() const -> std::shared_ptr<couchbase::retry_strat
   return impl_->default_retry_strategy();
 }
 
+auto
+bucket::deadline_wheel() const -> std::shared_ptr<io::deadline_wheel>
+{
+  return deadline_wheel_;
+}
+
 void
 bucket::on_configuration_update(std::shared_ptr<config_listener> handler)
 {
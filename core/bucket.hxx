@@ -21,6 +21,7 @@
 #include "io/mcbp_command.hxx"
 #include "operations.hxx"
 #include "tls_context_provider.hxx"
+#include "utils/pool_allocator.hxx"
 
 #include <asio/bind_executor.hpp>
 #include <asio/dispatch.hpp>
@@ -86,8 +87,9 @@ public:
     if (is_closed()) {
       return;
     }
-    auto cmd = std::make_shared<operations::mcbp_command<bucket, Request>>(
-      ctx_, shared_from_this(), request, default_timeout());
+    using command_type = operations::mcbp_command<bucket, Request>;
+    auto cmd = std::allocate_shared<command_type>(
+      utils::pool_allocator<command_type>{}, ctx_, shared_from_this(), request, default_timeout());
     cmd->start([cmd, handler = std::forward<Handler>(handler)](
                  std::error_code ec, std::optional<io::mcbp_message>&& msg) mutable {
       using encoded_response_type = typename Request::encoded_response_type;
@@ -234,6 +236,7 @@ public:
   [[nodiscard]] auto orphan_reporter() const -> std::shared_ptr<orphan_reporter>;
   [[nodiscard]] auto app_telemetry_meter() const -> std::shared_ptr<app_telemetry_meter>;
   [[nodiscard]] auto default_retry_strategy() const -> std::shared_ptr<couchbase::retry_strategy>;
+  [[nodiscard]] auto deadline_wheel() const -> std::shared_ptr<io::deadline_wheel>;
   [[nodiscard]] auto is_closed() const -> bool;
   [[nodiscard]] auto is_configured() const -> bool;
 
@@ -252,5 +255,6 @@ private:
 
   asio::io_context& ctx_;
   std::shared_ptr<bucket_impl> impl_;
+  std::shared_ptr<io::deadline_wheel> deadline_wheel_;
 };
 } // namespace couchbase::core
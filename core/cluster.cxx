@@ -150,6 +150,7 @@
 #include "core/orphan_reporter.hxx"
 #include "core/platform/uuid.h"
 #include "core/protocol/hello_feature.hxx"
+#include "core/sasl/scram-sha/salted_password_cache.h"
 #include "core/service_type.hxx"
 #include "core/tls_verify_mode.hxx"
 #include "core/topology/capabilities.hxx"
@@ -175,6 +176,8 @@
 #include <asio/post.hpp>
 #include <asio/ssl/verify_mode.hpp>
 
+#include <tao/json/value.hpp>
+
 #include <algorithm>
 #include <atomic>
 #include <chrono>
@@ -650,6 +653,11 @@ public:
     }
 
     origin_.update_credentials(auth);
+    // the salted passwords derived from the old password must not outlive it
+    sasl::mechanism::scram::salted_password_cache::instance().invalidate(
+      old_credentials.username);
+    // new connections must not resume the TLS sessions established with the old identity
+    tls_.session_cache()->clear();
 
     // Separately update bucket and mcbp sessions as they have their own copies of the origin
     for_each_bucket([&auth](const std::shared_ptr<bucket>& bucket) {
@@ -1265,6 +1273,13 @@ public:
         if (self->orphan_reporter_) {
           self->orphan_reporter_->stop();
         }
+        if (self->origin_.options().enable_tls) {
+          const auto tls_stats = self->tls_.session_cache()->stats();
+          CB_LOG_DEBUG("[{}]: TLS handshakes: full={}, resumed={}",
+                       self->id_,
+                       tls_stats.full_handshakes,
+                       tls_stats.resumed_handshakes);
+        }
         handler();
       }));
   }
@@ -1377,6 +1392,21 @@ private:
 
     session_manager_->set_tracer(tracer_);
     session_manager_->set_meter(meter_);
+    meter_->add_report_section(
+      "query_cache",
+      [session_manager = std::weak_ptr<io::http_session_manager>(session_manager_)]() {
+        const auto manager = session_manager.lock();
+        if (!manager) {
+          return tao::json::value{ tao::json::null };
+        }
+        const auto stats = manager->query_cache_stats();
+        return tao::json::value{
+          { "hits", stats.hits },
+          { "misses", stats.misses },
+          { "evictions", stats.evictions },
+          { "size", stats.size },
+        };
+      });
 
     app_telemetry_meter_->update_agent(origin_.options().user_agent_extra);
     session_manager_->set_app_telemetry_meter(app_telemetry_meter_);
@@ -17,6 +17,7 @@
 
 #include "cluster_label_listener.hxx"
 
+#include <atomic>
 #include <mutex>
 #include <shared_mutex>
 
@@ -30,12 +31,23 @@ public:
   void update_config(topology::configuration config)
   {
     const std::scoped_lock lock(mutex_);
+    bool changed = false;
     if (config.cluster_name.has_value() && (cluster_name_ != config.cluster_name)) {
       cluster_name_ = std::move(config.cluster_name);
+      changed = true;
     }
     if (config.cluster_uuid.has_value() && (cluster_uuid_ != config.cluster_uuid)) {
       cluster_uuid_ = std::move(config.cluster_uuid);
+      changed = true;
     }
+    if (changed) {
+      ++version_;
+    }
+  }
+
+  auto labels_version() const -> std::uint64_t
+  {
+    return version_.load();
   }
 
   auto cluster_labels() -> cluster_label_listener::labels
@@ -51,6 +63,7 @@ private:
   std::shared_mutex mutex_{};
   std::optional<std::string> cluster_name_{};
   std::optional<std::string> cluster_uuid_{};
+  std::atomic<std::uint64_t> version_{ 0 };
 };
 
 cluster_label_listener::cluster_label_listener()
@@ -69,4 +82,10 @@ cluster_label_listener::cluster_labels() const -> labels
 {
   return impl_->cluster_labels();
 }
+
+auto
+cluster_label_listener::labels_version() const -> std::uint64_t
+{
+  return impl_->labels_version();
+}
 } // namespace couchbase::core
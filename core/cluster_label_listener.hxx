@@ -19,6 +19,7 @@
 
 #include "config_listener.hxx"
 
+#include <cstdint>
 #include <memory>
 #include <optional>
 #include <string>
@@ -40,6 +41,11 @@ public:
 
   [[nodiscard]] auto cluster_labels() const -> labels;
 
+  /**
+   * Incremented every time the labels change, allows to cache values derived from the labels.
+   */
+  [[nodiscard]] auto labels_version() const -> std::uint64_t;
+
 private:
   std::shared_ptr<cluster_label_listener_impl> impl_;
 };
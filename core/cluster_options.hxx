@@ -18,8 +18,10 @@
 #pragma once
 
 #include "core/columnar/security_options.hxx"
+#include "core/compression_policy.hxx"
 #include "core/io/dns_config.hxx"
 #include "core/io/ip_protocol.hxx"
+#include "core/io/query_cache.hxx"
 #include "core/metrics/logging_meter_options.hxx"
 #include "core/orphan_reporter.hxx"
 #include "core/tracing/threshold_logging_options.hxx"
@@ -71,6 +73,7 @@ public:
   bool enable_unordered_execution{ true };
   bool enable_clustermap_notification{ true };
   bool enable_compression{ true };
+  compression_policy_options compression_policy{};
   bool enable_tracing{ true };
   bool enable_metrics{ true };
   bool enable_orphan_reporting{ true };
@@ -92,6 +95,7 @@ public:
   std::size_t max_http_connections{ 0 };
   std::chrono::milliseconds idle_http_connection_timeout =
     timeout_defaults::idle_http_connection_timeout;
+  std::size_t streaming_row_buffer_size{ 100 };
   std::string user_agent_extra{};
   std::string server_group{};
   couchbase::transactions::transactions_config::built transactions{};
@@ -114,6 +118,8 @@ public:
   bool preserve_bootstrap_nodes_order{ false };
   bool allow_enterprise_analytics{ false };
   bool enable_lazy_connections{ false };
+  std::size_t kv_connections_per_node{ 1 };
+  std::size_t prepared_statement_cache_capacity{ query_cache::default_capacity };
 };
 
 } // namespace couchbase::core
@@ -0,0 +1,138 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2025 Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "compression_policy.hxx"
+
+#include "core/document_id.hxx"
+#include "core/protocol/client_request.hxx"
+
+#include <algorithm>
+#include <string_view>
+#include <utility>
+
+namespace couchbase::core
+{
+compression_policy::compression_policy(compression_policy_options options)
+  : options_{ std::move(options) }
+{
+  for (const auto& keyspace : options_.disabled_collections) {
+    // bucket names might contain dots, while scope and collection names cannot
+    const auto collection_dot = keyspace.rfind('.');
+    if (collection_dot == std::string::npos || collection_dot == 0) {
+      continue;
+    }
+    const auto scope_dot = keyspace.rfind('.', collection_dot - 1);
+    if (scope_dot == std::string::npos) {
+      continue;
+    }
+    disabled_keyspaces_.emplace(keyspace.substr(0, scope_dot),
+                                keyspace.substr(scope_dot + 1, collection_dot - scope_dot - 1),
+                                keyspace.substr(collection_dot + 1));
+  }
+}
+
+auto
+compression_policy::enabled_for(const document_id& id) const -> bool
+{
+  if (disabled_keyspaces_.empty()) {
+    return true;
+  }
+  const std::tuple<std::string_view, std::string_view, std::string_view> keyspace{
+    id.bucket(), id.scope(), id.collection()
+  };
+  return disabled_keyspaces_.count(keyspace) == 0;
+}
+
+auto
+compression_policy::compress(gsl::span<const std::byte> value, std::vector<std::byte>& output)
+  -> bool
+{
+  if (value.size() < std::max<std::size_t>(options_.min_size, 1)) {
+    return false;
+  }
+  if (options_.adaptive && should_skip()) {
+    number_of_skipped_values_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  const auto size_before = output.size();
+  const bool compressed = protocol::compress_value(value, output, options_.min_ratio);
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+
+  number_of_attempts_.fetch_add(1, std::memory_order_relaxed);
+  bytes_before_compression_.fetch_add(value.size(), std::memory_order_relaxed);
+  time_spent_ns_.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(),
+                           std::memory_order_relaxed);
+  if (compressed) {
+    number_of_compressed_values_.fetch_add(1, std::memory_order_relaxed);
+    bytes_saved_.fetch_add(value.size() - (output.size() - size_before),
+                           std::memory_order_relaxed);
+  }
+  if (options_.adaptive) {
+    record_result(compressed);
+  }
+  return compressed;
+}
+
+auto
+compression_policy::should_skip() -> bool
+{
+  auto remaining = values_to_skip_.load(std::memory_order_relaxed);
+  while (remaining > 0) {
+    if (values_to_skip_.compare_exchange_weak(
+          remaining, remaining - 1, std::memory_order_relaxed)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void
+compression_policy::record_result(bool compressed)
+{
+  if (compressed) {
+    poor_ratio_streak_.store(0, std::memory_order_relaxed);
+    back_off_level_.store(0, std::memory_order_relaxed);
+    return;
+  }
+  if (poor_ratio_streak_.fetch_add(1, std::memory_order_relaxed) + 1 <
+      poor_ratio_streak_to_back_off) {
+    return;
+  }
+  poor_ratio_streak_.store(0, std::memory_order_relaxed);
+  const auto level = back_off_level_.load(std::memory_order_relaxed);
+  values_to_skip_.store(static_cast<std::int64_t>(initial_back_off) << level,
+                        std::memory_order_relaxed);
+  if (level < max_back_off_level) {
+    back_off_level_.store(level + 1, std::memory_order_relaxed);
+  }
+}
+
+auto
+compression_policy::stats() const -> compression_stats
+{
+  return {
+    number_of_attempts_.load(std::memory_order_relaxed),
+    number_of_compressed_values_.load(std::memory_order_relaxed),
+    number_of_skipped_values_.load(std::memory_order_relaxed),
+    bytes_before_compression_.load(std::memory_order_relaxed),
+    bytes_saved_.load(std::memory_order_relaxed),
+    std::chrono::nanoseconds{ time_spent_ns_.load(std::memory_order_relaxed) },
+  };
+}
+} // namespace couchbase::core
@@ -0,0 +1,116 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2025 Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include <gsl/span>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace couchbase::core
+{
+struct document_id;
+
+struct compression_policy_options {
+  /**
+   * Values smaller than this are sent as is.
+   */
+  std::size_t min_size{ 32 };
+  /**
+   * The compressed form is used only if compressed_size / original_size is below this ratio.
+   */
+  double min_ratio{ 0.83 };
+  /**
+   * Stop trying to compress for a while, when the values of the connection repeatedly do not
+   * compress well (e.g. images or already compressed blobs).
+   */
+  bool adaptive{ true };
+  /**
+   * Keyspaces in the form "bucket.scope.collection", that should never be compressed.
+   */
+  std::set<std::string> disabled_collections{};
+};
+
+struct compression_stats {
+  std::uint64_t number_of_attempts{ 0 };
+  std::uint64_t number_of_compressed_values{ 0 };
+  std::uint64_t number_of_skipped_values{ 0 };
+  std::uint64_t bytes_before_compression{ 0 };
+  std::uint64_t bytes_saved{ 0 };
+  std::chrono::nanoseconds time_spent{ 0 };
+};
+
+/**
+ * Decides whether the outgoing value should be compressed, and compresses it.
+ *
+ * In adaptive mode, a series of values with a poor compression ratio makes the policy skip the
+ * following values without trying to compress them. Every series makes the back off twice as
+ * long (up to a limit), and a single value with a good ratio resets it.
+ *
+ * The policy is shared by all threads writing to the connection, so its state is kept in relaxed
+ * atomics, that are good enough for the heuristic.
+ */
+class compression_policy
+{
+public:
+  static constexpr std::uint32_t poor_ratio_streak_to_back_off{ 8 };
+  static constexpr std::uint32_t initial_back_off{ 16 };
+  static constexpr std::uint32_t max_back_off_level{ 10 };
+
+  explicit compression_policy(compression_policy_options options);
+
+  [[nodiscard]] auto enabled_for(const document_id& id) const -> bool;
+
+  /**
+   * Appends the compressed value to the output, if the policy allows it and the compression ratio
+   * is good enough.
+   *
+   * @return true if the compressed value has been appended, otherwise the output is left unchanged
+   */
+  auto compress(gsl::span<const std::byte> value, std::vector<std::byte>& output) -> bool;
+
+  [[nodiscard]] auto stats() const -> compression_stats;
+
+private:
+  [[nodiscard]] auto should_skip() -> bool;
+  void record_result(bool compressed);
+
+  compression_policy_options options_;
+  /// disabled_collections split into bucket, scope and collection, so that the lookup does not
+  /// have to format the keyspace of every document
+  std::set<std::tuple<std::string, std::string, std::string>, std::less<>> disabled_keyspaces_{};
+
+  std::atomic<std::uint32_t> poor_ratio_streak_{ 0 };
+  std::atomic<std::uint32_t> back_off_level_{ 0 };
+  std::atomic<std::int64_t> values_to_skip_{ 0 };
+
+  std::atomic<std::uint64_t> number_of_attempts_{ 0 };
+  std::atomic<std::uint64_t> number_of_compressed_values_{ 0 };
+  std::atomic<std::uint64_t> number_of_skipped_values_{ 0 };
+  std::atomic<std::uint64_t> bytes_before_compression_{ 0 };
+  std::atomic<std::uint64_t> bytes_saved_{ 0 };
+  std::atomic<std::int64_t> time_spent_ns_{ 0 };
+};
+} // namespace couchbase::core
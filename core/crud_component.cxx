@@ -201,16 +201,22 @@ parse_range_scan_documents(gsl::span<std::byte> data,
       if (remaining.size() < value_length) {
         return errc::network::protocol_error;
       }
-      body.value = { remaining.begin(),
-                     remaining.begin() + static_cast<std::ptrdiff_t>(value_length) };
-      if (protocol::has_flag(body.datatype, protocol::datatype::snappy)) {
-        std::string uncompressed;
-        if (snappy::Uncompress(
-              reinterpret_cast<const char*>(body.value.data()), body.value.size(), &uncompressed)) {
-          body.value = core::utils::to_binary(uncompressed);
+      const auto* value = reinterpret_cast<const char*>(remaining.data());
+      std::size_t uncompressed_size{ 0 };
+      bool use_raw_value = true;
+      if (protocol::has_flag(body.datatype, protocol::datatype::snappy) &&
+          snappy::GetUncompressedLength(value, value_length, &uncompressed_size)) {
+        // decompress directly into the item, without the temporary string
+        body.value.resize(uncompressed_size);
+        if (snappy::RawUncompress(value, value_length, reinterpret_cast<char*>(body.value.data()))) {
           protocol::clear_flag(body.datatype, protocol::datatype::snappy);
+          use_raw_value = false;
         }
       }
+      if (use_raw_value) {
+        body.value = { remaining.begin(),
+                       remaining.begin() + static_cast<std::ptrdiff_t>(value_length) };
+      }
       data = gsl::make_span(remaining.data() + value_length, remaining.size() - value_length);
     }
 
@@ -20,8 +20,6 @@
 #include "core/utils/binary.hxx"
 #include "core/utils/unsigned_leb128.hxx"
 
-#include <spdlog/fmt/bundled/core.h>
-
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
@@ -69,15 +67,10 @@ is_valid_collection_element(std::string_view element) -> bool
   return std::all_of(element.begin(), element.end(), is_valid_collection_char);
 }
 
-[[nodiscard]] auto
-compile_collection_path(const std::string& scope, const std::string& collection) -> std::string
-{
-  return fmt::format("{}.{}", scope, collection);
-}
 } // namespace
 
 document_id::document_id(std::string bucket, std::string key)
-  : bucket_(std::move(bucket))
+  : keyspace_(std::make_shared<const core::keyspace>(std::move(bucket)))
   , key_(std::move(key))
   , use_collections_(false)
 {
@@ -87,18 +80,28 @@ document_id::document_id(std::string bucket,
                          std::string scope,
                          std::string collection,
                          std::string key)
-  : bucket_(std::move(bucket))
-  , scope_(std::move(scope))
-  , collection_(std::move(collection))
+  : keyspace_(make_keyspace(std::move(bucket), std::move(scope), std::move(collection)))
   , key_(std::move(key))
 {
-  collection_path_ = compile_collection_path(scope_, collection_);
+}
+
+document_id::document_id(std::shared_ptr<const core::keyspace> keyspace, std::string key)
+  : keyspace_(std::move(keyspace))
+  , key_(std::move(key))
+{
+}
+
+auto
+document_id::empty_keyspace() -> std::shared_ptr<const core::keyspace>
+{
+  static const auto empty = std::make_shared<const core::keyspace>();
+  return empty;
 }
 
 auto
 document_id::has_default_collection() const -> bool
 {
-  return !use_collections_ || collection_path_ == "_default._default";
+  return !use_collections_ || keyspace_->is_default_collection();
 }
 
 auto
@@ -107,7 +110,7 @@ make_protocol_key(const document_id& id) -> std::vector<std::byte>
   std::vector<std::byte> key{};
   if (id.is_collection_resolved()) {
     const utils::unsigned_leb128<std::uint32_t> encoded(id.collection_uid());
-    key.reserve(encoded.size());
+    key.reserve(encoded.size() + id.key().size());
     key.insert(key.end(), encoded.begin(), encoded.end());
   }
   key.reserve(key.size() + id.key().size());
@@ -17,7 +17,10 @@
 
 #pragma once
 
+#include "keyspace.hxx"
+
 #include <cstdint>
+#include <memory>
 #include <optional>
 #include <string>
 #include <vector>
@@ -28,25 +31,31 @@ struct document_id {
   document_id() = default;
   document_id(std::string bucket, std::string key);
   document_id(std::string bucket, std::string scope, std::string collection, std::string key);
+  document_id(std::shared_ptr<const core::keyspace> keyspace, std::string key);
 
   [[nodiscard]] const std::string& bucket() const
   {
-    return bucket_;
+    return keyspace_->bucket();
   }
 
   [[nodiscard]] const std::string& scope() const
   {
-    return scope_;
+    return keyspace_->scope();
   }
 
   [[nodiscard]] const std::string& collection() const
   {
-    return collection_;
+    return keyspace_->collection();
   }
 
   [[nodiscard]] const std::string& collection_path() const
   {
-    return collection_path_;
+    return keyspace_->path();
+  }
+
+  [[nodiscard]] const core::keyspace& keyspace() const
+  {
+    return *keyspace_;
   }
 
   [[nodiscard]] const std::string& key() const
@@ -102,11 +111,10 @@ struct document_id {
   }
 
 private:
-  std::string bucket_{};
-  std::string scope_{};
-  std::string collection_{};
+  [[nodiscard]] static auto empty_keyspace() -> std::shared_ptr<const core::keyspace>;
+
+  std::shared_ptr<const core::keyspace> keyspace_{ empty_keyspace() };
   std::string key_{};
-  std::string collection_path_{};
   std::optional<std::uint32_t>
     collection_uid_{}; // filled with resolved UID during request lifetime
   bool use_collections_{ true };
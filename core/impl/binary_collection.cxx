@@ -21,6 +21,7 @@
 #include "core/impl/error.hxx"
 #include "core/impl/invoke_with_node_id.hxx"
 #include "core/impl/observability_recorder.hxx"
+#include "core/keyspace.hxx"
 #include "core/operations/document_append.hxx"
 #include "core/operations/document_decrement.hxx"
 #include "core/operations/document_increment.hxx"
@@ -67,6 +68,7 @@ public:
     , bucket_name_{ bucket_name }
     , scope_name_{ scope_name }
     , name_{ name }
+    , keyspace_{ core::make_keyspace(bucket_name_, scope_name_, name_) }
   {
   }
 
@@ -93,12 +95,7 @@ public:
     auto obs_rec = create_observability_recorder(
       core::tracing::operation::mcbp_append, options.parent_span, options.durability_level);
 
-    auto id = core::document_id{
-      bucket_name_,
-      scope_name_,
-      name_,
-      std::move(document_key),
-    };
+    auto id = core::document_id{ keyspace_, std::move(document_key) };
     if (options.persist_to == persist_to::none && options.replicate_to == replicate_to::none) {
       core::operations::append_request request{
         std::move(id),
@@ -185,12 +182,7 @@ public:
     auto obs_rec = create_observability_recorder(
       core::tracing::operation::mcbp_prepend, options.parent_span, options.durability_level);
 
-    auto id = core::document_id{
-      bucket_name_,
-      scope_name_,
-      name_,
-      std::move(document_key),
-    };
+    auto id = core::document_id{ keyspace_, std::move(document_key) };
     if (options.persist_to == persist_to::none && options.replicate_to == replicate_to::none) {
       core::operations::prepend_request request{
         std::move(id),
@@ -276,12 +268,7 @@ public:
     auto obs_rec = create_observability_recorder(
       core::tracing::operation::mcbp_decrement, options.parent_span, options.durability_level);
 
-    auto id = core::document_id{
-      bucket_name_,
-      scope_name_,
-      name_,
-      std::move(document_key),
-    };
+    auto id = core::document_id{ keyspace_, std::move(document_key) };
     if (options.persist_to == persist_to::none && options.replicate_to == replicate_to::none) {
       core::operations::decrement_request request{
         std::move(id),
@@ -370,12 +357,7 @@ public:
     auto obs_rec = create_observability_recorder(
       core::tracing::operation::mcbp_increment, options.parent_span, options.durability_level);
 
-    auto id = core::document_id{
-      bucket_name_,
-      scope_name_,
-      name_,
-      std::move(document_key),
-    };
+    auto id = core::document_id{ keyspace_, std::move(document_key) };
     if (options.persist_to == persist_to::none && options.replicate_to == replicate_to::none) {
       core::operations::increment_request request{
         std::move(id),
@@ -480,6 +462,7 @@ private:
   std::string bucket_name_;
   std::string scope_name_;
   std::string name_;
+  std::shared_ptr<const core::keyspace> keyspace_;
 };
 
 binary_collection::binary_collection(core::cluster core,
@@ -31,6 +31,7 @@
 #include "core/agent_group_config.hxx"
 #include "core/cluster.hxx"
 #include "core/impl/subdoc/command.hxx"
+#include "core/keyspace.hxx"
 #include "core/logger/logger.hxx"
 #include "core/metrics/meter_wrapper.hxx"
 #include "core/operations/document_append.hxx"
@@ -103,14 +104,21 @@
 #include <asio/post.hpp>
 #include <asio/steady_timer.hpp>
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <cstdint>
+#include <functional>
 #include <future>
+#include <limits>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <string>
 #include <string_view>
 #include <system_error>
+#include <unordered_set>
 #include <utility>
 #include <variant>
 #include <vector>
@@ -121,6 +129,122 @@ namespace couchbase
 {
 using core::impl::invoke_with_node_id;
 
+namespace
+{
+/**
+ * Collects the outcomes of the operations of the batch, and invokes the handler once the last of
+ * them has completed.
+ */
+template<typename Result>
+class multi_result_collector
+{
+public:
+  using result_map = std::map<std::string, std::pair<error, Result>>;
+
+  multi_result_collector(std::size_t expected, std::function<void(result_map)> handler)
+    : remaining_{ expected }
+    , handler_{ std::move(handler) }
+  {
+  }
+
+  void add(std::string document_id, error err, Result result)
+  {
+    std::function<void(result_map)> handler{};
+    {
+      const std::scoped_lock lock(mutex_);
+      results_.insert_or_assign(std::move(document_id),
+                                std::make_pair(std::move(err), std::move(result)));
+      if (--remaining_ > 0) {
+        return;
+      }
+      std::swap(handler, handler_);
+    }
+    handler(std::move(results_));
+  }
+
+private:
+  std::mutex mutex_{};
+  std::size_t remaining_;
+  result_map results_{};
+  std::function<void(result_map)> handler_;
+};
+
+auto
+multi_item_id(const std::string& document_id) -> const std::string&
+{
+  return document_id;
+}
+
+auto
+multi_item_id(const std::pair<std::string, codec::encoded_value>& document) -> const std::string&
+{
+  return document.first;
+}
+
+/**
+ * The operations of the batch share one deadline, so each of them is started with the time that
+ * remains of it instead of the timeout of the batch.
+ */
+auto
+with_timeout(const get_options::built& options, std::chrono::milliseconds timeout)
+  -> get_options::built
+{
+  return { { timeout, options.retry_strategy, options.parent_span },
+           options.with_expiry,
+           options.projections };
+}
+
+auto
+with_timeout(const upsert_options::built& options, std::chrono::milliseconds timeout)
+  -> upsert_options::built
+{
+  return { { { timeout, options.retry_strategy, options.parent_span },
+             options.durability_level,
+             options.persist_to,
+             options.replicate_to },
+           options.expiry,
+           options.preserve_expiry };
+}
+
+auto
+with_timeout(const remove_options::built& options, std::chrono::milliseconds timeout)
+  -> remove_options::built
+{
+  return { { { timeout, options.retry_strategy, options.parent_span },
+             options.durability_level,
+             options.persist_to,
+             options.replicate_to },
+           options.cas };
+}
+
+/**
+ * The results of the batch are keyed by document ID, so only one operation is started for each ID.
+ * The last occurrence wins, which for upserts leaves the same content as applying the batch in
+ * order.
+ */
+template<typename Item>
+auto
+unique_multi_items(std::vector<Item> items) -> std::vector<Item>
+{
+  std::unordered_set<std::string_view> seen{};
+  std::vector<std::size_t> kept{};
+  for (std::size_t i = items.size(); i > 0; --i) {
+    if (seen.insert(multi_item_id(items[i - 1])).second) {
+      kept.push_back(i - 1);
+    }
+  }
+  if (kept.size() == items.size()) {
+    return items;
+  }
+  std::vector<Item> unique{};
+  unique.reserve(kept.size());
+  for (auto it = kept.rbegin(); it != kept.rend(); ++it) {
+    unique.emplace_back(std::move(items[*it]));
+  }
+  return unique;
+}
+} // namespace
+
 class collection_impl : public std::enable_shared_from_this<collection_impl>
 {
 public:
@@ -133,6 +257,7 @@ public:
     , bucket_name_{ bucket_name }
     , scope_name_{ scope_name }
     , name_{ name }
+    , keyspace_{ core::make_keyspace(bucket_name_, scope_name_, name_) }
     , crypto_manager_{ std::move(crypto_manager) }
   {
   }
@@ -169,12 +294,7 @@ public:
 
     if (!options.with_expiry && options.projections.empty()) {
       core::operations::get_request request{
-        core::document_id{
-          bucket_name_,
-          scope_name_,
-          name_,
-          std::move(document_key),
-        },
+        core::document_id{ keyspace_, std::move(document_key) },
         {},
         {},
         options.timeout,
@@ -195,12 +315,7 @@ public:
                            });
     }
     core::operations::get_projected_request request{
-      core::document_id{
-        bucket_name_,
-        scope_name_,
-        name_,
-        std::move(document_key),
-      },
+      core::document_id{ keyspace_, std::move(document_key) },
       {},
       {},
       options.projections,
@@ -238,12 +353,7 @@ public:
                                                  options.parent_span);
 
     core::operations::get_and_touch_request request{
-      core::document_id{
-        bucket_name_,
-        scope_name_,
-        name_,
-        std::move(document_key),
-      },
+      core::document_id{ keyspace_, std::move(document_key) },
       {},
       {},
       expiry,
@@ -275,12 +385,7 @@ public:
       create_observability_recorder(core::tracing::operation::mcbp_touch, options.parent_span);
 
     core::operations::touch_request request{
-      core::document_id{
-        bucket_name_,
-        scope_name_,
-        name_,
-        std::move(document_key),
-      },
+      core::document_id{ keyspace_, std::move(document_key) },
       {},
       {},
       expiry,
@@ -305,12 +410,7 @@ public:
                                                  options.parent_span);
 
     core::operations::get_any_replica_request request{
-      core::document_id{
-        bucket_name_,
-        scope_name_,
-        name_,
-        std::move(document_key),
-      },
+      core::document_id{ keyspace_, std::move(document_key) },
       options.timeout,
       options.read_preference,
       obs_rec->operation_span(),
@@ -339,12 +439,7 @@ public:
                                                  options.parent_span);
 
     core::operations::get_all_replicas_request request{
-      core::document_id{
-        bucket_name_,
-        scope_name_,
-        name_,
-        std::move(document_key),
-      },
+      core::document_id{ keyspace_, std::move(document_key) },
       options.timeout,
       options.read_preference,
       obs_rec->operation_span(),
@@ -377,12 +472,7 @@ public:
     auto obs_rec =
       create_observability_recorder(core::tracing::operation::mcbp_remove, options.parent_span);
 
-    auto id = core::document_id{
-      bucket_name_,
-      scope_name_,
-      name_,
-      std::move(document_key),
-    };
+    auto id = core::document_id{ keyspace_, std::move(document_key) };
     if (options.persist_to == persist_to::none && options.replicate_to == replicate_to::none) {
       core::operations::remove_request request{
         std::move(id),
@@ -466,12 +556,7 @@ public:
                                                  options.parent_span);
 
     core::operations::get_and_lock_request request{
-      core::document_id{
-        bucket_name_,
-        scope_name_,
-        name_,
-        std::move(document_key),
-      },
+      core::document_id{ keyspace_, std::move(document_key) },
       {},
       {},
       static_cast<uint32_t>(lock_duration.count()),
@@ -502,12 +587,7 @@ public:
       create_observability_recorder(core::tracing::operation::mcbp_unlock, options.parent_span);
 
     core::operations::unlock_request request{
-      core::document_id{
-        bucket_name_,
-        scope_name_,
-        name_,
-        std::move(document_key),
-      },
+      core::document_id{ keyspace_, std::move(document_key) },
       {},
       {},
       cas,
@@ -531,12 +611,7 @@ public:
       create_observability_recorder(core::tracing::operation::mcbp_exists, options.parent_span);
 
     core::operations::exists_request request{
-      core::document_id{
-        bucket_name_,
-        scope_name_,
-        name_,
-        std::move(document_key),
-      },
+      core::document_id{ keyspace_, std::move(document_key) },
       {},
       {},
       options.timeout,
@@ -562,12 +637,7 @@ public:
       create_observability_recorder(core::tracing::operation::mcbp_lookup_in, options.parent_span);
 
     core::operations::lookup_in_request request{
-      core::document_id{
-        bucket_name_,
-        scope_name_,
-        name_,
-        std::move(document_key),
-      },
+      core::document_id{ keyspace_, std::move(document_key) },
       {},
       {},
       options.access_deleted,
@@ -610,12 +680,7 @@ public:
       core::tracing::operation::mcbp_lookup_in_all_replicas, options.parent_span);
 
     core::operations::lookup_in_all_replicas_request request{
-      core::document_id{
-        bucket_name_,
-        scope_name_,
-        name_,
-        std::move(document_key),
-      },
+      core::document_id{ keyspace_, std::move(document_key) },
       specs,
       options.timeout,
       obs_rec->operation_span(),
@@ -660,12 +725,7 @@ public:
       core::tracing::operation::mcbp_lookup_in_any_replica, options.parent_span);
 
     core::operations::lookup_in_any_replica_request request{
-      core::document_id{
-        bucket_name_,
-        scope_name_,
-        name_,
-        std::move(document_key),
-      },
+      core::document_id{ keyspace_, std::move(document_key) },
       specs,
       options.timeout,
       obs_rec->operation_span(),
@@ -701,12 +761,7 @@ public:
     auto obs_rec = create_observability_recorder(
       core::tracing::operation::mcbp_mutate_in, options.parent_span, options.durability_level);
 
-    auto id = core::document_id{
-      bucket_name_,
-      scope_name_,
-      name_,
-      std::move(document_key),
-    };
+    auto id = core::document_id{ keyspace_, std::move(document_key) };
     if (options.persist_to == persist_to::none && options.replicate_to == replicate_to::none) {
       core::operations::mutate_in_request request{
         std::move(id),
@@ -827,12 +882,7 @@ public:
       core::tracing::operation::mcbp_upsert, options.parent_span, options.durability_level);
 
     auto [data, flags] = get_encoded_value(std::move(value), obs_rec);
-    auto id = core::document_id{
-      bucket_name_,
-      scope_name_,
-      name_,
-      std::move(document_key),
-    };
+    auto id = core::document_id{ keyspace_, std::move(document_key) };
     if (options.persist_to == persist_to::none && options.replicate_to == replicate_to::none) {
       core::operations::upsert_request request{
         std::move(id),
@@ -918,12 +968,7 @@ public:
       core::tracing::operation::mcbp_insert, options.parent_span, options.durability_level);
 
     auto [data, flags] = get_encoded_value(std::move(value), obs_rec);
-    auto id = core::document_id{
-      bucket_name_,
-      scope_name_,
-      name_,
-      std::move(document_key),
-    };
+    auto id = core::document_id{ keyspace_, std::move(document_key) };
     if (options.persist_to == persist_to::none && options.replicate_to == replicate_to::none) {
       core::operations::insert_request request{
         std::move(id),
@@ -1013,12 +1058,7 @@ public:
 
     auto [data, flags] = get_encoded_value(std::move(value), obs_rec);
 
-    auto id = core::document_id{
-      bucket_name_,
-      scope_name_,
-      name_,
-      std::move(document_key),
-    };
+    auto id = core::document_id{ keyspace_, std::move(document_key) };
     if (options.persist_to == persist_to::none && options.replicate_to == replicate_to::none) {
       core::operations::replace_request request{
         std::move(id),
@@ -1306,7 +1346,161 @@ public:
       });
   }
 
+  void get_multi(std::vector<std::string> document_keys,
+                 const get_options::built& options,
+                 get_multi_handler&& handler) const
+  {
+    dispatch_multi<get_result>(
+      std::move(document_keys),
+      options.timeout,
+      std::move(handler),
+      [self = shared_from_this(), options](
+        std::string document_key, std::chrono::milliseconds timeout, auto collector) {
+        auto id = document_key;
+        self->get(std::move(document_key),
+                  with_timeout(options, timeout),
+                  [id = std::move(id), collector = std::move(collector)](auto err, auto result) {
+                    collector->add(id, std::move(err), std::move(result));
+                  });
+      });
+  }
+
+  void upsert_multi(std::vector<std::pair<std::string, codec::encoded_value>> documents,
+                    const upsert_options::built& options,
+                    upsert_multi_handler&& handler) const
+  {
+    dispatch_multi<mutation_result>(
+      std::move(documents),
+      options.timeout,
+      std::move(handler),
+      [self = shared_from_this(), options](
+        auto document, std::chrono::milliseconds timeout, auto collector) {
+        auto id = document.first;
+        self->upsert(std::move(document.first),
+                     std::move(document.second),
+                     with_timeout(options, timeout),
+                     [id = std::move(id), collector = std::move(collector)](auto err, auto result) {
+                       collector->add(id, std::move(err), std::move(result));
+                     });
+      });
+  }
+
+  void remove_multi(std::vector<std::string> document_keys,
+                    const remove_options::built& options,
+                    remove_multi_handler&& handler) const
+  {
+    dispatch_multi<mutation_result>(
+      std::move(document_keys),
+      options.timeout,
+      std::move(handler),
+      [self = shared_from_this(), options](
+        std::string document_key, std::chrono::milliseconds timeout, auto collector) {
+        auto id = document_key;
+        self->remove(std::move(document_key),
+                     with_timeout(options, timeout),
+                     [id = std::move(id), collector = std::move(collector)](auto err, auto result) {
+                       collector->add(id, std::move(err), std::move(result));
+                     });
+      });
+  }
+
 private:
+  /**
+   * Starts the regular single-document operation for every distinct ID of the batch, and invokes
+   * the handler once all of them have completed.
+   *
+   * The batch has one deadline, that starts when the batch is submitted. It bounds the wait for
+   * the bucket configuration, and every operation is given the time that remains of it. Once the
+   * configuration is available, the IDs are ordered by the node, that owns their vBucket, and the
+   * operations are started from the IO thread in a single run, node after node, so the session of
+   * each node usually coalesces the requests of the batch into one socket write.
+   */
+  template<typename Result, typename Item, typename Handler, typename Operation>
+  void dispatch_multi(std::vector<Item> items,
+                      std::optional<std::chrono::milliseconds> timeout,
+                      Handler&& handler,
+                      Operation&& operation) const
+  {
+    using collector_type = multi_result_collector<Result>;
+    if (items.empty()) {
+      return handler(typename collector_type::result_map{});
+    }
+    items = unique_multi_items(std::move(items));
+    auto collector = std::make_shared<collector_type>(items.size(), std::forward<Handler>(handler));
+
+    auto [origin_ec, origin] = core_.origin();
+    if (origin_ec) {
+      for (const auto& item : items) {
+        collector->add(multi_item_id(item), error{ origin_ec }, Result{});
+      }
+      return;
+    }
+    const auto deadline =
+      std::chrono::steady_clock::now() + timeout.value_or(origin.options().key_value_timeout);
+
+    std::vector<std::string> ids{};
+    ids.reserve(items.size());
+    for (const auto& item : items) {
+      ids.emplace_back(multi_item_id(item));
+    }
+
+    core::impl::with_bucket_config_or_timeout<std::vector<std::size_t>>(
+      core_,
+      bucket_name_,
+      remaining_until(deadline),
+      [items = std::move(items),
+       collector,
+       deadline,
+       operation = std::forward<Operation>(operation)](error err,
+                                                       std::vector<std::size_t> order) mutable {
+        if (err) {
+          for (const auto& item : items) {
+            collector->add(multi_item_id(item), err, Result{});
+          }
+          return;
+        }
+        const auto item_timeout = remaining_until(deadline);
+        for (const auto index : order) {
+          operation(std::move(items[index]), item_timeout, collector);
+        }
+      },
+      [ids = std::move(ids)](const std::shared_ptr<core::topology::configuration>& config) {
+        return std::make_pair(std::error_code{}, order_by_node(*config, ids));
+      });
+  }
+
+  static auto remaining_until(std::chrono::steady_clock::time_point deadline)
+    -> std::chrono::milliseconds
+  {
+    return std::max(std::chrono::milliseconds{ 1 },
+                    std::chrono::duration_cast<std::chrono::milliseconds>(
+                      deadline - std::chrono::steady_clock::now()));
+  }
+
+  /**
+   * @return indexes of the IDs, ordered by the index of the active node for their vBucket. The IDs,
+   * that cannot be mapped (e.g. the configuration does not have vBucket map yet), go last.
+   */
+  static auto order_by_node(const core::topology::configuration& config,
+                            const std::vector<std::string>& ids) -> std::vector<std::size_t>
+  {
+    std::vector<std::pair<std::size_t, std::size_t>> nodes{};
+    nodes.reserve(ids.size());
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+      const auto node = config.map_key(ids[i], 0).second;
+      nodes.emplace_back(node.value_or(std::numeric_limits<std::size_t>::max()), i);
+    }
+    std::stable_sort(nodes.begin(), nodes.end(), [](const auto& lhs, const auto& rhs) {
+      return lhs.first < rhs.first;
+    });
+    std::vector<std::size_t> order{};
+    order.reserve(nodes.size());
+    for (const auto& [node, index] : nodes) {
+      order.push_back(index);
+    }
+    return order;
+  }
+
   static auto get_encoded_value(
     std::variant<codec::encoded_value, std::function<codec::encoded_value()>> value,
     const std::unique_ptr<core::impl::observability_recorder>& obs_rec) -> codec::encoded_value
@@ -1344,6 +1538,7 @@ private:
   std::string bucket_name_;
   std::string scope_name_;
   std::string name_;
+  std::shared_ptr<const core::keyspace> keyspace_;
   std::shared_ptr<crypto::manager> crypto_manager_;
 };
 
@@ -1614,6 +1809,66 @@ collection::remove(std::string document_id, const remove_options& options) const
   return future;
 }
 
+void
+collection::get_multi(std::vector<std::string> document_ids,
+                      const get_options& options,
+                      get_multi_handler&& handler) const
+{
+  return impl_->get_multi(std::move(document_ids), options.build(), std::move(handler));
+}
+
+auto
+collection::get_multi(std::vector<std::string> document_ids, const get_options& options) const
+  -> std::future<get_multi_result>
+{
+  auto barrier = std::make_shared<std::promise<get_multi_result>>();
+  auto future = barrier->get_future();
+  get_multi(std::move(document_ids), options, [barrier](auto results) {
+    barrier->set_value(std::move(results));
+  });
+  return future;
+}
+
+void
+collection::upsert_multi(std::vector<std::pair<std::string, codec::encoded_value>> documents,
+                         const upsert_options& options,
+                         upsert_multi_handler&& handler) const
+{
+  return impl_->upsert_multi(std::move(documents), options.build(), std::move(handler));
+}
+
+auto
+collection::upsert_multi(std::vector<std::pair<std::string, codec::encoded_value>> documents,
+                         const upsert_options& options) const -> std::future<upsert_multi_result>
+{
+  auto barrier = std::make_shared<std::promise<upsert_multi_result>>();
+  auto future = barrier->get_future();
+  upsert_multi(std::move(documents), options, [barrier](auto results) {
+    barrier->set_value(std::move(results));
+  });
+  return future;
+}
+
+void
+collection::remove_multi(std::vector<std::string> document_ids,
+                         const remove_options& options,
+                         remove_multi_handler&& handler) const
+{
+  return impl_->remove_multi(std::move(document_ids), options.build(), std::move(handler));
+}
+
+auto
+collection::remove_multi(std::vector<std::string> document_ids,
+                         const remove_options& options) const -> std::future<remove_multi_result>
+{
+  auto barrier = std::make_shared<std::promise<remove_multi_result>>();
+  auto future = barrier->get_future();
+  remove_multi(std::move(document_ids), options, [barrier](auto results) {
+    barrier->set_value(std::move(results));
+  });
+  return future;
+}
+
 void
 collection::mutate_in(std::string document_id,
                       const mutate_in_specs& specs,
@@ -18,6 +18,7 @@
 #include "core/cluster.hxx"
 
 #include "analytics.hxx"
+#include "analytics_row_stream.hxx"
 #include "core/agent_group.hxx"
 #include "core/agent_group_config.hxx"
 #include "core/cluster_options.hxx"
@@ -35,7 +36,9 @@
 #include "internal_search_result.hxx"
 #include "observability_recorder.hxx"
 #include "query.hxx"
+#include "query_row_stream.hxx"
 #include "search.hxx"
+#include "search_row_stream.hxx"
 
 #include <couchbase/analytics_index_manager.hxx>
 #include <couchbase/analytics_options.hxx>
@@ -65,6 +68,7 @@
 #include <asio/execution_context.hpp>
 #include <asio/post.hpp>
 
+#include <algorithm>
 #include <functional>
 #include <future>
 #include <memory>
@@ -72,6 +76,7 @@
 #include <string_view>
 #include <system_error>
 #include <utility>
+#include <vector>
 
 namespace couchbase
 {
@@ -144,6 +149,7 @@ options_to_origin(const std::string& connection_string, cluster_options::built o
   user_options.enable_unordered_execution = opts.behavior.enable_unordered_execution;
   user_options.user_agent_extra = opts.behavior.user_agent_extra;
   user_options.preserve_bootstrap_nodes_order = opts.behavior.preserve_bootstrap_nodes_order;
+  user_options.streaming_row_buffer_size = opts.behavior.streaming_row_buffer_size;
 
   user_options.server_group = opts.network.server_group;
   user_options.enable_tcp_keep_alive = opts.network.enable_tcp_keep_alive;
@@ -151,6 +157,7 @@ options_to_origin(const std::string& connection_string, cluster_options::built o
   user_options.config_poll_interval = opts.network.config_poll_interval;
   user_options.idle_http_connection_timeout = opts.network.idle_http_connection_timeout;
   user_options.enable_lazy_connections = opts.network.enable_lazy_connections;
+  user_options.kv_connections_per_node = opts.network.kv_connections_per_node;
   if (opts.network.max_http_connections) {
     user_options.max_http_connections = opts.network.max_http_connections.value();
   }
@@ -173,11 +180,17 @@ options_to_origin(const std::string& connection_string, cluster_options::built o
   user_options.server_group = opts.network.server_group;
 
   user_options.enable_compression = opts.compression.enabled;
+  user_options.compression_policy.min_size = opts.compression.min_size;
+  user_options.compression_policy.min_ratio = opts.compression.min_ratio;
+  user_options.compression_policy.adaptive = opts.compression.adaptive;
+  user_options.compression_policy.disabled_collections = opts.compression.disabled_collections;
 
   user_options.enable_metrics = opts.metrics.enabled;
   if (opts.metrics.enabled) {
     user_options.meter = opts.metrics.meter;
     user_options.metrics_options.emit_interval = opts.metrics.emit_interval;
+    user_options.metrics_options.percentiles = opts.metrics.percentiles;
+    user_options.metrics_options.number_of_shards = opts.metrics.number_of_shards;
   }
 
   user_options.enable_tracing = opts.tracing.enabled;
@@ -233,12 +246,14 @@ public:
     : connection_string_{ std::move(connection_string) }
     , options_{ options.build() }
   {
+    start_io_threads();
   }
 
   cluster_impl(std::string connection_string, cluster_options::built options)
     : connection_string_{ std::move(connection_string) }
     , options_{ std::move(options) }
   {
+    start_io_threads();
   }
 
   cluster_impl(const cluster_impl&) = delete;
@@ -339,6 +354,21 @@ public:
       });
   }
 
+  void query_stream(std::string statement,
+                    query_options::built options,
+                    query_stream_handler&& handler) const
+  {
+    auto obs_rec = create_observability_recorder(
+      core::tracing::operation::query, core::service_type::query, options.parent_span);
+    obs_rec->with_query_statement(statement, options);
+
+    auto request = core::impl::build_query_request(
+      std::move(statement), {}, std::move(options), obs_rec->operation_span());
+
+    return core::impl::initiate_query_stream(
+      core_, std::move(request), std::move(obs_rec), std::move(handler));
+  }
+
   void analytics_query(std::string statement,
                        analytics_options::built options,
                        analytics_handler&& handler) const
@@ -357,6 +387,21 @@ public:
       });
   }
 
+  void analytics_query_stream(std::string statement,
+                              analytics_options::built options,
+                              analytics_stream_handler&& handler) const
+  {
+    auto obs_rec = create_observability_recorder(
+      core::tracing::operation::analytics, core::service_type::analytics, options.parent_span);
+    obs_rec->with_query_statement(statement, options);
+
+    auto request = core::impl::build_analytics_request(
+      std::move(statement), std::move(options), {}, {}, obs_rec->operation_span());
+
+    return core::impl::initiate_analytics_stream(
+      core_, std::move(request), std::move(obs_rec), std::move(handler));
+  }
+
   void ping(const ping_options::built& options, ping_handler&& handler) const
   {
     auto obs_rec = create_observability_recorder(
@@ -403,6 +448,20 @@ public:
       });
   }
 
+  void search_stream(std::string index_name,
+                     couchbase::search_request request,
+                     const search_options::built& options,
+                     search_stream_handler&& handler) const
+  {
+    auto obs_rec = create_observability_recorder(
+      core::tracing::operation::search, core::service_type::search, options.parent_span);
+
+    auto core_req = core::impl::build_search_request(
+      std::move(index_name), std::move(request), options, {}, {}, obs_rec->operation_span());
+    return core::impl::initiate_search_stream(
+      core_, std::move(core_req), std::move(obs_rec), std::move(handler));
+  }
+
   auto set_authenticator(const core::cluster_credentials& auth) const -> error
   {
     auto e = core_.update_credentials(auth);
@@ -415,14 +474,11 @@ public:
   void notify_fork(fork_event event)
   {
     if (event == fork_event::prepare) {
-      io_.stop();
-      io_thread_.join();
+      stop_io_threads();
     } else {
       // TODO(SA): close all sockets in fork_event::child
       io_.restart();
-      io_thread_ = std::thread{ [&io = io_] {
-        io.run();
-      } };
+      start_io_threads();
     }
     io_.notify_fork(fork_event_to_asio(event));
 
@@ -463,10 +519,29 @@ private:
       core_stopped.set_value();
     });
     f.get();
+    stop_io_threads();
+  }
+
+  void start_io_threads()
+  {
+    const auto number_of_threads = std::max<std::size_t>(1, options_.network.num_io_threads);
+    io_threads_.reserve(number_of_threads);
+    for (std::size_t i = 0; i < number_of_threads; ++i) {
+      io_threads_.emplace_back([&io = io_] {
+        io.run();
+      });
+    }
+  }
+
+  void stop_io_threads()
+  {
     io_.stop();
-    if (io_thread_.joinable()) {
-      io_thread_.join();
+    for (auto& thread : io_threads_) {
+      if (thread.joinable()) {
+        thread.join();
+      }
     }
+    io_threads_.clear();
   }
 
   [[nodiscard]] auto create_observability_recorder(
@@ -488,9 +563,7 @@ private:
   asio::io_context io_{ ASIO_CONCURRENCY_HINT_SAFE };
   core::cluster core_{ io_ };
   std::shared_ptr<couchbase::core::transactions::transactions> transactions_{ nullptr };
-  std::thread io_thread_{ [&io = io_] {
-    io.run();
-  } };
+  std::vector<std::thread> io_threads_{};
 };
 
 /*
@@ -526,6 +599,26 @@ cluster::query(std::string statement, const query_options& options) const
   return future;
 }
 
+void
+cluster::query_stream(std::string statement,
+                      const query_options& options,
+                      query_stream_handler&& handler) const
+{
+  return impl_->query_stream(std::move(statement), options.build(), std::move(handler));
+}
+
+auto
+cluster::query_stream(std::string statement, const query_options& options) const
+  -> std::future<std::pair<error, query_row_stream>>
+{
+  auto barrier = std::make_shared<std::promise<std::pair<error, query_row_stream>>>();
+  auto future = barrier->get_future();
+  query_stream(std::move(statement), options, [barrier](auto err, auto stream) {
+    barrier->set_value({ std::move(err), std::move(stream) });
+  });
+  return future;
+}
+
 void
 cluster::analytics_query(std::string statement,
                          const analytics_options& options,
@@ -546,6 +639,26 @@ cluster::analytics_query(std::string statement, const analytics_options& options
   return future;
 }
 
+void
+cluster::analytics_query_stream(std::string statement,
+                                const analytics_options& options,
+                                analytics_stream_handler&& handler) const
+{
+  impl_->analytics_query_stream(std::move(statement), options.build(), std::move(handler));
+}
+
+auto
+cluster::analytics_query_stream(std::string statement, const analytics_options& options) const
+  -> std::future<std::pair<error, analytics_row_stream>>
+{
+  auto barrier = std::make_shared<std::promise<std::pair<error, analytics_row_stream>>>();
+  auto future = barrier->get_future();
+  analytics_query_stream(std::move(statement), options, [barrier](auto err, auto stream) {
+    barrier->set_value({ std::move(err), std::move(stream) });
+  });
+  return future;
+}
+
 void
 cluster::ping(const couchbase::ping_options& options, couchbase::ping_handler&& handler) const
 {
@@ -603,6 +716,31 @@ cluster::search(std::string index_name, search_request request, const search_opt
   return barrier->get_future();
 }
 
+void
+cluster::search_stream(std::string index_name,
+                       search_request request,
+                       const search_options& options,
+                       search_stream_handler&& handler) const
+{
+  return impl_->search_stream(
+    std::move(index_name), std::move(request), options.build(), std::move(handler));
+}
+
+auto
+cluster::search_stream(std::string index_name,
+                       search_request request,
+                       const search_options& options) const
+  -> std::future<std::pair<error, search_row_stream>>
+{
+  auto barrier = std::make_shared<std::promise<std::pair<error, search_row_stream>>>();
+  auto future = barrier->get_future();
+  search_stream(
+    std::move(index_name), std::move(request), options, [barrier](auto err, auto stream) {
+      barrier->set_value({ std::move(err), std::move(stream) });
+    });
+  return future;
+}
+
 auto
 cluster::connect(const std::string& connection_string, const cluster_options& options)
   -> std::future<std::pair<error, cluster>>
@@ -0,0 +1,111 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2025. Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "query_row_stream.hxx"
+
+#include <couchbase/error_codes.hxx>
+
+#include "core/utils/binary.hxx"
+#include "query.hxx"
+#include "row_stream_impl.hxx"
+
+#include <future>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+
+namespace couchbase
+{
+struct query_row_stream_traits {
+  using request_type = core::operations::query_request;
+  using row_type = codec::binary;
+  using result_type = query_meta_data;
+
+  static auto decode_row(std::string&& row) -> row_type
+  {
+    return core::utils::to_binary(row);
+  }
+
+  static auto build_result(core::operations::query_response& resp) -> result_type
+  {
+    return core::impl::build_result(resp).meta_data();
+  }
+};
+
+class query_row_stream_impl : public core::impl::row_stream_impl<query_row_stream_traits>
+{
+public:
+  using row_stream_impl::row_stream_impl;
+};
+
+query_row_stream::query_row_stream(std::shared_ptr<query_row_stream_impl> impl)
+  : impl_{ std::move(impl) }
+{
+}
+
+void
+query_row_stream::next_row(query_row_handler&& handler) const
+{
+  if (!impl_) {
+    return handler(error{ errc::common::request_canceled }, {});
+  }
+  impl_->next_row(std::move(handler));
+}
+
+auto
+query_row_stream::next_row() const -> std::future<std::pair<error, std::optional<codec::binary>>>
+{
+  auto barrier =
+    std::make_shared<std::promise<std::pair<error, std::optional<codec::binary>>>>();
+  auto future = barrier->get_future();
+  next_row([barrier](auto err, auto row) {
+    barrier->set_value({ std::move(err), std::move(row) });
+  });
+  return future;
+}
+
+auto
+query_row_stream::meta_data() const -> std::optional<query_meta_data>
+{
+  if (!impl_) {
+    return {};
+  }
+  return impl_->result();
+}
+
+void
+query_row_stream::cancel() const
+{
+  if (impl_) {
+    impl_->cancel();
+  }
+}
+} // namespace couchbase
+
+namespace couchbase::core::impl
+{
+void
+initiate_query_stream(const core::cluster& core,
+                      operations::query_request request,
+                      std::unique_ptr<observability_recorder> obs_rec,
+                      query_stream_handler&& handler)
+{
+  return initiate_row_stream<query_row_stream, query_row_stream_impl>(
+    core, std::move(request), "/results/^", std::move(obs_rec), std::move(handler));
+}
+} // namespace couchbase::core::impl
@@ -0,0 +1,44 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2025. Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include <couchbase/query_row_stream.hxx>
+
+#include "core/operations/document_query.hxx"
+
+#include <memory>
+
+namespace couchbase::core
+{
+class cluster;
+} // namespace couchbase::core
+
+namespace couchbase::core::impl
+{
+class observability_recorder;
+
+/**
+ * Executes the query, and hands over the row stream to the handler as soon as the metadata, that
+ * precedes the rows, has been received.
+ */
+void
+initiate_query_stream(const core::cluster& core,
+                      operations::query_request request,
+                      std::unique_ptr<observability_recorder> obs_rec,
+                      query_stream_handler&& handler);
+} // namespace couchbase::core::impl
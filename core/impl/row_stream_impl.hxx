@@ -0,0 +1,162 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2025. Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include <couchbase/error.hxx>
+#include <couchbase/error_codes.hxx>
+
+#include "core/cluster.hxx"
+#include "core/logger/logger.hxx"
+#include "error.hxx"
+#include "observability_recorder.hxx"
+#include "streaming_http_operation.hxx"
+
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <variant>
+
+namespace couchbase::core::impl
+{
+/**
+ * Common part of the public row streams, that pull the rows of a service response one by one.
+ *
+ * The Traits describe the service:
+ *  - request_type: the core request, that is executed by @ref streaming_http_operation
+ *  - row_type: the public type of the row
+ *  - result_type: the public metadata, that is decoded from the response after the rows
+ *  - decode_row(std::string&&): converts the raw JSON of the row, might throw
+ *  - build_result(response_type&): converts the response decoded from the metadata
+ */
+template<typename Traits>
+class row_stream_impl : public std::enable_shared_from_this<row_stream_impl<Traits>>
+{
+public:
+  using request_type = typename Traits::request_type;
+  using response_type = typename request_type::response_type;
+  using row_type = typename Traits::row_type;
+  using result_type = typename Traits::result_type;
+  using operation_type = streaming_http_operation<request_type>;
+  using row_handler = std::function<void(error, std::optional<row_type>)>;
+
+  row_stream_impl(std::shared_ptr<operation_type> operation,
+                  std::unique_ptr<observability_recorder> obs_rec)
+    : operation_{ std::move(operation) }
+    , obs_rec_{ std::move(obs_rec) }
+  {
+  }
+
+  void next_row(row_handler&& handler)
+  {
+    {
+      const std::scoped_lock lock{ mutex_ };
+      if (final_error_.has_value()) {
+        return handler(final_error_.value(), {});
+      }
+    }
+    operation_->next_row([self = this->shared_from_this(), handler = std::move(handler)](
+                           std::variant<std::string, response_type> item) {
+      if (std::holds_alternative<response_type>(item)) {
+        return handler(self->finish(std::get<response_type>(item)), {});
+      }
+      std::optional<row_type> row{};
+      try {
+        row.emplace(Traits::decode_row(std::move(std::get<std::string>(item))));
+      } catch (const std::exception& e) {
+        CB_LOG_ERROR("Unable to decode streamed {} row: {}", request_type::type, e.what());
+        return handler(self->fail(errc::common::parsing_failure), {});
+      }
+      handler({}, std::move(row));
+    });
+  }
+
+  [[nodiscard]] auto result() const -> std::optional<result_type>
+  {
+    const std::scoped_lock lock{ mutex_ };
+    return result_;
+  }
+
+  void cancel()
+  {
+    operation_->cancel();
+  }
+
+  /**
+   * Completes the operation with the response decoded from the metadata. It is invoked either
+   * after the last row, or when the request has failed before producing any rows.
+   */
+  auto finish(response_type& resp) -> error
+  {
+    auto err = make_error(resp.ctx);
+    obs_rec_->finish(resp.ctx.retry_attempts, resp.ctx.ec);
+    const std::scoped_lock lock{ mutex_ };
+    result_ = Traits::build_result(resp);
+    final_error_ = err;
+    return err;
+  }
+
+private:
+  auto fail(std::error_code ec) -> error
+  {
+    operation_->cancel();
+    obs_rec_->finish(ec);
+    error err{ ec };
+    const std::scoped_lock lock{ mutex_ };
+    final_error_ = err;
+    return err;
+  }
+
+  std::shared_ptr<operation_type> operation_;
+  std::unique_ptr<observability_recorder> obs_rec_;
+  std::optional<result_type> result_{};
+  std::optional<error> final_error_{};
+  mutable std::mutex mutex_{};
+};
+
+/**
+ * Executes the request, and hands over the row stream to the handler as soon as the metadata, that
+ * precedes the rows, has been received.
+ *
+ * @tparam Stream the public row stream, that wraps Impl
+ * @tparam Impl the implementation of the stream derived from @ref row_stream_impl
+ */
+template<typename Stream, typename Impl, typename Handler>
+void
+initiate_row_stream(const core::cluster& core,
+                    typename Impl::request_type request,
+                    std::string pointer_expression,
+                    std::unique_ptr<observability_recorder> obs_rec,
+                    Handler&& handler)
+{
+  auto operation = std::make_shared<typename Impl::operation_type>(
+    core, std::move(request), std::move(pointer_expression));
+  auto stream = std::make_shared<Impl>(operation, std::move(obs_rec));
+  operation->start([stream, handler = std::forward<Handler>(handler)](
+                     std::optional<typename Impl::response_type> failure) mutable {
+    if (failure.has_value()) {
+      auto err = stream->finish(failure.value());
+      return handler(std::move(err), Stream{});
+    }
+    handler({}, Stream{ std::move(stream) });
+  });
+}
+} // namespace couchbase::core::impl
@@ -16,6 +16,7 @@
  */
 
 #include "analytics.hxx"
+#include "analytics_row_stream.hxx"
 #include "core/cluster.hxx"
 #include "core/tracing/constants.hxx"
 #include "core/tracing/tracer_wrapper.hxx"
@@ -28,7 +29,9 @@
 #include "internal_search_row_locations.hxx"
 #include "observability_recorder.hxx"
 #include "query.hxx"
+#include "query_row_stream.hxx"
 #include "search.hxx"
+#include "search_row_stream.hxx"
 
 #include <couchbase/bucket.hxx>
 #include <couchbase/collection.hxx>
@@ -92,6 +95,21 @@ public:
       });
   }
 
+  void query_stream(std::string statement,
+                    query_options::built options,
+                    query_stream_handler&& handler) const
+  {
+    auto obs_rec = create_observability_recorder(
+      core::tracing::operation::query, core::service_type::query, options.parent_span);
+    obs_rec->with_query_statement(statement, options);
+
+    auto request = core::impl::build_query_request(
+      std::move(statement), query_context_, std::move(options), obs_rec->operation_span());
+
+    return core::impl::initiate_query_stream(
+      core_, std::move(request), std::move(obs_rec), std::move(handler));
+  }
+
   void analytics_query(std::string statement,
                        analytics_options::built options,
                        analytics_handler&& handler) const
@@ -111,6 +129,21 @@ public:
       });
   }
 
+  void analytics_query_stream(std::string statement,
+                              analytics_options::built options,
+                              analytics_stream_handler&& handler) const
+  {
+    auto obs_rec = create_observability_recorder(
+      core::tracing::operation::analytics, core::service_type::analytics, options.parent_span);
+    obs_rec->with_query_statement(statement, options);
+
+    auto request = core::impl::build_analytics_request(
+      std::move(statement), std::move(options), bucket_name_, name_, obs_rec->operation_span());
+
+    return core::impl::initiate_analytics_stream(
+      core_, std::move(request), std::move(obs_rec), std::move(handler));
+  }
+
   void search(std::string index_name,
               couchbase::search_request request,
               search_options::built options,
@@ -134,6 +167,24 @@ public:
       });
   }
 
+  void search_stream(std::string index_name,
+                     couchbase::search_request request,
+                     search_options::built options,
+                     search_stream_handler&& handler) const
+  {
+    auto obs_rec = create_observability_recorder(
+      core::tracing::operation::search, core::service_type::search, options.parent_span);
+
+    auto core_req = core::impl::build_search_request(std::move(index_name),
+                                                     std::move(request),
+                                                     std::move(options),
+                                                     bucket_name_,
+                                                     name_,
+                                                     obs_rec->operation_span());
+    return core::impl::initiate_search_stream(
+      core_, std::move(core_req), std::move(obs_rec), std::move(handler));
+  }
+
 private:
   [[nodiscard]] auto create_observability_recorder(
     const std::string& operation_name,
@@ -205,6 +256,26 @@ scope::query(std::string statement, const query_options& options) const
   return future;
 }
 
+void
+scope::query_stream(std::string statement,
+                    const query_options& options,
+                    query_stream_handler&& handler) const
+{
+  return impl_->query_stream(std::move(statement), options.build(), std::move(handler));
+}
+
+auto
+scope::query_stream(std::string statement, const query_options& options) const
+  -> std::future<std::pair<error, query_row_stream>>
+{
+  auto barrier = std::make_shared<std::promise<std::pair<error, query_row_stream>>>();
+  auto future = barrier->get_future();
+  query_stream(std::move(statement), options, [barrier](auto err, auto stream) {
+    barrier->set_value({ std::move(err), std::move(stream) });
+  });
+  return future;
+}
+
 void
 scope::analytics_query(std::string statement,
                        const analytics_options& options,
@@ -225,6 +296,26 @@ scope::analytics_query(std::string statement, const analytics_options& options)
   return future;
 }
 
+void
+scope::analytics_query_stream(std::string statement,
+                              const analytics_options& options,
+                              analytics_stream_handler&& handler) const
+{
+  return impl_->analytics_query_stream(std::move(statement), options.build(), std::move(handler));
+}
+
+auto
+scope::analytics_query_stream(std::string statement, const analytics_options& options) const
+  -> std::future<std::pair<error, analytics_row_stream>>
+{
+  auto barrier = std::make_shared<std::promise<std::pair<error, analytics_row_stream>>>();
+  auto future = barrier->get_future();
+  analytics_query_stream(std::move(statement), options, [barrier](auto err, auto stream) {
+    barrier->set_value({ std::move(err), std::move(stream) });
+  });
+  return future;
+}
+
 void
 scope::search(std::string index_name,
               search_request request,
@@ -247,6 +338,31 @@ scope::search(std::string index_name, search_request request, const search_optio
   return future;
 }
 
+void
+scope::search_stream(std::string index_name,
+                     search_request request,
+                     const search_options& options,
+                     search_stream_handler&& handler) const
+{
+  return impl_->search_stream(
+    std::move(index_name), std::move(request), options.build(), std::move(handler));
+}
+
+auto
+scope::search_stream(std::string index_name,
+                     search_request request,
+                     const search_options& options) const
+  -> std::future<std::pair<error, search_row_stream>>
+{
+  auto barrier = std::make_shared<std::promise<std::pair<error, search_row_stream>>>();
+  auto future = barrier->get_future();
+  search_stream(
+    std::move(index_name), std::move(request), options, [barrier](auto err, auto stream) {
+      barrier->set_value({ std::move(err), std::move(stream) });
+    });
+  return future;
+}
+
 auto
 scope::search_indexes() const -> scope_search_index_manager
 {
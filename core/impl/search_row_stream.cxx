@@ -0,0 +1,139 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2025. Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "search_row_stream.hxx"
+
+#include <couchbase/error_codes.hxx>
+#include <couchbase/search_result.hxx>
+
+#include "core/utils/json.hxx"
+#include "internal_search_meta_data.hxx"
+#include "internal_search_result.hxx"
+#include "internal_search_row.hxx"
+#include "row_stream_impl.hxx"
+
+#include <future>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+
+namespace couchbase
+{
+struct search_row_stream_traits {
+  using request_type = core::operations::search_request;
+  using row_type = search_row;
+
+  struct result_type {
+    core::operations::search_response::search_meta_data meta;
+    std::map<std::string, std::shared_ptr<search_facet_result>> facets;
+  };
+
+  static auto decode_row(std::string&& row) -> row_type
+  {
+    return search_row{ internal_search_row{
+      core::operations::parse_search_row(core::utils::json::parse(row)) } };
+  }
+
+  static auto build_result(core::operations::search_response& resp) -> result_type
+  {
+    // the response has been decoded from the metadata, so it does not have any rows to convert
+    const search_result result{ internal_search_result{ resp } };
+    return { resp.meta, result.facets() };
+  }
+};
+
+class search_row_stream_impl : public core::impl::row_stream_impl<search_row_stream_traits>
+{
+public:
+  using row_stream_impl::row_stream_impl;
+};
+
+search_row_stream::search_row_stream(std::shared_ptr<search_row_stream_impl> impl)
+  : impl_{ std::move(impl) }
+{
+}
+
+void
+search_row_stream::next_row(search_row_handler&& handler) const
+{
+  if (!impl_) {
+    return handler(error{ errc::common::request_canceled }, {});
+  }
+  impl_->next_row(std::move(handler));
+}
+
+auto
+search_row_stream::next_row() const -> std::future<std::pair<error, std::optional<search_row>>>
+{
+  auto barrier = std::make_shared<std::promise<std::pair<error, std::optional<search_row>>>>();
+  auto future = barrier->get_future();
+  next_row([barrier](auto err, auto row) {
+    barrier->set_value({ std::move(err), std::move(row) });
+  });
+  return future;
+}
+
+auto
+search_row_stream::meta_data() const -> std::optional<search_meta_data>
+{
+  if (!impl_) {
+    return {};
+  }
+  auto result = impl_->result();
+  if (!result.has_value()) {
+    return {};
+  }
+  return search_meta_data{ internal_search_meta_data{ result->meta } };
+}
+
+auto
+search_row_stream::facets() const
+  -> std::optional<std::map<std::string, std::shared_ptr<search_facet_result>>>
+{
+  if (!impl_) {
+    return {};
+  }
+  auto result = impl_->result();
+  if (!result.has_value()) {
+    return {};
+  }
+  return std::move(result->facets);
+}
+
+void
+search_row_stream::cancel() const
+{
+  if (impl_) {
+    impl_->cancel();
+  }
+}
+} // namespace couchbase
+
+namespace couchbase::core::impl
+{
+void
+initiate_search_stream(const core::cluster& core,
+                       operations::search_request request,
+                       std::unique_ptr<observability_recorder> obs_rec,
+                       search_stream_handler&& handler)
+{
+  return initiate_row_stream<search_row_stream, search_row_stream_impl>(
+    core, std::move(request), "/hits/^", std::move(obs_rec), std::move(handler));
+}
+} // namespace couchbase::core::impl
@@ -0,0 +1,334 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2025. Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include <couchbase/error_codes.hxx>
+
+#include "core/cluster.hxx"
+#include "core/core_sdk_shim.hxx"
+#include "core/free_form_http_request.hxx"
+#include "core/http_component.hxx"
+#include "core/io/http_context.hxx"
+#include "core/io/http_message.hxx"
+#include "core/io/http_session_manager.hxx"
+#include "core/logger/logger.hxx"
+#include "core/pending_operation.hxx"
+#include "core/pending_operation_connection_info.hxx"
+#include "core/platform/uuid.h"
+#include "core/row_streamer.hxx"
+#include "core/service_type_fmt.hxx"
+#include "core/utils/json.hxx"
+#include "core/utils/movable_function.hxx"
+
+#include <tao/json/value.hpp>
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <variant>
+
+namespace couchbase::core::impl
+{
+namespace detail
+{
+inline auto
+to_error_code(std::error_code ec) -> std::error_code
+{
+  return ec;
+}
+
+inline auto
+to_error_code(const error_union& err) -> std::error_code
+{
+  if (std::holds_alternative<impl::bootstrap_error>(err)) {
+    return std::get<impl::bootstrap_error>(err).ec;
+  }
+  if (std::holds_alternative<std::error_code>(err)) {
+    return std::get<std::error_code>(err);
+  }
+  return {};
+}
+} // namespace detail
+
+/**
+ * Executes the service request (query, analytics, search or view) and streams the rows of the
+ * response instead of buffering the whole body. The rows are selected by the pointer expression,
+ * i.e. "/results/^" for query and analytics, "/hits/^" for search, and "/rows/^" for views.
+ *
+ * The rows are pulled by the caller, and the body is read from the socket only as fast as the rows
+ * are consumed, so at most one row buffer of the response is held in memory. The metadata that
+ * surrounds the rows is decoded with Request::make_response, so the errors and the metadata are
+ * the same as for the buffered request.
+ */
+template<typename Request>
+class streaming_http_operation
+  : public std::enable_shared_from_this<streaming_http_operation<Request>>
+{
+public:
+  using response_type = typename Request::response_type;
+  using error_context_type = typename Request::error_context_type;
+  using start_handler = utils::movable_function<void(std::optional<response_type>)>;
+  using row_handler = utils::movable_function<void(std::variant<std::string, response_type>)>;
+
+  /**
+   * @param row_buffer_size number of rows to read ahead of the caller, by default it is taken from
+   * the streaming_row_buffer_size of the cluster options.
+   */
+  streaming_http_operation(core::cluster core,
+                           Request request,
+                           std::string pointer_expression,
+                           std::optional<std::size_t> row_buffer_size = {})
+    : core_{ std::move(core) }
+    , http_{ core_.io_context(), core_sdk_shim{ core_ } }
+    , request_{ std::move(request) }
+    , pointer_expression_{ std::move(pointer_expression) }
+    , row_buffer_size_{ row_buffer_size }
+    , client_context_id_{ request_.client_context_id.value_or(uuid::to_string(uuid::random())) }
+  {
+  }
+
+  /**
+   * Dispatches the request and waits for the metadata that precedes the rows.
+   *
+   * @param handler receives empty optional when the rows can be pulled with next_row(), or the
+   * response with the error otherwise.
+   */
+  void start(start_handler&& handler)
+  {
+    start_handler_ = std::move(handler);
+    dispatch();
+  }
+
+  /**
+   * Retrieves the next row. Once all rows have been consumed, the handler receives the response
+   * decoded from the metadata, that might also carry the error reported after the rows.
+   */
+  void next_row(row_handler&& handler)
+  {
+    streamer_->next_row([self = this->shared_from_this(), handler = std::move(handler)](
+                          std::string row, std::error_code ec) mutable {
+      if (ec || row.empty()) {
+        return handler(self->finish(ec));
+      }
+      handler(std::move(row));
+    });
+  }
+
+  void cancel()
+  {
+    std::shared_ptr<pending_operation> op;
+    std::shared_ptr<row_streamer> streamer;
+    {
+      const std::scoped_lock lock{ mutex_ };
+      std::swap(op, pending_op_);
+      streamer = streamer_;
+    }
+    if (op) {
+      op->cancel();
+    }
+    if (streamer) {
+      streamer->cancel();
+    }
+  }
+
+private:
+  void dispatch()
+  {
+    auto [ec, session_manager] = core_.http_session_manager();
+    if (ec) {
+      return invoke_start_handler(make_response(ec, {}));
+    }
+
+    if (!deadline_) {
+      deadline_ = std::chrono::steady_clock::now() +
+                  request_.timeout.value_or(session_manager->default_timeout_for(Request::type));
+    }
+    const auto timeout = std::chrono::duration_cast<std::chrono::milliseconds>(
+      deadline_.value() - std::chrono::steady_clock::now());
+    if (timeout <= std::chrono::milliseconds::zero()) {
+      return invoke_start_handler(make_response(errc::common::unambiguous_timeout, {}));
+    }
+
+    encoded_ = {};
+    encoded_.type = Request::type;
+    encoded_.client_context_id = client_context_id_;
+    encoded_.timeout = timeout;
+    auto context = session_manager->encoding_context();
+    if (!row_buffer_size_) {
+      row_buffer_size_ = context.options.streaming_row_buffer_size;
+    }
+    if (auto encode_ec = request_.encode_to(encoded_, context); encode_ec) {
+      return invoke_start_handler(make_response(encode_ec, {}));
+    }
+
+    http_request req{ encoded_.type, encoded_.method };
+    req.path = encoded_.path;
+    req.headers = encoded_.headers;
+    req.body = encoded_.body;
+    req.client_context_id = client_context_id_;
+    req.timeout = timeout;
+    req.parent_span = request_.parent_span;
+    // the session manager owns the encoding context, that the request refers to
+    session_manager_ = std::move(session_manager);
+
+    auto op = http_.do_http_request(
+      req, [self = this->shared_from_this()](http_response resp, auto err) mutable {
+        std::shared_ptr<pending_operation> op;
+        {
+          const std::scoped_lock lock{ self->mutex_ };
+          std::swap(op, self->pending_op_);
+        }
+        if (auto ec = detail::to_error_code(err); ec) {
+          return self->invoke_start_handler(self->make_response(ec, {}));
+        }
+        // op can be null if the response has been received before do_http_request returned
+        if (auto info = std::dynamic_pointer_cast<pending_operation_connection_info>(op); info) {
+          self->last_dispatched_to_ = info->dispatched_to();
+          self->last_dispatched_from_ = info->dispatched_from();
+        }
+        self->status_code_ = resp.status_code();
+        auto streamer = std::make_shared<row_streamer>(self->core_.io_context(),
+                                                       resp.body(),
+                                                       self->pointer_expression_,
+                                                       self->row_buffer_size_.value());
+        {
+          // cancel() might read the streamer from another thread
+          const std::scoped_lock lock{ self->mutex_ };
+          self->streamer_ = streamer;
+        }
+        streamer->start([self](std::string header, std::error_code ec) mutable {
+          self->on_metadata_header(std::move(header), ec);
+        });
+      });
+    if (!op.has_value()) {
+      return invoke_start_handler(make_response(detail::to_error_code(op.error()), {}));
+    }
+    const std::scoped_lock lock{ mutex_ };
+    pending_op_ = std::move(op.value());
+  }
+
+  void on_metadata_header(std::string header, std::error_code ec)
+  {
+    if (ec) {
+      return invoke_start_handler(make_response(ec, header));
+    }
+    bool has_errors = status_code_ != 200;
+    try {
+      auto meta = utils::json::parse(header);
+      if (const auto* errors = meta.find("errors"); errors != nullptr && errors->is_array()) {
+        has_errors = has_errors || !errors->get_array().empty();
+      }
+    } catch (const tao::pegtl::parse_error&) {
+      return invoke_start_handler(make_response(errc::common::parsing_failure, header));
+    }
+    if (!has_errors) {
+      return invoke_start_handler({});
+    }
+    // The request has failed before producing any rows, so the rest of the body is small. Read it
+    // completely and let the request decide whether it should be retried.
+    drain();
+  }
+
+  void drain()
+  {
+    streamer_->next_row([self = this->shared_from_this()](std::string row, std::error_code ec) {
+      if (!ec && !row.empty()) {
+        return self->drain();
+      }
+      try {
+        return self->invoke_start_handler(
+          self->make_response(ec, self->streamer_->metadata().value_or("")));
+      } catch (const priv::retry_http_request&) {
+        ++self->retry_attempts_;
+        CB_LOG_DEBUG(R"(Retrying streaming HTTP request: {}, client_context_id="{}", attempt={})",
+                     Request::type,
+                     self->client_context_id_,
+                     self->retry_attempts_);
+        return self->dispatch();
+      }
+    });
+  }
+
+  auto finish(std::error_code ec) -> response_type
+  {
+    try {
+      return make_response(ec, streamer_->metadata().value_or(""));
+    } catch (const priv::retry_http_request&) {
+      // Some rows have been already handed over to the caller, so the request cannot be retried
+      // transparently at this point.
+      return make_response(errc::common::request_canceled, {});
+    }
+  }
+
+  auto make_response(std::error_code ec, const std::string& body) -> response_type
+  {
+    error_context_type ctx{};
+    ctx.ec = ec;
+    ctx.client_context_id = client_context_id_;
+    ctx.method = encoded_.method;
+    ctx.path = encoded_.path;
+    ctx.http_status = status_code_;
+    ctx.http_body = body;
+    ctx.retry_attempts = retry_attempts_;
+    if (!last_dispatched_to_.empty()) {
+      ctx.last_dispatched_to = last_dispatched_to_;
+    }
+    if (!last_dispatched_from_.empty()) {
+      ctx.last_dispatched_from = last_dispatched_from_;
+    }
+    io::http_response encoded_response{};
+    encoded_response.status_code = status_code_;
+    encoded_response.body.append(body);
+    return request_.make_response(std::move(ctx), encoded_response);
+  }
+
+  void invoke_start_handler(std::optional<response_type> response)
+  {
+    start_handler handler{};
+    {
+      const std::scoped_lock lock{ mutex_ };
+      std::swap(handler, start_handler_);
+    }
+    if (handler) {
+      handler(std::move(response));
+    }
+  }
+
+  core::cluster core_;
+  http_component http_;
+  Request request_;
+  std::string pointer_expression_;
+  std::optional<std::size_t> row_buffer_size_;
+  std::string client_context_id_;
+  std::optional<std::chrono::steady_clock::time_point> deadline_{};
+  io::http_request encoded_{};
+  std::shared_ptr<io::http_session_manager> session_manager_{};
+  std::shared_ptr<row_streamer> streamer_{};
+  std::uint32_t status_code_{};
+  std::size_t retry_attempts_{ 0 };
+  std::string last_dispatched_to_{};
+  std::string last_dispatched_from_{};
+  std::shared_ptr<pending_operation> pending_op_{};
+  start_handler start_handler_{};
+  std::mutex mutex_{};
+};
+} // namespace couchbase::core::impl
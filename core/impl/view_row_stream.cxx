@@ -0,0 +1,109 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2025. Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#define COUCHBASE_CXX_CLIENT_IGNORE_CORE_DEPRECATIONS
+#include "view_row_stream.hxx"
+#undef COUCHBASE_CXX_CLIENT_IGNORE_CORE_DEPRECATIONS
+
+#include <couchbase/error_codes.hxx>
+
+#include "core/cluster.hxx"
+#include "core/logger/logger.hxx"
+#include "core/utils/json.hxx"
+#include "streaming_http_operation.hxx"
+
+#include <exception>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <variant>
+
+namespace couchbase::core::impl
+{
+view_row_stream::view_row_stream(std::shared_ptr<operation_type> operation)
+  : operation_{ std::move(operation) }
+{
+}
+
+void
+view_row_stream::next_row(row_handler&& handler)
+{
+  std::optional<response_type> final_response{};
+  {
+    const std::scoped_lock lock{ mutex_ };
+    final_response = final_response_;
+  }
+  if (final_response.has_value()) {
+    return handler(std::move(final_response.value()));
+  }
+  operation_->next_row([self = shared_from_this(), handler = std::move(handler)](
+                         std::variant<std::string, response_type> item) mutable {
+    if (std::holds_alternative<response_type>(item)) {
+      auto& resp = std::get<response_type>(item);
+      {
+        const std::scoped_lock lock{ self->mutex_ };
+        self->final_response_ = resp;
+      }
+      return handler(std::move(resp));
+    }
+    std::optional<row_type> row{};
+    try {
+      row.emplace(
+        operations::parse_view_row(utils::json::parse(std::get<std::string>(item))));
+    } catch (const std::exception& e) {
+      CB_LOG_ERROR("Unable to decode streamed view row: {}", e.what());
+      return handler(self->fail(errc::common::parsing_failure));
+    }
+    handler(std::move(row.value()));
+  });
+}
+
+void
+view_row_stream::cancel()
+{
+  operation_->cancel();
+}
+
+auto
+view_row_stream::fail(std::error_code ec) -> response_type
+{
+  operation_->cancel();
+  response_type resp{};
+  resp.ctx.ec = ec;
+  const std::scoped_lock lock{ mutex_ };
+  final_response_ = resp;
+  return resp;
+}
+
+void
+initiate_view_stream(const core::cluster& core,
+                     operations::document_view_request request,
+                     view_row_stream::start_handler&& handler)
+{
+  auto operation =
+    std::make_shared<view_row_stream::operation_type>(core, std::move(request), "/rows/^");
+  auto stream = std::make_shared<view_row_stream>(operation);
+  operation->start([stream, handler = std::move(handler)](
+                     std::optional<view_row_stream::response_type> failure) mutable {
+    if (failure.has_value()) {
+      return handler(std::move(failure), nullptr);
+    }
+    handler({}, std::move(stream));
+  });
+}
+} // namespace couchbase::core::impl
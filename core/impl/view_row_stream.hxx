@@ -0,0 +1,82 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2025. Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include "core/operations/document_view.hxx"
+#include "core/utils/movable_function.hxx"
+
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <variant>
+
+namespace couchbase::core
+{
+class cluster;
+} // namespace couchbase::core
+
+namespace couchbase::core::impl
+{
+template<typename Request>
+class streaming_http_operation;
+
+/**
+ * Stream of the rows of the view query, that are pulled by the caller. Unlike
+ * document_view_request::row_callback, the body is read from the socket only as fast as the rows
+ * are consumed, so at most streaming_row_buffer_size rows are held in memory.
+ *
+ * Views are deprecated and do not have public API, so the stream is only available through the
+ * core.
+ */
+class view_row_stream : public std::enable_shared_from_this<view_row_stream>
+{
+public:
+  using row_type = operations::document_view_response::row;
+  using response_type = operations::document_view_response;
+  using operation_type = streaming_http_operation<operations::document_view_request>;
+  /**
+   * Receives the next row, or the response decoded from the metadata after the last row. The
+   * response carries the meta data of the view and the error, if any.
+   */
+  using row_handler = utils::movable_function<void(std::variant<row_type, response_type>)>;
+  using start_handler =
+    utils::movable_function<void(std::optional<response_type>, std::shared_ptr<view_row_stream>)>;
+
+  explicit view_row_stream(std::shared_ptr<operation_type> operation);
+
+  void next_row(row_handler&& handler);
+  void cancel();
+
+private:
+  auto fail(std::error_code ec) -> response_type;
+
+  std::shared_ptr<operation_type> operation_;
+  std::optional<response_type> final_response_{};
+  std::mutex mutex_{};
+};
+
+/**
+ * Executes the view query, and hands over the row stream to the handler as soon as the metadata,
+ * that precedes the rows, has been received. When the query fails before producing any rows, the
+ * handler receives the response with the error instead of the stream.
+ */
+void
+initiate_view_stream(const core::cluster& core,
+                     operations::document_view_request request,
+                     view_row_stream::start_handler&& handler);
+} // namespace couchbase::core::impl
@@ -0,0 +1,227 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2025-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+#include "deadline_wheel.hxx"
+
+#include <algorithm>
+
+namespace couchbase::core::io
+{
+deadline_wheel::deadline_wheel(asio::io_context& ctx,
+                               std::chrono::milliseconds tick,
+                               std::size_t number_of_slots)
+  : timer_{ ctx }
+  , tick_{ std::max(tick, std::chrono::milliseconds{ 1 }) }
+  , slots_(std::max<std::size_t>(number_of_slots, 1), npos)
+{
+}
+
+auto
+deadline_wheel::tick_of(clock::time_point time) const -> std::uint64_t
+{
+  if (time <= origin_) {
+    return 0;
+  }
+  // round up, so that the entry is never visited before its expiry
+  const auto elapsed = time - origin_;
+  const auto ticks = elapsed / tick_;
+  return static_cast<std::uint64_t>(ticks) + (elapsed % tick_ == clock::duration::zero() ? 0 : 1);
+}
+
+void
+deadline_wheel::link(std::uint32_t index, std::uint64_t tick)
+{
+  auto slot = static_cast<std::uint32_t>(tick % slots_.size());
+  auto& e = entries_[index];
+  e.slot = slot;
+  e.prev = npos;
+  e.next = slots_[slot];
+  if (e.next != npos) {
+    entries_[e.next].prev = index;
+  }
+  slots_[slot] = index;
+}
+
+void
+deadline_wheel::unlink(std::uint32_t index)
+{
+  auto& e = entries_[index];
+  if (e.prev != npos) {
+    entries_[e.prev].next = e.next;
+  } else {
+    slots_[e.slot] = e.next;
+  }
+  if (e.next != npos) {
+    entries_[e.next].prev = e.prev;
+  }
+  e.slot = npos;
+  e.prev = npos;
+  e.next = npos;
+}
+
+void
+deadline_wheel::release(std::uint32_t index)
+{
+  ++entries_[index].generation;
+  free_entries_.push_back(index);
+  --size_;
+}
+
+auto
+deadline_wheel::schedule(clock::time_point expiry, std::shared_ptr<deadline_listener> listener)
+  -> handle
+{
+  const std::scoped_lock lock(mutex_);
+  if (stopped_) {
+    return { npos, 0 };
+  }
+  std::uint32_t index{};
+  if (free_entries_.empty()) {
+    index = static_cast<std::uint32_t>(entries_.size());
+    entries_.emplace_back();
+  } else {
+    index = free_entries_.back();
+    free_entries_.pop_back();
+  }
+  auto& e = entries_[index];
+  e.listener = std::move(listener);
+  e.expiry = expiry;
+  link(index, std::max(tick_of(expiry), last_tick_ + 1));
+  ++size_;
+  if (!armed_) {
+    arm();
+  }
+  return { index, e.generation };
+}
+
+auto
+deadline_wheel::cancel(handle deadline) -> bool
+{
+  std::shared_ptr<deadline_listener> listener{};
+  {
+    const std::scoped_lock lock(mutex_);
+    if (deadline.index >= entries_.size()) {
+      return false;
+    }
+    auto& e = entries_[deadline.index];
+    if (e.generation != deadline.generation || e.slot == npos) {
+      return false;
+    }
+    unlink(deadline.index);
+    // destroy the listener outside of the lock, as it might be the last reference to the command
+    listener = std::move(e.listener);
+    release(deadline.index);
+  }
+  return true;
+}
+
+void
+deadline_wheel::stop()
+{
+  std::vector<std::shared_ptr<deadline_listener>> dropped{};
+  {
+    const std::scoped_lock lock(mutex_);
+    if (stopped_) {
+      return;
+    }
+    stopped_ = true;
+    for (auto& slot : slots_) {
+      auto index = slot;
+      while (index != npos) {
+        const auto next = entries_[index].next;
+        dropped.emplace_back(std::move(entries_[index].listener));
+        entries_[index].slot = npos;
+        entries_[index].prev = npos;
+        entries_[index].next = npos;
+        release(index);
+        index = next;
+      }
+      slot = npos;
+    }
+    timer_.cancel();
+    armed_ = false;
+  }
+  // destroy the listeners outside of the lock, as they might be the last references to the commands
+  dropped.clear();
+}
+
+auto
+deadline_wheel::size() const -> std::size_t
+{
+  const std::scoped_lock lock(mutex_);
+  return size_;
+}
+
+void
+deadline_wheel::arm()
+{
+  armed_ = true;
+  timer_.expires_at(origin_ + tick_ * (last_tick_ + 1));
+  timer_.async_wait([self = shared_from_this()](std::error_code ec) {
+    if (ec == asio::error::operation_aborted) {
+      return;
+    }
+    self->on_tick();
+  });
+}
+
+void
+deadline_wheel::on_tick()
+{
+  std::vector<std::shared_ptr<deadline_listener>> firing{};
+  {
+    const std::scoped_lock lock(mutex_);
+    const auto now = clock::now();
+    // only the ticks that have fully passed, the entries in their slots are due
+    const auto now_tick =
+      std::max(static_cast<std::uint64_t>((now - origin_) / tick_), last_tick_);
+    auto from = last_tick_ + 1;
+    if (now_tick >= from + slots_.size()) {
+      // the IO thread was late for more than one revolution, sweep each slot once
+      from = now_tick - slots_.size() + 1;
+    }
+    for (auto tick = from; tick <= now_tick; ++tick) {
+      auto index = slots_[tick % slots_.size()];
+      while (index != npos) {
+        const auto next = entries_[index].next;
+        if (entries_[index].expiry <= now) {
+          unlink(index);
+          expired_.emplace_back(std::move(entries_[index].listener));
+          release(index);
+        }
+        index = next;
+      }
+    }
+    last_tick_ = now_tick;
+    armed_ = false;
+    if (size_ > 0) {
+      arm();
+    }
+    firing.swap(expired_);
+  }
+
+  for (const auto& listener : firing) {
+    listener->on_deadline();
+  }
+  firing.clear();
+
+  // keep the capacity of the buffer for the next tick
+  const std::scoped_lock lock(mutex_);
+  if (expired_.capacity() < firing.capacity()) {
+    expired_.swap(firing);
+  }
+}
+} // namespace couchbase::core::io
@@ -0,0 +1,161 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2025-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+#pragma once
+
+#include <asio/io_context.hpp>
+#include <asio/steady_timer.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace couchbase::core::io
+{
+class deadline_listener
+{
+public:
+  deadline_listener() = default;
+  deadline_listener(const deadline_listener& other) = default;
+  deadline_listener(deadline_listener&& other) = default;
+  auto operator=(const deadline_listener& other) -> deadline_listener& = default;
+  auto operator=(deadline_listener&& other) -> deadline_listener& = default;
+  virtual ~deadline_listener() = default;
+
+  virtual void on_deadline() = 0;
+};
+
+/**
+ * Hashed timing wheel for operation deadlines.
+ *
+ * Instead of arming a separate asio timer for every operation, the deadlines are stored in the
+ * slots of the wheel, and a single timer ticks while the wheel is not empty. Entries live in a
+ * reusable slab, so once the wheel has warmed up, scheduling and cancelling deadlines does not
+ * allocate.
+ *
+ * The deadline is never reported early, but might be reported up to one tick late.
+ */
+class deadline_wheel : public std::enable_shared_from_this<deadline_wheel>
+{
+public:
+  using clock = std::chrono::steady_clock;
+
+  static constexpr std::chrono::milliseconds default_tick{ 10 };
+  static constexpr std::size_t default_number_of_slots{ 512 };
+
+  struct handle {
+    std::uint32_t index{ 0 };
+    std::uint32_t generation{ 0 };
+  };
+
+  explicit deadline_wheel(asio::io_context& ctx,
+                          std::chrono::milliseconds tick = default_tick,
+                          std::size_t number_of_slots = default_number_of_slots);
+
+  /**
+   * Invokes listener->on_deadline() on the IO thread once the expiry time has passed. The wheel
+   * keeps the listener alive until then, or until the deadline is cancelled.
+   */
+  auto schedule(clock::time_point expiry, std::shared_ptr<deadline_listener> listener) -> handle;
+
+  /**
+   * @return true if the deadline was pending, false if it has already fired or been cancelled.
+   */
+  auto cancel(handle deadline) -> bool;
+
+  /**
+   * Cancels the timer and drops all pending deadlines without firing them. The listeners usually
+   * refer back to the wheel through their deadline_timer, so the owner must stop the wheel to break
+   * the cycle. Deadlines scheduled after stop() are ignored.
+   */
+  void stop();
+
+  [[nodiscard]] auto size() const -> std::size_t;
+
+private:
+  static constexpr std::uint32_t npos{ std::numeric_limits<std::uint32_t>::max() };
+
+  struct entry {
+    std::shared_ptr<deadline_listener> listener{};
+    clock::time_point expiry{};
+    std::uint32_t generation{ 1 };
+    std::uint32_t slot{ npos };
+    std::uint32_t prev{ npos };
+    std::uint32_t next{ npos };
+  };
+
+  [[nodiscard]] auto tick_of(clock::time_point time) const -> std::uint64_t;
+  void link(std::uint32_t index, std::uint64_t tick);
+  void unlink(std::uint32_t index);
+  void release(std::uint32_t index);
+  void arm();
+  void on_tick();
+
+  asio::steady_timer timer_;
+  const std::chrono::milliseconds tick_;
+  const clock::time_point origin_{ clock::now() };
+  std::vector<std::uint32_t> slots_;
+  std::vector<entry> entries_{};
+  std::vector<std::uint32_t> free_entries_{};
+  std::vector<std::shared_ptr<deadline_listener>> expired_{};
+  std::uint64_t last_tick_{ 0 };
+  std::size_t size_{ 0 };
+  bool armed_{ false };
+  bool stopped_{ false };
+  mutable std::mutex mutex_{};
+};
+
+/**
+ * Deadline of the single operation, that mimics the subset of asio::steady_timer interface used
+ * by the commands.
+ */
+class deadline_timer
+{
+public:
+  explicit deadline_timer(std::shared_ptr<deadline_wheel> wheel)
+    : wheel_{ std::move(wheel) }
+  {
+  }
+
+  void expires_after(std::chrono::milliseconds duration)
+  {
+    expiry_ = deadline_wheel::clock::now() + duration;
+  }
+
+  [[nodiscard]] auto expiry() const -> deadline_wheel::clock::time_point
+  {
+    return expiry_;
+  }
+
+  void async_wait(std::shared_ptr<deadline_listener> listener)
+  {
+    handle_ = wheel_->schedule(expiry_, std::move(listener));
+  }
+
+  void cancel()
+  {
+    wheel_->cancel(handle_);
+  }
+
+private:
+  std::shared_ptr<deadline_wheel> wheel_;
+  deadline_wheel::clock::time_point expiry_{};
+  deadline_wheel::handle handle_{};
+};
+} // namespace couchbase::core::io
@@ -91,6 +91,25 @@ public:
     return config_.capabilities;
   }
 
+  /**
+   * Context for the requests, that are encoded outside of http_command (e.g. streaming requests
+   * sent through http_component). The context is not bound to any node.
+   */
+  auto encoding_context() -> http_context
+  {
+    return { config_, options_, query_cache_, {}, 0, {}, 0 };
+  }
+
+  [[nodiscard]] auto default_timeout_for(service_type type) const -> std::chrono::milliseconds
+  {
+    return options_.default_timeout_for(type);
+  }
+
+  [[nodiscard]] auto query_cache_stats() const -> core::query_cache_stats
+  {
+    return query_cache_.stats();
+  }
+
 #ifdef COUCHBASE_CXX_CLIENT_COLUMNAR
   void notify_bootstrap_error(const impl::bootstrap_error& error) override
   {
@@ -159,6 +178,7 @@ public:
       std::scoped_lock lock(config_mutex_, next_index_mutex_);
       options_ = options;
       next_index_ = next_index;
+      query_cache_.set_capacity(options.prepared_statement_cache_capacity);
       config_ = config;
 #ifdef COUCHBASE_CXX_CLIENT_COLUMNAR
       if (!configured_) {
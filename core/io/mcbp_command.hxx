@@ -22,7 +22,6 @@
 #include "core/error_context/key_value_error_map_info.hxx"
 #include "core/metrics/meter_wrapper.hxx"
 #include "core/operations/operation_traits.hxx"
-#include "core/platform/uuid.h"
 #include "core/protocol/client_request.hxx"
 #include "core/protocol/client_response.hxx"
 #include "core/protocol/cmd_get_collection_id.hxx"
@@ -30,8 +29,11 @@
 #include "core/utils/movable_function.hxx"
 #include "couchbase/metrics/meter.hxx"
 #include "couchbase/tracing/request_tracer.hxx"
+#include "deadline_wheel.hxx"
 #include "mcbp_session.hxx"
 #include "mcbp_traits.hxx"
+#include "operation_id.hxx"
+#include "operation_id_fmt.hxx"
 #include "retry_orchestrator.hxx"
 
 #include <couchbase/durability_level.hxx>
@@ -54,12 +56,16 @@ using mcbp_command_handler =
   utils::movable_function<void(std::error_code, std::optional<io::mcbp_message>&&)>;
 
 template<typename Manager, typename Request>
-struct mcbp_command : public std::enable_shared_from_this<mcbp_command<Manager, Request>> {
+struct mcbp_command
+  : public std::enable_shared_from_this<mcbp_command<Manager, Request>>
+  , public io::deadline_listener {
   static constexpr std::chrono::milliseconds durability_timeout_floor{ 1'500 };
 
   using encoded_request_type = typename Request::encoded_request_type;
   using encoded_response_type = typename Request::encoded_response_type;
-  asio::steady_timer deadline;
+  // Deadlines of all commands of the bucket share a single timing wheel, to avoid arming a
+  // separate timer in the io_context for each operation.
+  io::deadline_timer deadline;
   asio::steady_timer retry_backoff;
   // Only cancellable operations (replica fan-out) need a strand: their dispatch
   // path can run on the caller thread while a sibling's completion cancels them
@@ -80,9 +86,7 @@ struct mcbp_command : public std::enable_shared_from_this<mcbp_command<Manager,
   mcbp_command_handler handler_{};
   std::shared_ptr<Manager> manager_{};
   std::chrono::milliseconds timeout_{};
-  std::string id_{ fmt::format("{:02x}/{}",
-                               static_cast<std::uint8_t>(encoded_request_type::body_type::opcode),
-                               uuid::to_string(uuid::random())) };
+  io::operation_id id_{ static_cast<std::uint8_t>(encoded_request_type::body_type::opcode) };
 #ifdef COUCHBASE_CXX_CLIENT_CREATE_OPERATION_SPAN_IN_CORE
   std::shared_ptr<couchbase::tracing::request_span> span_{ nullptr };
 #endif
@@ -90,7 +94,8 @@ struct mcbp_command : public std::enable_shared_from_this<mcbp_command<Manager,
   std::optional<std::string> last_dispatched_from_{};
   std::optional<std::string> last_dispatched_to_{};
   std::chrono::time_point<std::chrono::steady_clock> started_at_{};
-  std::vector<std::chrono::microseconds> server_durations_{};
+  std::optional<std::chrono::microseconds> last_server_duration_{};
+  std::chrono::microseconds total_server_duration_{};
 
   static auto make_command_strand(asio::io_context& ctx) -> command_strand
   {
@@ -105,7 +110,7 @@ struct mcbp_command : public std::enable_shared_from_this<mcbp_command<Manager,
                std::shared_ptr<Manager> manager,
                Request req,
                std::chrono::milliseconds default_timeout)
-    : deadline(ctx)
+    : deadline(manager->deadline_wheel())
     , retry_backoff(ctx)
     , strand_(make_command_strand(ctx))
     , request(req)
@@ -141,12 +146,7 @@ struct mcbp_command : public std::enable_shared_from_this<mcbp_command<Manager,
 
     handler_ = std::move(handler);
     deadline.expires_after(timeout_);
-    deadline.async_wait([self = this->shared_from_this()](std::error_code ec) {
-      if (ec == asio::error::operation_aborted) {
-        return;
-      }
-      self->cancel(retry_reason::do_not_retry);
-    });
+    deadline.async_wait(this->shared_from_this());
 
     if constexpr (is_cancellable_operation_v<Request>) {
       request.cancel_token->setup([weak_self = this->weak_from_this()] {
@@ -157,6 +157,11 @@ struct mcbp_command : public std::enable_shared_from_this<mcbp_command<Manager,
     }
   }
 
+  void on_deadline() override
+  {
+    cancel(retry_reason::do_not_retry);
+  }
+
   void cancel(retry_reason reason, bool is_timeout = true)
   {
     if constexpr (is_cancellable_operation_v<Request>) {
@@ -289,6 +294,7 @@ struct mcbp_command : public std::enable_shared_from_this<mcbp_command<Manager,
         protocol::client_response<protocol::get_collection_id_response_body> resp(std::move(msg));
         self->session_->update_collection_uid(self->request.id.collection_path(),
                                               resp.body().collection_uid());
+        self->request.id.keyspace().collection_uid(resp.body().collection_uid());
         self->request.id.collection_uid(resp.body().collection_uid());
         return self->send();
       }));
@@ -324,7 +330,12 @@ struct mcbp_command : public std::enable_shared_from_this<mcbp_command<Manager,
     request.opaque = *opaque_;
     if (request.id.use_collections() && !request.id.is_collection_resolved()) {
       if (session_->supports_feature(protocol::hello_feature::collections)) {
-        auto collection_id = session_->get_collection_uid(request.id.collection_path());
+        // the keyspace is shared by all requests of the collection, so the UID resolved by any
+        // of them spares the lookup by path in the session cache
+        auto collection_id = request.id.keyspace().collection_uid();
+        if (!collection_id) {
+          collection_id = session_->get_collection_uid(request.id.collection_path());
+        }
         if (collection_id) {
           request.id.collection_uid(collection_id.value());
         } else {
@@ -355,9 +366,11 @@ struct mcbp_command : public std::enable_shared_from_this<mcbp_command<Manager,
     }
 
     auto dispatch_span = create_dispatch_span();
+    // the value of the mutation is written directly from the request, that is kept alive by the
+    // output buffer of the session until the write completes
     session_->write_and_subscribe(
       request.opaque,
-      encoded.data(session_->supports_feature(protocol::hello_feature::snappy)),
+      encoded.gathered_data(session_->compression_policy_for(request.id), this->shared_from_this()),
       on_strand([self = this->shared_from_this(),
                  start = std::chrono::steady_clock::now(),
                  dispatch_span = std::move(dispatch_span)](
@@ -368,7 +381,8 @@ struct mcbp_command : public std::enable_shared_from_this<mcbp_command<Manager,
         {
           const auto server_duration_us =
             static_cast<std::uint64_t>(protocol::parse_server_duration_us(msg));
-          self->server_durations_.emplace_back(std::chrono::microseconds(server_duration_us));
+          self->last_server_duration_ = std::chrono::microseconds(server_duration_us);
+          self->total_server_duration_ += std::chrono::microseconds(server_duration_us);
           self->close_dispatch_span(dispatch_span, server_duration_us);
         }
         {
@@ -515,11 +529,9 @@ private:
     attrs.operation_id = fmt::format("0x{:x}", request.opaque);
     attrs.last_remote_socket = session_->remote_address();
     attrs.last_local_socket = session_->local_address();
-    if (!server_durations_.empty()) {
-      attrs.last_server_duration = server_durations_.back();
-      for (const auto d : server_durations_) {
-        attrs.total_server_duration += d;
-      }
+    if (last_server_duration_) {
+      attrs.last_server_duration = last_server_duration_.value();
+      attrs.total_server_duration = total_server_duration_;
     }
     attrs.total_duration = std::chrono::duration_cast<std::chrono::microseconds>(
       std::chrono::steady_clock::now() - started_at_);
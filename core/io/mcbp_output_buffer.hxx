@@ -0,0 +1,60 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2025 Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include <gsl/span>
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace couchbase::core::io
+{
+/**
+ * Encoded MCBP message, that is written to the socket as up to two buffers: the head (header,
+ * framing extras, extras and key), that is owned by the message, and the value, that is referenced
+ * without copying. The owner keeps the value alive until the write completes.
+ */
+struct mcbp_output_buffer {
+  std::vector<std::byte> head{};
+  gsl::span<const std::byte> value{};
+  std::shared_ptr<const void> value_owner{};
+
+  mcbp_output_buffer() = default;
+
+  explicit mcbp_output_buffer(std::vector<std::byte> message)
+    : head{ std::move(message) }
+  {
+  }
+
+  mcbp_output_buffer(std::vector<std::byte> message_head,
+                     gsl::span<const std::byte> message_value,
+                     std::shared_ptr<const void> owner)
+    : head{ std::move(message_head) }
+    , value{ message_value }
+    , value_owner{ std::move(owner) }
+  {
+  }
+
+  [[nodiscard]] auto size() const -> std::size_t
+  {
+    return head.size() + value.size();
+  }
+};
+} // namespace couchbase::core::io
@@ -34,12 +34,13 @@ auto
 mcbp_parser::next(mcbp_message& msg) -> mcbp_parser::result
 {
   static const std::size_t header_size = 24;
-  if (buf.size() < header_size) {
+  if (available() < header_size) {
     return result::need_data;
   }
-  std::memcpy(&msg.header, buf.data(), header_size);
+  const std::byte* frame = buf.data() + offset;
+  std::memcpy(&msg.header, frame, header_size);
   std::uint32_t body_size = utils::byte_swap(msg.header.bodylen);
-  if (body_size > 0 && buf.size() - header_size < body_size) {
+  if (body_size > 0 && available() - header_size < body_size) {
     return result::need_data;
   }
   msg.body.clear();
@@ -69,34 +70,36 @@ mcbp_parser::next(mcbp_message& msg) -> mcbp_parser::result
     reset();
     return result::failure;
   }
-  msg.body.insert(
-    msg.body.end(), buf.begin() + header_size, buf.begin() + header_size + prefix_size);
+  msg.body.insert(msg.body.end(), frame + header_size, frame + header_size + prefix_size);
 
   const bool is_compressed =
     protocol::has_flag(static_cast<std::byte>(msg.header.datatype), protocol::datatype::snappy);
   bool use_raw_value = true;
   if (is_compressed) {
-    std::string uncompressed;
-    const std::size_t offset = header_size + prefix_size;
-    if (snappy::Uncompress(reinterpret_cast<const char*>(buf.data() + offset),
-                           body_size - prefix_size,
-                           &uncompressed)) {
-      msg.body.insert(msg.body.end(),
-                      reinterpret_cast<std::byte*>(uncompressed.data()),
-                      reinterpret_cast<std::byte*>(uncompressed.data() + uncompressed.size()));
-      use_raw_value = false;
-      // patch header with new body size
-      msg.header.bodylen =
-        utils::byte_swap(static_cast<std::uint32_t>(prefix_size + uncompressed.size()));
+    const auto* compressed = reinterpret_cast<const char*>(frame + header_size + prefix_size);
+    const std::size_t compressed_size = body_size - prefix_size;
+    std::size_t uncompressed_size{ 0 };
+    if (snappy::GetUncompressedLength(compressed, compressed_size, &uncompressed_size)) {
+      // decompress directly into the body, right after the prefix
+      msg.body.resize(prefix_size + uncompressed_size);
+      if (snappy::RawUncompress(compressed,
+                                compressed_size,
+                                reinterpret_cast<char*>(msg.body.data() + prefix_size))) {
+        use_raw_value = false;
+        // patch header with new body size
+        msg.header.bodylen =
+          utils::byte_swap(static_cast<std::uint32_t>(prefix_size + uncompressed_size));
+      } else {
+        msg.body.resize(prefix_size);
+      }
     }
   }
   if (use_raw_value) {
-    msg.body.insert(msg.body.end(),
-                    buf.begin() + header_size + prefix_size,
-                    buf.begin() + header_size + body_size);
+    msg.body.insert(
+      msg.body.end(), frame + header_size + prefix_size, frame + header_size + body_size);
   }
-  buf.erase(buf.begin(), buf.begin() + header_size + body_size);
-  if (!buf.empty() && !protocol::is_valid_magic(std::to_integer<std::uint8_t>(buf[0]))) {
+  offset += header_size + body_size;
+  if (available() > 0 && !protocol::is_valid_magic(std::to_integer<std::uint8_t>(buf[offset]))) {
     CB_LOG_WARNING("parsed frame for magic={:x}, opcode={:x}, opaque={}, body_len={}. Invalid "
                    "magic of the next frame: {:x}, {} "
                    "bytes to parse{}",
@@ -104,9 +107,9 @@ mcbp_parser::next(mcbp_message& msg) -> mcbp_parser::result
                    msg.header.opcode,
                    msg.header.opaque,
                    body_size,
-                   buf[0],
-                   buf.size(),
-                   spdlog::to_hex(buf));
+                   buf[offset],
+                   available(),
+                   spdlog::to_hex(buf.begin() + static_cast<std::ptrdiff_t>(offset), buf.end()));
     reset();
   }
   return result::ok;
@@ -19,7 +19,9 @@
 
 #include "mcbp_message.hxx"
 
+#include <cstddef>
 #include <iterator>
+#include <vector>
 
 namespace couchbase::core::io
 {
@@ -33,17 +35,44 @@ struct mcbp_parser {
   template<typename Iterator>
   void feed(Iterator begin, Iterator end)
   {
-    buf.reserve(buf.size() + static_cast<std::size_t>(std::distance(begin, end)));
+    compact();
     buf.insert(buf.end(), begin, end);
   }
 
   void reset()
   {
     buf.clear();
+    offset = 0;
+  }
+
+  /**
+   * @return number of bytes that have been fed, but not consumed by next() yet
+   */
+  [[nodiscard]] auto available() const -> std::size_t
+  {
+    return buf.size() - offset;
   }
 
   auto next(mcbp_message& msg) -> result;
 
+  /**
+   * Frames are consumed by advancing the offset, and the consumed prefix is dropped only once per
+   * feed(), so that parsing N pipelined frames from a single read costs O(N) instead of O(N^2).
+   */
+  void compact()
+  {
+    if (offset == 0) {
+      return;
+    }
+    if (offset >= buf.size()) {
+      buf.clear();
+    } else {
+      buf.erase(buf.begin(), buf.begin() + static_cast<std::ptrdiff_t>(offset));
+    }
+    offset = 0;
+  }
+
   std::vector<std::byte> buf;
+  std::size_t offset{ 0 };
 };
 } // namespace couchbase::core::io
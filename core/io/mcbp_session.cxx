@@ -23,6 +23,7 @@
 #include "core/columnar/background_bootstrap_listener.hxx"
 #endif
 #include "configuration_belongs_to_session.hxx"
+#include "core/compression_policy.hxx"
 #include "core/config_listener.hxx"
 #include "core/diagnostics.hxx"
 #include "core/impl/bootstrap_error.hxx"
@@ -876,6 +877,7 @@ public:
     , ping_timeout_(ctx_)
     , origin_{ std::move(origin) }
     , bucket_name_{ std::move(bucket_name) }
+    , compression_{ origin_.options().compression_policy }
     , supported_features_{ std::move(known_features) }
     , is_tls_{ false }
     , state_listener_{ std::move(state_listener) }
@@ -906,6 +908,7 @@ public:
     , ping_timeout_(ctx_)
     , origin_(std::move(origin))
     , bucket_name_(std::move(bucket_name))
+    , compression_{ origin_.options().compression_policy }
     , supported_features_(std::move(known_features))
     , is_tls_{ true }
     , state_listener_{ std::move(state_listener) }
@@ -1398,7 +1401,27 @@ public:
       const std::scoped_lock lock(session_info_mutex_);
       stop_log_prefix = log_prefix_;
     }
-    CB_LOG_DEBUG("{} stop MCBP connection, reason={}", stop_log_prefix, reason);
+    {
+      const auto stats = write_stats();
+      const auto nmvb_stats = config_stats();
+      const auto snappy_stats = compression_.stats();
+      CB_LOG_DEBUG("{} stop MCBP connection, reason={}, writes={}, messages_written={}, "
+                   "max_write_batch={}, nmvb_configs_parsed={}, nmvb_configs_skipped={}, "
+                   "compression_attempts={}, compressed_values={}, compression_skipped={}, "
+                   "compression_bytes_saved={}, compression_time={}",
+                   stop_log_prefix,
+                   reason,
+                   stats.number_of_writes,
+                   stats.number_of_messages,
+                   stats.max_batch_size,
+                   nmvb_stats.number_of_parsed_configs,
+                   nmvb_stats.number_of_skipped_configs,
+                   snappy_stats.number_of_attempts,
+                   snappy_stats.number_of_compressed_values,
+                   snappy_stats.number_of_skipped_values,
+                   snappy_stats.bytes_saved,
+                   snappy_stats.time_spent);
+    }
     stopped_ = true;
     // Dispatch timer cancellation and stream close through the strand to avoid
     // racing with on_connect() and bootstrap_handler which run on the IO thread.
@@ -1438,6 +1461,7 @@ public:
         }
       }
       command_handlers_.clear();
+      handlers_in_flight_ = 0;
     }
     {
       const std::scoped_lock lock(operations_mutex_);
@@ -1454,6 +1478,7 @@ public:
         }
       }
       operations_.clear();
+      operations_in_flight_ = 0;
     }
     {
       const std::scoped_lock lock(session_info_mutex_);
@@ -1471,11 +1496,17 @@ public:
   }
 
   void write(std::vector<std::byte>&& buf)
+  {
+    write(mcbp_output_buffer{ std::move(buf) });
+  }
+
+  void write(mcbp_output_buffer&& buf)
   {
     if (stopped_) {
       return;
     }
-    CB_LOG_TRACE("{} MCBP send {}", log_prefix_, mcbp_header_view(buf));
+    CB_LOG_TRACE("{} MCBP send {}", log_prefix_, mcbp_header_view(buf.head));
+    pending_write_bytes_ += buf.size();
     const std::scoped_lock lock(output_buffer_mutex_);
     output_buffer_.emplace_back(std::move(buf));
   }
@@ -1485,12 +1516,22 @@ public:
     if (stopped_) {
       return;
     }
+    // Coalesce flushes: while a do_write() is already scheduled, it will pick up everything that
+    // has been written to the output buffer so far, so only the first flush of the batch posts.
+    if (write_scheduled_.exchange(true)) {
+      return;
+    }
     asio::post(asio::bind_executor(ctx_, [self = shared_from_this()]() {
       self->do_write();
     }));
   }
 
   void write_and_flush(std::vector<std::byte>&& buf)
+  {
+    write_and_flush(mcbp_output_buffer{ std::move(buf) });
+  }
+
+  void write_and_flush(mcbp_output_buffer&& buf)
   {
     if (stopped_) {
       return;
@@ -1504,6 +1545,7 @@ public:
     const std::scoped_lock lock(operations_mutex_);
     if (auto iter = operations_.find(request->opaque_); iter != operations_.end()) {
       operations_.erase(iter);
+      operations_in_flight_ = operations_.size();
     }
   }
 
@@ -1514,6 +1556,7 @@ public:
     const std::scoped_lock lock(operations_mutex_);
     request->waiting_in_ = this;
     operations_.try_emplace(opaque, request, handler);
+    operations_in_flight_ = operations_.size();
   }
 
   auto handle_request(protocol::client_opcode opcode,
@@ -1529,6 +1572,7 @@ public:
           handler != command_handlers_.end() && handler->second) {
         fun = std::move(handler->second);
         command_handlers_.erase(handler);
+        handlers_in_flight_ = command_handlers_.size();
       }
     }
 
@@ -1553,6 +1597,7 @@ public:
         handler = pair->second.second;
         if (!request->persistent_) {
           operations_.erase(pair);
+          operations_in_flight_ = operations_.size();
         }
       }
     }
@@ -1601,13 +1646,13 @@ public:
       if (bootstrapped_ && stream_->is_open()) {
         write_and_flush(std::move(data.value()));
       } else {
-        pending_buffer_.emplace_back(data.value());
+        pending_buffer_.emplace_back(std::move(data.value()));
       }
     }
   }
 
   void write_and_subscribe(std::uint32_t opaque,
-                           std::vector<std::byte>&& data,
+                           mcbp_output_buffer&& data,
                            command_handler&& handler)
   {
     if (stopped_) {
@@ -1620,6 +1665,7 @@ public:
     {
       const std::scoped_lock lock(command_handlers_mutex_);
       command_handlers_.try_emplace(opaque, std::move(handler));
+      handlers_in_flight_ = command_handlers_.size();
     }
     if (bootstrapped_ && stream_->is_open()) {
       write_and_flush(std::move(data));
@@ -1631,7 +1677,7 @@ public:
       if (bootstrapped_ && stream_->is_open()) {
         write_and_flush(std::move(data));
       } else {
-        pending_buffer_.emplace_back(data);
+        pending_buffer_.emplace_back(std::move(data));
       }
     }
   }
@@ -1651,6 +1697,7 @@ public:
       if (handler->second) {
         auto fun = std::move(handler->second);
         command_handlers_.erase(handler);
+        handlers_in_flight_ = command_handlers_.size();
         command_handlers_mutex_.unlock();
         fun(ec, reason, {}, {});
         return true;
@@ -1667,6 +1714,24 @@ public:
            supported_features_.end();
   }
 
+  /**
+   * @return the policy to compress the values of the collection, or nullptr if the values must be
+   * sent uncompressed.
+   */
+  [[nodiscard]] auto compression_policy_for(const document_id& id) -> compression_policy*
+  {
+    if (!origin_.options().enable_compression ||
+        !supports_feature(protocol::hello_feature::snappy) || !compression_.enabled_for(id)) {
+      return nullptr;
+    }
+    return &compression_;
+  }
+
+  [[nodiscard]] auto compression_stats() const -> core::compression_stats
+  {
+    return compression_.stats();
+  }
+
   [[nodiscard]] auto supported_features() const -> std::vector<protocol::hello_feature>
   {
     const std::scoped_lock lock(session_info_mutex_);
@@ -1688,6 +1753,30 @@ public:
     return configured_;
   }
 
+  [[nodiscard]] auto write_stats() const -> mcbp_session_write_stats
+  {
+    const std::scoped_lock lock(writing_buffer_mutex_);
+    return write_stats_;
+  }
+
+  [[nodiscard]] auto config_stats() const -> mcbp_session_config_stats
+  {
+    return {
+      parsed_nmvb_configs_.load(),
+      skipped_nmvb_configs_.load(),
+    };
+  }
+
+  [[nodiscard]] auto queue_depth() const -> std::size_t
+  {
+    return handlers_in_flight_.load() + operations_in_flight_.load();
+  }
+
+  [[nodiscard]] auto pending_write_bytes() const -> std::size_t
+  {
+    return pending_write_bytes_.load();
+  }
+
   [[nodiscard]] auto config() -> topology::configuration
   {
     const std::scoped_lock lock(config_mutex_);
@@ -1867,8 +1956,27 @@ public:
             bootstrap_port_number_,
             config_text);
         }
+        // During rebalance many in-flight operations receive the same configuration, so look at
+        // the revision first, and only parse the payload when it is newer than the one we have.
+        if (auto revision = protocol::peek_config_revision(config_text);
+            revision && !is_newer_nmvb_config(revision.value())) {
+          ++skipped_nmvb_configs_;
+          CB_LOG_TRACE("{} received not_my_vbucket status for {}, opaque={} with config "
+                       "rev={}:{} in the payload, which is not newer than known, skipping",
+                       log_prefix_,
+                       protocol::client_opcode(msg.header.opcode),
+                       utils::byte_swap(msg.header.opaque),
+                       revision->epoch.value_or(0),
+                       revision->rev.value_or(0));
+          return;
+        }
         auto config =
           protocol::parse_config(config_text, bootstrap_hostname_, bootstrap_port_number_);
+        ++parsed_nmvb_configs_;
+        {
+          const std::scoped_lock lock(config_mutex_);
+          last_parsed_nmvb_config_revision_ = protocol::config_revision{ config.epoch, config.rev };
+        }
         CB_LOG_DEBUG(
           "{} received not_my_vbucket status for {}, opaque={} with config rev={} in the payload",
           log_prefix_,
@@ -1880,6 +1988,18 @@ public:
     }
   }
 
+  [[nodiscard]] auto is_newer_nmvb_config(const protocol::config_revision& revision) const -> bool
+  {
+    const std::scoped_lock lock(config_mutex_);
+    if (last_parsed_nmvb_config_revision_ && revision <= last_parsed_nmvb_config_revision_.value()) {
+      return false;
+    }
+    if (config_ && revision <= protocol::config_revision{ config_->epoch, config_->rev }) {
+      return false;
+    }
+    return true;
+  }
+
   auto get_collection_uid(const std::string& collection_path) -> std::optional<std::uint32_t>
   {
     return collection_cache_.get(collection_path);
@@ -2229,6 +2349,7 @@ private:
 
   void do_write()
   {
+    write_scheduled_ = false;
     if (stopped_ || !stream_->is_open()) {
       return;
     }
@@ -2236,20 +2357,31 @@ private:
     if (!writing_buffer_.empty() || output_buffer_.empty()) {
       return;
     }
+    // both vectors keep their capacity between the writes, so that steady state does not allocate
     std::swap(writing_buffer_, output_buffer_);
-    std::vector<asio::const_buffer> buffers;
-    buffers.reserve(writing_buffer_.size());
+    write_gather_buffers_.clear();
+    writing_bytes_ = 0;
     for (auto& buf : writing_buffer_) {
-      CB_LOG_PROTOCOL("[MCBP, OUT] host=\"{}\", sport={}, dport={}, buffer_size={}{:a}",
+      writing_bytes_ += buf.size();
+      CB_LOG_PROTOCOL("[MCBP, OUT] host=\"{}\", sport={}, dport={}, buffer_size={}{:a}{:a}",
                       connection_endpoints_.remote_address,
                       connection_endpoints_.local.port(),
                       connection_endpoints_.remote.port(),
                       buf.size(),
-                      spdlog::to_hex(buf));
-      buffers.emplace_back(asio::buffer(buf));
+                      spdlog::to_hex(buf.head),
+                      spdlog::to_hex(buf.value));
+      write_gather_buffers_.emplace_back(asio::buffer(buf.head));
+      if (!buf.value.empty()) {
+        // the value is sent from the memory of the request, see client_request::gathered_data()
+        write_gather_buffers_.emplace_back(asio::buffer(buf.value.data(), buf.value.size()));
+      }
     }
+    ++write_stats_.number_of_writes;
+    write_stats_.number_of_messages += writing_buffer_.size();
+    write_stats_.max_batch_size = std::max(write_stats_.max_batch_size, writing_buffer_.size());
     stream_->async_write(
-      buffers, [self = shared_from_this()](std::error_code ec, std::size_t bytes_transferred) {
+      write_gather_buffers_,
+      [self = shared_from_this()](std::error_code ec, std::size_t bytes_transferred) {
         CB_LOG_PROTOCOL("[MCBP, OUT] host=\"{}\", sport={}, dport={}, rc={}, bytes_sent={}",
                         self->connection_endpoints_.remote_address,
                         self->connection_endpoints_.local.port(),
@@ -2272,6 +2404,8 @@ private:
         {
           const std::scoped_lock inner_lock(self->writing_buffer_mutex_);
           self->writing_buffer_.clear();
+          self->pending_write_bytes_ -= self->writing_bytes_;
+          self->writing_bytes_ = 0;
         }
         asio::post(asio::bind_executor(self->ctx_, [self]() {
           self->do_write();
@@ -2294,14 +2428,18 @@ private:
   asio::steady_timer ping_timeout_;
   couchbase::core::origin origin_;
   std::optional<std::string> bucket_name_;
+  compression_policy compression_;
   mcbp_parser parser_;
   std::shared_ptr<bootstrap_handler> bootstrap_handler_{ nullptr };
   std::optional<impl::bootstrap_error> last_bootstrap_error_;
   std::shared_ptr<message_handler> handler_{ nullptr };
   utils::movable_function<void(std::error_code, const topology::configuration&)>
     bootstrap_callback_{};
-  std::mutex command_handlers_mutex_{};
+  mutable std::mutex command_handlers_mutex_{};
   std::map<std::uint32_t, command_handler> command_handlers_{};
+  // sizes of command_handlers_ and operations_, published to the session selection without locks
+  std::atomic_size_t handlers_in_flight_{ 0 };
+  std::atomic_size_t operations_in_flight_{ 0 };
   std::vector<std::shared_ptr<config_listener>> config_listeners_{};
   utils::movable_function<void()> on_stop_handler_{};
 
@@ -2316,12 +2454,18 @@ private:
   std::atomic<std::uint32_t> opaque_{ 0 };
 
   std::array<std::byte, 16384> input_buffer_{};
-  std::vector<std::vector<std::byte>> output_buffer_{};
-  std::vector<std::vector<std::byte>> pending_buffer_{};
-  std::vector<std::vector<std::byte>> writing_buffer_{};
+  std::vector<mcbp_output_buffer> output_buffer_{};
+  std::vector<mcbp_output_buffer> pending_buffer_{};
+  std::vector<mcbp_output_buffer> writing_buffer_{};
+  // bytes in output_buffer_ and writing_buffer_, that have not been written to the socket yet
+  std::atomic_size_t pending_write_bytes_{ 0 };
+  std::size_t writing_bytes_{ 0 };
+  std::vector<asio::const_buffer> write_gather_buffers_{};
+  std::atomic_bool write_scheduled_{ false };
+  mcbp_session_write_stats write_stats_{};
   std::mutex output_buffer_mutex_{};
   std::mutex pending_buffer_mutex_{};
-  std::mutex writing_buffer_mutex_{};
+  mutable std::mutex writing_buffer_mutex_{};
   std::string bootstrap_hostname_{};
   std::string bootstrap_port_{};
   std::string bootstrap_address_{};
@@ -2331,7 +2475,10 @@ private:
   mutable std::mutex session_info_mutex_{};
   std::vector<protocol::hello_feature> supported_features_;
   std::optional<topology::configuration> config_;
+  std::optional<protocol::config_revision> last_parsed_nmvb_config_revision_{};
   mutable std::mutex config_mutex_{};
+  std::atomic<std::uint64_t> parsed_nmvb_configs_{ 0 };
+  std::atomic<std::uint64_t> skipped_nmvb_configs_{ 0 };
   std::atomic_bool configured_{ false };
   std::optional<error_map> error_map_;
   collection_cache collection_cache_;
@@ -2344,7 +2491,7 @@ private:
   std::shared_ptr<impl::bootstrap_state_listener> state_listener_{ nullptr };
 
   mcbp::codec codec_;
-  std::recursive_mutex operations_mutex_{};
+  mutable std::recursive_mutex operations_mutex_{};
   std::map<std::uint32_t,
            std::pair<std::shared_ptr<mcbp::queue_request>, std::shared_ptr<response_handler>>>
     operations_{};
@@ -2538,6 +2685,15 @@ void
 mcbp_session::write_and_subscribe(std::uint32_t opaque,
                                   std::vector<std::byte>&& data,
                                   command_handler&& handler)
+{
+  return impl_->write_and_subscribe(
+    opaque, mcbp_output_buffer{ std::move(data) }, std::move(handler));
+}
+
+void
+mcbp_session::write_and_subscribe(std::uint32_t opaque,
+                                  mcbp_output_buffer&& data,
+                                  command_handler&& handler)
 {
   return impl_->write_and_subscribe(opaque, std::move(data), std::move(handler));
 }
@@ -2592,6 +2748,42 @@ mcbp_session::has_config() const -> bool
   return impl_->has_config();
 }
 
+auto
+mcbp_session::queue_depth() const -> std::size_t
+{
+  return impl_->queue_depth();
+}
+
+auto
+mcbp_session::pending_write_bytes() const -> std::size_t
+{
+  return impl_->pending_write_bytes();
+}
+
+auto
+mcbp_session::write_stats() const -> mcbp_session_write_stats
+{
+  return impl_->write_stats();
+}
+
+auto
+mcbp_session::compression_policy_for(const document_id& id) -> compression_policy*
+{
+  return impl_->compression_policy_for(id);
+}
+
+auto
+mcbp_session::compression_stats() const -> core::compression_stats
+{
+  return impl_->compression_stats();
+}
+
+auto
+mcbp_session::config_stats() const -> mcbp_session_config_stats
+{
+  return impl_->config_stats();
+}
+
 auto
 mcbp_session::diag_info() const -> diag::endpoint_diag_info
 {
@@ -20,12 +20,14 @@
 #include <couchbase/build_config.hxx>
 
 #include "core/cluster_credentials.hxx"
+#include "core/compression_policy.hxx"
 #include "core/protocol/hello_feature.hxx"
 #include "core/response_handler.hxx"
 #include "core/tls_context_provider.hxx"
 #include "core/utils/movable_function.hxx"
 #include "mcbp_context.hxx"
 #include "mcbp_message.hxx"
+#include "mcbp_output_buffer.hxx"
 
 #include <chrono>
 #include <cinttypes>
@@ -83,6 +85,24 @@ namespace io
 {
 class mcbp_session_impl;
 
+/**
+ * Counters of the socket writes, used to observe how well the outgoing messages are batched.
+ */
+struct mcbp_session_write_stats {
+  std::uint64_t number_of_writes{ 0 };
+  std::uint64_t number_of_messages{ 0 };
+  std::size_t max_batch_size{ 0 };
+};
+
+/**
+ * Counters of the configurations carried by not_my_vbucket responses: how many of them were fully
+ * parsed, and how many were skipped because their revision was not newer than the known one.
+ */
+struct mcbp_session_config_stats {
+  std::uint64_t number_of_parsed_configs{ 0 };
+  std::uint64_t number_of_skipped_configs{ 0 };
+};
+
 using command_handler = utils::movable_function<
   void(std::error_code, retry_reason, io::mcbp_message&&, std::optional<key_value_error_map_info>)>;
 
@@ -154,6 +174,9 @@ public:
   void write_and_subscribe(std::uint32_t opaque,
                            std::vector<std::byte>&& data,
                            command_handler&& handler);
+  void write_and_subscribe(std::uint32_t opaque,
+                           mcbp_output_buffer&& data,
+                           command_handler&& handler);
   void bootstrap(utils::movable_function<void(std::error_code, topology::configuration)>&& handler,
                  bool retry_on_bucket_not_found = false);
   void reauthenticate();
@@ -162,6 +185,25 @@ public:
   void stop(retry_reason reason);
   [[nodiscard]] auto index() const -> std::size_t;
   [[nodiscard]] auto has_config() const -> bool;
+  /**
+   * Number of operations, that have been written to the session, but still waiting for response.
+   *
+   * Used as a load estimate when selecting session from the pool of connections to the same node.
+   * Does not take locks.
+   */
+  [[nodiscard]] auto queue_depth() const -> std::size_t;
+  /**
+   * Number of bytes, that have been written to the session, but not yet sent to the socket.
+   */
+  [[nodiscard]] auto pending_write_bytes() const -> std::size_t;
+  [[nodiscard]] auto write_stats() const -> mcbp_session_write_stats;
+  [[nodiscard]] auto config_stats() const -> mcbp_session_config_stats;
+  [[nodiscard]] auto compression_stats() const -> core::compression_stats;
+  /**
+   * @return the policy to compress the values of the document's collection, or nullptr if the
+   * values must be sent uncompressed (e.g. snappy has not been negotiated for the connection).
+   */
+  [[nodiscard]] auto compression_policy_for(const document_id& id) -> compression_policy*;
   [[nodiscard]] auto config() const -> std::optional<topology::configuration>;
   [[nodiscard]] auto diag_info() const -> diag::endpoint_diag_info;
   void on_configuration_update(std::shared_ptr<config_listener> handler);
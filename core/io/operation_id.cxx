@@ -0,0 +1,49 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2025-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+#include "operation_id.hxx"
+
+#include "core/platform/uuid.h"
+#include "operation_id_fmt.hxx"
+
+#include <atomic>
+
+namespace couchbase::core::io
+{
+namespace
+{
+std::atomic<std::uint64_t> next_sequence{ 0 };
+} // namespace
+
+operation_id::operation_id(std::uint8_t opcode)
+  : sequence_{ next_sequence.fetch_add(1, std::memory_order_relaxed) }
+  , opcode_{ opcode }
+{
+}
+
+auto
+operation_id::to_string() const -> std::string
+{
+  return fmt::format("{}", *this);
+}
+
+auto
+operation_id::prefix() -> const std::string&
+{
+  static const std::string prefix{ uuid::to_string(uuid::random()).substr(0, 8) };
+  return prefix;
+}
+} // namespace couchbase::core::io
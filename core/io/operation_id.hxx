@@ -0,0 +1,53 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2025-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace couchbase::core::io
+{
+/**
+ * Identifier of the KV operation, used only in logs.
+ *
+ * The identifier consists of the opcode, the prefix (random, generated once per process) and the
+ * sequence number. It is cheap to construct, and rendered into string only when needed.
+ */
+class operation_id
+{
+public:
+  explicit operation_id(std::uint8_t opcode);
+
+  [[nodiscard]] auto opcode() const -> std::uint8_t
+  {
+    return opcode_;
+  }
+
+  [[nodiscard]] auto sequence() const -> std::uint64_t
+  {
+    return sequence_;
+  }
+
+  [[nodiscard]] auto to_string() const -> std::string;
+
+  [[nodiscard]] static auto prefix() -> const std::string&;
+
+private:
+  std::uint64_t sequence_;
+  std::uint8_t opcode_;
+};
+} // namespace couchbase::core::io
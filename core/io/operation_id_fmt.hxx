@@ -0,0 +1,40 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2025-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+#pragma once
+
+#include "operation_id.hxx"
+
+#include <spdlog/fmt/bundled/core.h>
+
+template<>
+struct fmt::formatter<couchbase::core::io::operation_id> {
+  template<typename ParseContext>
+  constexpr auto parse(ParseContext& ctx)
+  {
+    return ctx.begin();
+  }
+
+  template<typename FormatContext>
+  auto format(const couchbase::core::io::operation_id& id, FormatContext& ctx) const
+  {
+    return format_to(ctx.out(),
+                     "{:02x}/{}-{:x}",
+                     id.opcode(),
+                     couchbase::core::io::operation_id::prefix(),
+                     id.sequence());
+  }
+};
@@ -0,0 +1,189 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2025-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "query_cache.hxx"
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+namespace couchbase::core
+{
+query_cache::query_cache(std::size_t capacity)
+{
+  set_capacity(capacity);
+}
+
+auto
+query_cache::shard_capacity_for(std::size_t capacity) -> std::size_t
+{
+  if (capacity == 0) {
+    return 0;
+  }
+  // unless the cache is disabled, every shard keeps at least one statement, otherwise the PREPARE
+  // response for legacy servers (that only return encoded plan) could never be used on retry
+  return std::max<std::size_t>(1, (capacity + number_of_shards - 1) / number_of_shards);
+}
+
+void
+query_cache::set_capacity(std::size_t capacity)
+{
+  const auto shard_capacity = shard_capacity_for(capacity);
+  capacity_ = capacity;
+  if (shard_capacity_.exchange(shard_capacity) <= shard_capacity) {
+    return;
+  }
+  std::uint64_t number_of_evictions = 0;
+  for (auto& s : shards_) {
+    const std::scoped_lock lock(s.mutex);
+    number_of_evictions += evict_overflow(s, shard_capacity);
+  }
+  record_evictions(number_of_evictions);
+}
+
+auto
+query_cache::capacity() const -> std::size_t
+{
+  return capacity_;
+}
+
+auto
+query_cache::enabled() const -> bool
+{
+  return shard_capacity_ > 0;
+}
+
+auto
+query_cache::shard_for(std::size_t hash) -> shard&
+{
+  return shards_[hash % number_of_shards];
+}
+
+auto
+query_cache::evict_overflow(shard& s, std::size_t shard_capacity) -> std::uint64_t
+{
+  std::uint64_t number_of_evictions = 0;
+  while (s.lru.size() > shard_capacity) {
+    s.index.erase(s.lru.back().hash);
+    s.lru.pop_back();
+    ++number_of_evictions;
+  }
+  return number_of_evictions;
+}
+
+void
+query_cache::record_evictions(std::uint64_t number_of_evictions)
+{
+  if (number_of_evictions == 0) {
+    return;
+  }
+  evictions_ += number_of_evictions;
+}
+
+void
+query_cache::erase(const std::string& statement)
+{
+  const auto hash = std::hash<std::string>{}(statement);
+  auto& s = shard_for(hash);
+  const std::scoped_lock lock(s.mutex);
+  auto it = s.index.find(hash);
+  if (it == s.index.end() || it->second->statement != statement) {
+    return;
+  }
+  s.lru.erase(it->second);
+  s.index.erase(it);
+}
+
+void
+query_cache::emplace(const std::string& statement, entry value)
+{
+  if (!enabled()) {
+    return;
+  }
+  const auto hash = std::hash<std::string>{}(statement);
+  auto& s = shard_for(hash);
+  std::uint64_t number_of_evictions = 0;
+  {
+    const std::scoped_lock lock(s.mutex);
+    if (auto it = s.index.find(hash); it != s.index.end()) {
+      if (it->second->statement == statement) {
+        // keep the entry stored by the PREPARE, that completed first
+        s.lru.splice(s.lru.begin(), s.lru, it->second);
+        return;
+      }
+      // hash collision with a different statement, the newer one wins
+      s.lru.erase(it->second);
+      s.index.erase(it);
+    }
+    s.lru.push_front(node{ hash, statement, std::move(value) });
+    s.index.emplace(hash, s.lru.begin());
+    number_of_evictions = evict_overflow(s, shard_capacity_);
+  }
+  record_evictions(number_of_evictions);
+}
+
+void
+query_cache::put(const std::string& statement, const std::string& prepared)
+{
+  emplace(statement, entry{ prepared });
+}
+
+void
+query_cache::put(const std::string& statement,
+                 const std::string& name,
+                 const std::string& encoded_plan)
+{
+  emplace(statement, entry{ name, encoded_plan });
+}
+
+auto
+query_cache::get(const std::string& statement) -> std::optional<entry>
+{
+  const auto hash = std::hash<std::string>{}(statement);
+  auto& s = shard_for(hash);
+  std::optional<entry> result{};
+  {
+    const std::scoped_lock lock(s.mutex);
+    if (auto it = s.index.find(hash); it != s.index.end() && it->second->statement == statement) {
+      s.lru.splice(s.lru.begin(), s.lru, it->second);
+      result = it->second->value;
+    }
+  }
+  if (result) {
+    ++hits_;
+  } else {
+    ++misses_;
+  }
+  return result;
+}
+
+auto
+query_cache::stats() const -> query_cache_stats
+{
+  std::size_t size = 0;
+  for (const auto& s : shards_) {
+    const std::scoped_lock lock(s.mutex);
+    size += s.lru.size();
+  }
+  return {
+    hits_.load(),
+    misses_.load(),
+    evictions_.load(),
+    size,
+  };
+}
+} // namespace couchbase::core
@@ -17,55 +17,90 @@
 
 #pragma once
 
-#include <map>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <list>
 #include <mutex>
 #include <optional>
 #include <string>
+#include <unordered_map>
 
 namespace couchbase::core
 {
+struct query_cache_stats {
+  std::uint64_t hits{ 0 };
+  std::uint64_t misses{ 0 };
+  std::uint64_t evictions{ 0 };
+  std::size_t size{ 0 };
+};
+
+/**
+ * Bounded cache of prepared statements, keyed by hash of the statement text.
+ *
+ * The cache is split into shards with their own lock and LRU list, so that concurrent queries
+ * do not contend on a single mutex. When the shard is full, the least recently used statement
+ * is evicted. Zero capacity disables the cache.
+ */
 class query_cache
 {
 public:
+  static constexpr std::size_t default_capacity{ 5000 };
+
   struct entry {
     std::string name;
     std::optional<std::string> plan{};
   };
 
-  void erase(const std::string& statement)
-  {
-    std::scoped_lock lock(store_mutex_);
-    auto it = store_.find(statement);
-    if (it == store_.end()) {
-      return;
-    }
-    store_.erase(it);
-  }
+  query_cache() = default;
+  explicit query_cache(std::size_t capacity);
+
+  /**
+   * Updates maximum number of statements, that might be stored in the cache. Shrinking the cache
+   * evicts least recently used entries, and zero capacity drops all of them.
+   */
+  void set_capacity(std::size_t capacity);
+  [[nodiscard]] auto capacity() const -> std::size_t;
 
-  void put(const std::string& statement, const std::string& prepared)
-  {
-    std::scoped_lock lock(store_mutex_);
-    store_.try_emplace(statement, entry{ prepared });
-  }
+  /**
+   * @return false if the capacity is zero, and nothing is ever stored in the cache.
+   */
+  [[nodiscard]] auto enabled() const -> bool;
 
-  void put(const std::string& statement, const std::string& name, const std::string& encoded_plan)
-  {
-    std::scoped_lock lock(store_mutex_);
-    store_.try_emplace(statement, entry{ name, encoded_plan });
-  }
+  void erase(const std::string& statement);
+  void put(const std::string& statement, const std::string& prepared);
+  void put(const std::string& statement, const std::string& name, const std::string& encoded_plan);
+  auto get(const std::string& statement) -> std::optional<entry>;
 
-  auto get(const std::string& statement) -> std::optional<entry>
-  {
-    std::scoped_lock lock(store_mutex_);
-    auto it = store_.find(statement);
-    if (it == store_.end()) {
-      return {};
-    }
-    return it->second;
-  }
+  [[nodiscard]] auto stats() const -> query_cache_stats;
 
 private:
-  std::map<std::string, entry> store_;
-  std::mutex store_mutex_{};
+  static constexpr std::size_t number_of_shards{ 16 };
+
+  struct node {
+    std::size_t hash;
+    std::string statement;
+    entry value;
+  };
+
+  struct shard {
+    // most recently used entries are in the front
+    std::list<node> lru{};
+    std::unordered_map<std::size_t, std::list<node>::iterator> index{};
+    mutable std::mutex mutex{};
+  };
+
+  static auto shard_capacity_for(std::size_t capacity) -> std::size_t;
+  auto shard_for(std::size_t hash) -> shard&;
+  void emplace(const std::string& statement, entry value);
+  static auto evict_overflow(shard& s, std::size_t shard_capacity) -> std::uint64_t;
+  void record_evictions(std::uint64_t number_of_evictions);
+
+  std::array<shard, number_of_shards> shards_{};
+  std::atomic<std::size_t> capacity_{ default_capacity };
+  std::atomic<std::size_t> shard_capacity_{ shard_capacity_for(default_capacity) };
+  std::atomic<std::uint64_t> hits_{ 0 };
+  std::atomic<std::uint64_t> misses_{ 0 };
+  std::atomic<std::uint64_t> evictions_{ 0 };
 };
 } // namespace couchbase::core
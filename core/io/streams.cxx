@@ -227,12 +227,22 @@ tls_stream_impl::close(utils::movable_function<void(std::error_code)>&& handler)
   if (!stream_) {
     return handler(asio::error::bad_descriptor);
   }
-  return asio::post(strand_, [stream = std::move(stream_), handler = std::move(handler)]() {
-    asio::error_code ec{};
-    stream->lowest_layer().shutdown(asio::socket_base::shutdown_both, ec);
-    stream->lowest_layer().close(ec);
-    handler(ec);
-  });
+  return asio::post(
+    strand_,
+    [stream = std::move(stream_), sessions = tls_.session_cache(), handler = std::move(handler)]() {
+      // The socket is closed without sending close_notify, as it always was. If the session of the
+      // connection is the cached one, the SSL library would treat it as broken and refuse to
+      // resume it, so only for those connections mark the shutdown as done.
+      if (SSL_is_init_finished(stream->native_handle()) == 1 &&
+          sessions->holds_session_of(stream->native_handle())) {
+        SSL_set_quiet_shutdown(stream->native_handle(), 1);
+        SSL_shutdown(stream->native_handle());
+      }
+      asio::error_code ec{};
+      stream->lowest_layer().shutdown(asio::socket_base::shutdown_both, ec);
+      stream->lowest_layer().close(ec);
+      handler(ec);
+    });
 }
 
 void
@@ -260,8 +270,11 @@ tls_stream_impl::async_connect(const asio::ip::tcp::resolver::results_type::endp
     endpoint,
     // hostname is copied into the closure (owning std::string) so the async
     // handler does not depend on the caller's argument lifetime.
-    [stream = stream_, hostname = hostname, handler = std::move(handler)](
-      std::error_code ec_connect) mutable {
+    [stream = stream_,
+     hostname = hostname,
+     port = endpoint.port(),
+     sessions = tls_.session_cache(),
+     handler = std::move(handler)](std::error_code ec_connect) mutable {
       if (ec_connect == asio::error::operation_aborted) {
         return;
       }
@@ -274,12 +287,16 @@ tls_stream_impl::async_connect(const asio::ip::tcp::resolver::results_type::endp
       if (auto ec_identity = configure_tls_handshake(*stream, hostname); ec_identity) {
         return handler(ec_identity);
       }
+      // Offer the session of the previous connection to the same node, so that the handshake
+      // can be abbreviated.
+      sessions->prepare(stream->native_handle(), hostname + ":" + std::to_string(port));
       stream->async_handshake(
         asio::ssl::stream_base::client,
-        [stream, handler = std::move(handler)](std::error_code ec_handshake) mutable {
+        [stream, sessions, handler = std::move(handler)](std::error_code ec_handshake) mutable {
           if (ec_handshake == asio::error::operation_aborted) {
             return;
           }
+          sessions->handshake_completed(stream->native_handle(), ec_handshake);
           return handler(ec_handshake);
         });
     });
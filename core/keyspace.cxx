@@ -0,0 +1,46 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2025-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "keyspace.hxx"
+
+#include <spdlog/fmt/bundled/core.h>
+
+#include <utility>
+
+namespace couchbase::core
+{
+keyspace::keyspace(std::string bucket)
+  : bucket_{ std::move(bucket) }
+{
+}
+
+keyspace::keyspace(std::string bucket, std::string scope, std::string collection)
+  : bucket_{ std::move(bucket) }
+  , scope_{ std::move(scope) }
+  , collection_{ std::move(collection) }
+  , path_{ fmt::format("{}.{}", scope_, collection_) }
+{
+}
+
+auto
+make_keyspace(std::string bucket, std::string scope, std::string collection)
+  -> std::shared_ptr<const keyspace>
+{
+  return std::make_shared<const keyspace>(
+    std::move(bucket), std::move(scope), std::move(collection));
+}
+} // namespace couchbase::core
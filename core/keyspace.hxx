@@ -0,0 +1,113 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2025-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+
+namespace couchbase::core
+{
+/**
+ * Immutable bucket/scope/collection triple, that is shared by all document IDs of the same
+ * collection instead of copying the names for every operation.
+ *
+ * The keyspace also remembers the collection UID resolved by any session, so that the operations
+ * do not have to look it up by the collection path.
+ */
+class keyspace
+{
+public:
+  keyspace() = default;
+  explicit keyspace(std::string bucket);
+  keyspace(std::string bucket, std::string scope, std::string collection);
+
+  keyspace(const keyspace&) = delete;
+  keyspace(keyspace&&) = delete;
+  auto operator=(const keyspace&) -> keyspace& = delete;
+  auto operator=(keyspace&&) -> keyspace& = delete;
+  ~keyspace() = default;
+
+  [[nodiscard]] auto bucket() const -> const std::string&
+  {
+    return bucket_;
+  }
+
+  [[nodiscard]] auto scope() const -> const std::string&
+  {
+    return scope_;
+  }
+
+  [[nodiscard]] auto collection() const -> const std::string&
+  {
+    return collection_;
+  }
+
+  /**
+   * @return "scope.collection", or empty string if the keyspace has been created without
+   * collection
+   */
+  [[nodiscard]] auto path() const -> const std::string&
+  {
+    return path_;
+  }
+
+  [[nodiscard]] auto is_default_collection() const -> bool
+  {
+    return path_ == "_default._default";
+  }
+
+  /**
+   * @return the collection UID if it has been resolved by any session
+   */
+  [[nodiscard]] auto collection_uid() const -> std::optional<std::uint32_t>
+  {
+    const auto resolved = resolved_.load(std::memory_order_acquire);
+    if ((resolved & resolved_flag) == 0) {
+      return {};
+    }
+    return static_cast<std::uint32_t>(resolved);
+  }
+
+  /**
+   * Remembers the UID of the collection, or replaces it if the collection has been recreated.
+   */
+  void collection_uid(std::uint32_t uid) const
+  {
+    resolved_.store(resolved_flag | uid, std::memory_order_release);
+  }
+
+private:
+  std::string bucket_{};
+  std::string scope_{};
+  std::string collection_{};
+  std::string path_{};
+
+  static constexpr std::uint64_t resolved_flag{ 1ULL << 32U };
+
+  // the UID in the lower 32 bits, and resolved_flag once it is known
+  mutable std::atomic_uint64_t resolved_{ 0 };
+};
+
+[[nodiscard]] auto
+make_keyspace(std::string bucket, std::string scope, std::string collection)
+  -> std::shared_ptr<const keyspace>;
+} // namespace couchbase::core
@@ -27,120 +27,206 @@
 
 #include <gsl/assert>
 #include <hdr/hdr_histogram.h>
+#include <spdlog/fmt/bundled/format.h>
 #include <tao/json/value.hpp>
 
+#include <array>
+#include <atomic>
+#include <limits>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
 #include <utility>
+#include <vector>
 
 namespace couchbase::core::metrics
 {
-class logging_value_recorder : public couchbase::metrics::value_recorder
+namespace
 {
-private:
-  std::string name_;
-  std::map<std::string, std::string> tags_;
-  hdr_histogram* histogram_{ nullptr };
+constexpr std::int64_t histogram_lowest_value{ 1 };                 // 1 ns
+constexpr std::int64_t histogram_highest_value{ 30'000'000'000LL }; // 30 s
+constexpr int histogram_significant_figures{ 3 };
 
-  void initialize_histogram()
-  {
-    histogram_ = nullptr;
-    hdr_init(/* minimum - 1 ns*/ 1,
-             /* maximum - 30 s*/ 30'000'000'000LL,
-             /* significant figures */ 3,
-             /* pointer */ &histogram_);
-    Expects(histogram_ != nullptr);
+auto
+make_histogram() -> hdr_histogram*
+{
+  hdr_histogram* histogram{ nullptr };
+  hdr_init(histogram_lowest_value,
+           histogram_highest_value,
+           histogram_significant_figures,
+           &histogram);
+  Expects(histogram != nullptr);
+  return histogram;
+}
+
+auto
+this_thread_shard_index() -> std::size_t
+{
+  static std::atomic<std::size_t> next_index{ 0 };
+  thread_local const std::size_t index = next_index.fetch_add(1, std::memory_order_relaxed);
+  return index;
+}
+
+auto
+percentile_key(double percentile) -> std::string
+{
+  if (percentile == static_cast<double>(static_cast<std::int64_t>(percentile))) {
+    return fmt::format("{:.1f}", percentile);
   }
+  return fmt::format("{}", percentile);
+}
 
+/**
+ * Writer-reader phaser (as in HdrHistogram's WriterReaderPhaser). Writers never block, and the
+ * reader waits only for the writers, that have entered the phase before it was flipped.
+ */
+class writer_reader_phaser
+{
 public:
-  logging_value_recorder(std::string name, std::map<std::string, std::string> tags)
-    : value_recorder()
-    , name_(std::move(name))
-    , tags_(std::move(tags))
+  auto writer_enter() -> std::int64_t
   {
-    initialize_histogram();
+    return start_epoch_.fetch_add(1);
   }
 
-  logging_value_recorder(const logging_value_recorder& other)
-    : value_recorder()
-    , name_(other.name_)
-    , tags_(other.tags_)
+  void writer_exit(std::int64_t critical_value)
   {
-    initialize_histogram();
+    (critical_value < 0 ? odd_end_epoch_ : even_end_epoch_).fetch_add(1);
   }
 
-  logging_value_recorder(logging_value_recorder&& other) noexcept
-    : value_recorder()
-    , name_(std::move(other.name_))
-    , tags_(std::move(other.tags_))
+  /**
+   * Must be serialized by the caller.
+   *
+   * @return index of the phase, that was active before the flip (0 for even, 1 for odd)
+   */
+  auto flip_phase() -> std::size_t
   {
-    initialize_histogram();
+    const bool next_phase_is_even = start_epoch_.load() < 0;
+    const std::int64_t initial_start_value =
+      next_phase_is_even ? 0 : std::numeric_limits<std::int64_t>::min();
+    (next_phase_is_even ? even_end_epoch_ : odd_end_epoch_).store(initial_start_value);
+    const auto start_value_at_flip = start_epoch_.exchange(initial_start_value);
+    auto& previous_end_epoch = next_phase_is_even ? odd_end_epoch_ : even_end_epoch_;
+    while (previous_end_epoch.load() != start_value_at_flip) {
+      std::this_thread::yield();
+    }
+    return next_phase_is_even ? 1 : 0;
   }
 
-  auto operator=(const logging_value_recorder& other) -> logging_value_recorder&
+  static auto phase_of(std::int64_t critical_value) -> std::size_t
   {
-    if (this == &other) {
-      return *this;
-    }
-    name_ = other.name_;
-    tags_ = other.tags_;
-    initialize_histogram();
-    return *this;
+    return critical_value < 0 ? 1 : 0;
   }
 
-  auto operator=(logging_value_recorder&& other) noexcept -> logging_value_recorder&
+private:
+  std::atomic<std::int64_t> start_epoch_{ 0 };
+  std::atomic<std::int64_t> even_end_epoch_{ 0 };
+  std::atomic<std::int64_t> odd_end_epoch_{ std::numeric_limits<std::int64_t>::min() };
+};
+} // namespace
+
+/**
+ * Records values into per-thread shards, so that threads do not contend on the same histogram.
+ *
+ * Each shard has two histograms: one is written by the recording threads, while the other one is
+ * merged into the report and reset. The histograms are allocated on first use.
+ */
+class logging_value_recorder : public couchbase::metrics::value_recorder
+{
+private:
+  struct alignas(64) shard {
+    std::array<std::atomic<hdr_histogram*>, 2> histograms{};
+    writer_reader_phaser phaser{};
+  };
+
+  std::string name_;
+  std::map<std::string, std::string> tags_;
+  std::vector<double> percentiles_;
+  std::vector<shard> shards_;
+  hdr_histogram* aggregate_{ make_histogram() };
+  std::mutex emit_mutex_{};
+
+  static auto histogram_for(std::atomic<hdr_histogram*>& slot) -> hdr_histogram*
   {
-    if (this == &other) {
-      return *this;
+    if (auto* histogram = slot.load(std::memory_order_acquire); histogram != nullptr) {
+      return histogram;
+    }
+    auto* fresh = make_histogram();
+    hdr_histogram* expected{ nullptr };
+    if (slot.compare_exchange_strong(expected, fresh, std::memory_order_acq_rel)) {
+      return fresh;
     }
-    name_ = std::move(other.name_);
-    tags_ = std::move(other.tags_);
-    initialize_histogram();
-    return *this;
+    hdr_close(fresh);
+    return expected;
+  }
+
+public:
+  logging_value_recorder(std::string name,
+                         std::map<std::string, std::string> tags,
+                         std::vector<double> percentiles,
+                         std::size_t number_of_shards)
+    : value_recorder()
+    , name_(std::move(name))
+    , tags_(std::move(tags))
+    , percentiles_(std::move(percentiles))
+    , shards_(std::max<std::size_t>(1, number_of_shards))
+  {
   }
 
+  logging_value_recorder(const logging_value_recorder& other) = delete;
+  logging_value_recorder(logging_value_recorder&& other) noexcept = delete;
+  auto operator=(const logging_value_recorder& other) -> logging_value_recorder& = delete;
+  auto operator=(logging_value_recorder&& other) noexcept -> logging_value_recorder& = delete;
+
   ~logging_value_recorder() override
   {
-    if (histogram_ != nullptr) {
-      hdr_close(histogram_);
-      histogram_ = nullptr;
+    for (auto& s : shards_) {
+      for (auto& slot : s.histograms) {
+        if (auto* histogram = slot.load(); histogram != nullptr) {
+          hdr_close(histogram);
+        }
+      }
     }
+    hdr_close(aggregate_);
   }
 
   void record_value(std::int64_t value) override
   {
-    if (histogram_ == nullptr) {
-      return;
-    }
-    hdr_record_value_atomic(histogram_, value);
+    auto& s = shards_[this_thread_shard_index() % shards_.size()];
+    const auto critical_value = s.phaser.writer_enter();
+    hdr_record_value_atomic(
+      histogram_for(s.histograms[writer_reader_phaser::phase_of(critical_value)]), value);
+    s.phaser.writer_exit(critical_value);
   }
 
-  [[nodiscard]] auto emit() const -> tao::json::value
+  [[nodiscard]] auto emit() -> tao::json::value
   {
-    auto total_count = histogram_->total_count;
-    auto val_50_0 = hdr_value_at_percentile(histogram_, 50.0);
-    auto val_90_0 = hdr_value_at_percentile(histogram_, 90.0);
-    auto val_99_0 = hdr_value_at_percentile(histogram_, 99.0);
-    auto val_99_9 = hdr_value_at_percentile(histogram_, 99.9);
-    auto val_100_0 = hdr_value_at_percentile(histogram_, 100.0);
+    const std::scoped_lock lock(emit_mutex_);
+    for (auto& s : shards_) {
+      const auto inactive = s.phaser.flip_phase();
+      if (auto* histogram = s.histograms[inactive].load(std::memory_order_acquire);
+          histogram != nullptr) {
+        hdr_add(aggregate_, histogram);
+        hdr_reset(histogram);
+      }
+    }
 
-    hdr_reset(histogram_);
+    tao::json::value percentiles = tao::json::empty_object;
+    for (const auto percentile : percentiles_) {
+      percentiles[percentile_key(percentile)] = hdr_value_at_percentile(aggregate_, percentile);
+    }
+    const auto total_count = aggregate_->total_count;
+    hdr_reset(aggregate_);
 
     return {
       { "total_count", total_count },
-      { "percentiles_us",
-        {
-          { "50.0", val_50_0 },
-          { "90.0", val_90_0 },
-          { "99.0", val_99_0 },
-          { "99.9", val_99_9 },
-          { "100.0", val_100_0 },
-        } },
+      { "percentiles_us", std::move(percentiles) },
     };
   }
 };
 
-void
-logging_meter::log_report() const
+auto
+logging_meter::report() const -> tao::json::value
 {
   tao::json::value report{
     {
@@ -155,12 +241,40 @@ logging_meter::log_report() const
       },
     },
   };
+  const std::scoped_lock lock(recorders_mutex_);
   for (const auto& [service, operations] : recorders_) {
     for (const auto& [operation, recorder] : operations) {
       report["operations"][service][operation] = recorder->emit();
     }
   }
-  if (report.find("operations") != nullptr) {
+  const std::scoped_lock sections_lock(sections_mutex_);
+  for (const auto& [name, section] : sections_) {
+    if (auto value = section(); !value.is_null()) {
+      report[name] = std::move(value);
+    }
+  }
+  return report;
+}
+
+void
+logging_meter::add_report_section(std::string name, std::function<tao::json::value()> section)
+{
+  const std::scoped_lock lock(sections_mutex_);
+  sections_.insert_or_assign(std::move(name), std::move(section));
+}
+
+void
+logging_meter::remove_report_section(const std::string& name)
+{
+  const std::scoped_lock lock(sections_mutex_);
+  sections_.erase(name);
+}
+
+void
+logging_meter::log_report() const
+{
+  // the report always has "meta", so only log it when there is something besides that
+  if (auto report = this->report(); report.get_object().size() > 1) {
     CB_LOG_INFO("Metrics: {}", utils::json::generate(report));
   }
 }
@@ -228,8 +342,14 @@ logging_meter::get_value_recorder(const std::string& name,
   const std::scoped_lock lock(recorders_mutex_);
   auto& service_recorders = recorders_[service->second];
 
-  auto [it, _] = service_recorders.try_emplace(
-    operation->second, std::make_shared<logging_value_recorder>(operation->second, tags));
+  auto it = service_recorders.find(operation->second);
+  if (it == service_recorders.end()) {
+    it = service_recorders
+           .try_emplace(operation->second,
+                        std::make_shared<logging_value_recorder>(
+                          operation->second, tags, options_.percentiles, options_.number_of_shards))
+           .first;
+  }
   return it->second;
 }
 } // namespace couchbase::core::metrics
@@ -22,8 +22,12 @@
 #include <couchbase/metrics/meter.hxx>
 
 #include <asio/steady_timer.hpp>
+#include <tao/json/forward.hpp>
 
+#include <functional>
+#include <map>
 #include <mutex>
+#include <string>
 
 namespace couchbase::core::metrics
 {
@@ -36,10 +40,12 @@ class logging_meter
 private:
   asio::steady_timer emit_report_;
   logging_meter_options options_;
-  std::mutex recorders_mutex_{};
+  mutable std::mutex recorders_mutex_{};
   // service name -> operation name -> recorder
   std::map<std::string, std::map<std::string, std::shared_ptr<logging_value_recorder>>>
     recorders_{};
+  mutable std::mutex sections_mutex_{};
+  std::map<std::string, std::function<tao::json::value()>> sections_{};
 
   void log_report() const;
 
@@ -54,6 +60,27 @@ public:
 
   void stop() override;
 
+  /**
+   * Merges and resets histograms of all recorders.
+   *
+   * @return the report, that would be written to the log on the next emit interval
+   */
+  [[nodiscard]] auto report() const -> tao::json::value;
+
+  /**
+   * Adds the section to the report. The callback is invoked on every emit interval, and its
+   * result is written under the given name, unless it is null.
+   *
+   * The callback is invoked with internal lock held, so it must not add or remove sections.
+   */
+  void add_report_section(std::string name, std::function<tao::json::value()> section);
+
+  /**
+   * Removes the section from the report. Once this function returns, the callback is not invoked
+   * anymore.
+   */
+  void remove_report_section(const std::string& name);
+
   auto get_value_recorder(const std::string& name, const std::map<std::string, std::string>& tags)
     -> std::shared_ptr<couchbase::metrics::value_recorder> override;
 };
@@ -18,11 +18,24 @@
 #pragma once
 
 #include <chrono>
+#include <cstddef>
+#include <vector>
 
 namespace couchbase::core::metrics
 {
 struct logging_meter_options {
   std::chrono::milliseconds emit_interval{ std::chrono::minutes{ 10 } };
+  std::vector<double> percentiles{ 50.0, 90.0, 99.0, 99.9, 100.0 };
+  /**
+   * Number of histogram pairs per recorder. Each histogram takes about 200KB, and allocated only
+   * when some thread records value into it.
+   *
+   * A busy recorder holds two histograms per shard plus the one that aggregates the report, i.e.
+   * 2 * number_of_shards + 1 histograms. The default of one shard uses about 600KB per recorder,
+   * three times the single histogram of the unsharded recorder, while four shards use about 9
+   * times as much. More shards only pay off when many threads record into the same recorder.
+   */
+  std::size_t number_of_shards{ 1 };
 };
 
 } // namespace couchbase::core::metrics
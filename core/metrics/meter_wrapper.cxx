@@ -20,13 +20,18 @@
 #include <couchbase/error_codes.hxx>
 
 #include "core/metrics/constants.hxx"
+#include "core/metrics/logging_meter.hxx"
 #include "core/tracing/constants.hxx"
 
+#include <functional>
 #include <map>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <system_error>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace couchbase::core::metrics
 {
@@ -97,8 +102,80 @@ get_standardized_error_type(std::error_code ec) -> std::string
 
   return "_OTHER";
 }
+
+// upper bound for distinct attribute sets, after which recorders are resolved without caching
+constexpr std::size_t max_interned_recorders{ 4096 };
+
+void
+hash_combine(std::size_t& seed, std::size_t value)
+{
+  seed ^= value + 0x9e3779b9U + (seed << 6U) + (seed >> 2U);
+}
+
+auto
+hash_optional(const std::optional<std::string>& value) -> std::size_t
+{
+  return value ? std::hash<std::string_view>{}(value.value()) : 0;
+}
+
+auto
+hash_attributes(const metric_attributes& attrs) -> std::size_t
+{
+  std::size_t seed = std::hash<std::string_view>{}(attrs.service);
+  hash_combine(seed, std::hash<std::string_view>{}(attrs.operation));
+  hash_combine(seed, hash_optional(attrs.bucket_name));
+  hash_combine(seed, hash_optional(attrs.scope_name));
+  hash_combine(seed, hash_optional(attrs.collection_name));
+  if (attrs.ec) {
+    hash_combine(seed, std::hash<const void*>{}(&attrs.ec.category()));
+    hash_combine(seed, std::hash<int>{}(attrs.ec.value()));
+  }
+  return seed;
+}
 } // namespace
 
+struct meter_wrapper::interned_recorder {
+  std::string service;
+  std::string operation;
+  std::optional<std::string> bucket_name;
+  std::optional<std::string> scope_name;
+  std::optional<std::string> collection_name;
+  std::error_code ec;
+  std::shared_ptr<couchbase::metrics::value_recorder> recorder;
+
+  [[nodiscard]] auto matches(const metric_attributes& attrs) const -> bool
+  {
+    // the error type tag depends only on the error code, so compare them instead of the tag
+    return service == attrs.service && operation == attrs.operation &&
+           bucket_name == attrs.bucket_name && scope_name == attrs.scope_name &&
+           collection_name == attrs.collection_name &&
+           ((!ec && !attrs.ec) || ec == attrs.ec);
+  }
+};
+
+/**
+ * Immutable snapshot of the interned recorders, replaced as a whole when new attribute set is seen
+ * or when the cluster labels change.
+ */
+struct meter_wrapper::recorder_table {
+  std::uint64_t labels_version{ 0 };
+  std::size_t size{ 0 };
+  std::unordered_map<std::size_t, std::vector<interned_recorder>> recorders{};
+
+  [[nodiscard]] auto find(std::size_t hash, const metric_attributes& attrs) const
+    -> std::shared_ptr<couchbase::metrics::value_recorder>
+  {
+    if (auto it = recorders.find(hash); it != recorders.end()) {
+      for (const auto& entry : it->second) {
+        if (entry.matches(attrs)) {
+          return entry.recorder;
+        }
+      }
+    }
+    return nullptr;
+  }
+};
+
 auto
 metric_attributes::encode() const -> std::map<std::string, std::string>
 {
@@ -134,6 +211,7 @@ metric_attributes::encode() const -> std::map<std::string, std::string>
 meter_wrapper::meter_wrapper(std::shared_ptr<couchbase::metrics::meter> meter,
                              std::shared_ptr<cluster_label_listener> label_listener)
   : meter_{ std::move(meter) }
+  , logging_meter_{ std::dynamic_pointer_cast<logging_meter>(meter_) }
   , cluster_label_listener_{ std::move(label_listener) }
 {
 }
@@ -158,20 +236,78 @@ meter_wrapper::record_value(const std::map<std::string, std::string>& raw_attrs,
 }
 
 void
-meter_wrapper::record_value(metric_attributes attrs,
+meter_wrapper::record_value(const metric_attributes& attrs,
                             std::chrono::steady_clock::time_point start_time)
 {
+  const auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
+    std::chrono::steady_clock::now() - start_time);
+  value_recorder(attrs)->record_value(duration.count());
+}
+
+auto
+meter_wrapper::value_recorder(const metric_attributes& attrs)
+  -> std::shared_ptr<couchbase::metrics::value_recorder>
+{
+  const auto labels_version = cluster_label_listener_->labels_version();
+  const auto hash = hash_attributes(attrs);
+  if (auto table = std::atomic_load(&recorders_);
+      table != nullptr && table->labels_version == labels_version) {
+    if (auto recorder = table->find(hash, attrs); recorder != nullptr) {
+      return recorder;
+    }
+  }
+
+  metric_attributes labelled_attrs = attrs;
   auto [cluster_name, cluster_uuid] = cluster_label_listener_->cluster_labels();
   if (cluster_name) {
-    attrs.internal.cluster_name = cluster_name;
+    labelled_attrs.internal.cluster_name = cluster_name;
   }
   if (cluster_uuid) {
-    attrs.internal.cluster_uuid = cluster_uuid;
+    labelled_attrs.internal.cluster_uuid = cluster_uuid;
   }
+  auto recorder = meter_->get_value_recorder(operation_meter_name, labelled_attrs.encode());
 
-  record_value(attrs.encode(),
-               std::chrono::duration_cast<std::chrono::microseconds>(
-                 std::chrono::steady_clock::now() - start_time));
+  const std::scoped_lock lock(recorders_mutex_);
+  auto current = std::atomic_load(&recorders_);
+  auto next = std::make_shared<recorder_table>();
+  if (current != nullptr && current->labels_version == labels_version) {
+    if (auto existing = current->find(hash, attrs); existing != nullptr) {
+      return existing;
+    }
+    if (current->size >= max_interned_recorders) {
+      return recorder;
+    }
+    *next = *current;
+  }
+  next->labels_version = labels_version;
+  next->recorders[hash].push_back(interned_recorder{
+    attrs.service,
+    attrs.operation,
+    attrs.bucket_name,
+    attrs.scope_name,
+    attrs.collection_name,
+    attrs.ec,
+    recorder,
+  });
+  ++next->size;
+  std::atomic_store(&recorders_, std::shared_ptr<const recorder_table>{ std::move(next) });
+  return recorder;
+}
+
+void
+meter_wrapper::add_report_section(std::string name, std::function<tao::json::value()> section)
+{
+  if (logging_meter_) {
+    logging_meter_->add_report_section(std::move(name), std::move(section));
+  }
+}
+
+void
+meter_wrapper::remove_report_section(const std::string& name)
+{
+  if (logging_meter_) {
+    logging_meter_->remove_report_section(name);
+  }
 }
 
 auto
@@ -23,8 +23,13 @@
 
 #include <couchbase/metrics/meter.hxx>
 
+#include <tao/json/forward.hpp>
+
 #include <chrono>
+#include <functional>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <system_error>
@@ -33,6 +38,8 @@
 
 namespace couchbase::core::metrics
 {
+class logging_meter;
+
 struct metric_attributes {
   std::string service;
   std::string operation;
@@ -58,10 +65,30 @@ public:
   void start();
   void stop();
 
-  void record_value(metric_attributes attrs, std::chrono::steady_clock::time_point start_time);
+  void record_value(const metric_attributes& attrs,
+                    std::chrono::steady_clock::time_point start_time);
   void record_value(const std::map<std::string, std::string>& raw_attrs,
                     std::chrono::microseconds duration);
 
+  /**
+   * Returns the operation duration recorder for the given attributes.
+   *
+   * The recorders are interned by service, operation, keyspace and error type, so after the first
+   * call for the same attributes, the lookup does not allocate and does not take locks shared with
+   * other operations.
+   */
+  [[nodiscard]] auto value_recorder(const metric_attributes& attrs)
+    -> std::shared_ptr<couchbase::metrics::value_recorder>;
+
+  /**
+   * Adds the section to the periodic report of the logging meter. Does nothing for other meters,
+   * as the public meter interface has no way to carry the counters, that are not durations.
+   *
+   * @see logging_meter::add_report_section
+   */
+  void add_report_section(std::string name, std::function<tao::json::value()> section);
+  void remove_report_section(const std::string& name);
+
   [[nodiscard]] auto wrapped() -> std::shared_ptr<couchbase::metrics::meter>;
 
   [[nodiscard]] static auto create(std::shared_ptr<couchbase::metrics::meter> meter,
@@ -69,7 +96,14 @@ public:
     -> std::shared_ptr<meter_wrapper>;
 
 private:
+  struct interned_recorder;
+  struct recorder_table;
+
   std::shared_ptr<couchbase::metrics::meter> meter_;
+  // not null, when meter_ is the logging meter, that owns the periodic report
+  std::shared_ptr<logging_meter> logging_meter_;
   std::shared_ptr<cluster_label_listener> cluster_label_listener_;
+  std::shared_ptr<const recorder_table> recorders_{};
+  std::mutex recorders_mutex_{};
 };
 } // namespace couchbase::core::metrics
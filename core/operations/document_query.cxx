@@ -39,7 +39,8 @@ query_request::encode_to(query_request::encoded_request_type& encoded, http_cont
   tao::json::value body{
     { "client_context_id", encoded.client_context_id },
   };
-  if (adhoc) {
+  if (adhoc || !context.cache.enabled()) {
+    // without the cache, the prepared statement could not be reused anyway
     body["statement"] = statement;
   } else {
     if (auto entry = ctx_->cache.get(statement)) {
@@ -367,6 +368,10 @@ query_request::make_response(error_context::query&& ctx, const encoded_response_
           case 4060: /* IKey: "plan.build_prepared.no_such_name" */
           case 4080: /* IKey: "plan.build_prepared.name_encoded_plan_mismatch" */
           case 4090: /* IKey: "plan.build_prepared.name_not_in_encoded_plan" */
+            // the cached plan is stale, so the next attempt has to prepare the statement again
+            if (ctx_.has_value()) {
+              ctx_->cache.erase(statement);
+            }
             response.ctx.ec = errc::query::prepared_statement_failure;
             break;
           case 4300: /* IKey: "plan.new_index_already_exists" */
@@ -153,6 +153,51 @@ search_request::encode_to(search_request::encoded_request_type& encoded,
   return {};
 }
 
+auto
+parse_search_row(const tao::json::value& entry) -> search_response::search_row
+{
+  search_response::search_row row{};
+  row.index = entry.optional<std::string>("index").value_or(std::string());
+  row.id = entry.optional<std::string>("id").value_or(std::string());
+  row.score = entry.optional<double>("score").value_or(0);
+  if (const auto* locations_map = entry.find("locations");
+      locations_map != nullptr && locations_map->is_object()) {
+    for (const auto& [field, terms] : locations_map->get_object()) {
+      for (const auto& [term, locations] : terms.get_object()) {
+        for (const auto& loc : locations.get_array()) {
+          search_response::search_location location{};
+          location.field = field;
+          location.term = term;
+          location.position = loc.at("pos").get_unsigned();
+          location.start_offset = loc.at("start").get_unsigned();
+          location.end_offset = loc.at("end").get_unsigned();
+          if (const auto* array_positions = loc.find("array_positions");
+              array_positions != nullptr && array_positions->is_array()) {
+            location.array_positions.emplace(array_positions->as<std::vector<std::uint64_t>>());
+          }
+          row.locations.emplace_back(location);
+        }
+      }
+    }
+  }
+
+  if (const auto* fragments_map = entry.find("fragments");
+      fragments_map != nullptr && fragments_map->is_object()) {
+    for (const auto& [field, fragments] : fragments_map->get_object()) {
+      row.fragments.try_emplace(field, fragments.as<std::vector<std::string>>());
+    }
+  }
+  if (const auto* response_fields = entry.find("fields");
+      response_fields != nullptr && response_fields->is_object()) {
+    row.fields = utils::json::generate(*response_fields);
+  }
+  if (const auto* explanation = entry.find("explanation");
+      explanation != nullptr && explanation->is_object()) {
+    row.explanation = utils::json::generate(*explanation);
+  }
+  return row;
+}
+
 auto
 search_request::make_response(error_context::search&& ctx,
                               const encoded_response_type& encoded) const -> search_response
@@ -200,47 +245,7 @@ search_request::make_response(error_context::search&& ctx,
       try {
         if (const auto* rows = payload.find("hits"); rows != nullptr && rows->is_array()) {
           for (const auto& entry : rows->get_array()) {
-            search_response::search_row row{};
-            row.index = entry.optional<std::string>("index").value_or(std::string());
-            row.id = entry.optional<std::string>("id").value_or(std::string());
-            row.score = entry.optional<double>("score").value_or(0);
-            if (const auto* locations_map = entry.find("locations");
-                locations_map != nullptr && locations_map->is_object()) {
-              for (const auto& [field, terms] : locations_map->get_object()) {
-                for (const auto& [term, locations] : terms.get_object()) {
-                  for (const auto& loc : locations.get_array()) {
-                    search_response::search_location location{};
-                    location.field = field;
-                    location.term = term;
-                    location.position = loc.at("pos").get_unsigned();
-                    location.start_offset = loc.at("start").get_unsigned();
-                    location.end_offset = loc.at("end").get_unsigned();
-                    if (const auto* array_positions = loc.find("array_positions");
-                        array_positions != nullptr && array_positions->is_array()) {
-                      location.array_positions.emplace(
-                        array_positions->as<std::vector<std::uint64_t>>());
-                    }
-                    row.locations.emplace_back(location);
-                  }
-                }
-              }
-            }
-
-            if (const auto* fragments_map = entry.find("fragments");
-                fragments_map != nullptr && fragments_map->is_object()) {
-              for (const auto& [field, fragments] : fragments_map->get_object()) {
-                row.fragments.try_emplace(field, fragments.as<std::vector<std::string>>());
-              }
-            }
-            if (const auto* response_fields = entry.find("fields");
-                response_fields != nullptr && response_fields->is_object()) {
-              row.fields = utils::json::generate(*response_fields);
-            }
-            if (const auto* explanation = entry.find("explanation");
-                explanation != nullptr && explanation->is_object()) {
-              row.explanation = utils::json::generate(*explanation);
-            }
-            response.rows.emplace_back(row);
+            response.rows.emplace_back(parse_search_row(entry));
           }
         }
       } catch (const std::out_of_range& e) {
@@ -31,6 +31,8 @@
 
 #include <couchbase/mutation_token.hxx>
 
+#include <tao/json/forward.hpp>
+
 #include <map>
 #include <variant>
 #include <vector>
@@ -174,4 +176,12 @@ struct search_request {
 
   std::shared_ptr<couchbase::tracing::request_span> parent_span{ nullptr };
 };
+
+/**
+ * Decodes single element of the "hits" array of the search response.
+ *
+ * @throws std::out_of_range if the mandatory properties of the hit are missing
+ */
+auto
+parse_search_row(const tao::json::value& entry) -> search_response::search_row;
 } // namespace couchbase::core::operations
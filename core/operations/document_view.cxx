@@ -174,14 +174,7 @@ document_view_request::make_response(error_context::view&& ctx,
 
       if (const auto* rows = payload.find("rows"); rows != nullptr && rows->is_array()) {
         for (const auto& entry : rows->get_array()) {
-          document_view_response::row row{};
-
-          if (const auto* id = entry.find("id"); id != nullptr && id->is_string()) {
-            row.id = id->get_string();
-          }
-          row.key = utils::json::generate(entry.at("key"));
-          row.value = utils::json::generate(entry.at("value"));
-          response.rows.emplace_back(row);
+          response.rows.emplace_back(parse_view_row(entry));
         }
       }
     } else if (encoded.status_code == 400) {
@@ -211,4 +204,16 @@ document_view_request::make_response(error_context::view&& ctx,
   }
   return response;
 }
+
+auto
+parse_view_row(const tao::json::value& entry) -> document_view_response::row
+{
+  document_view_response::row row{};
+  if (const auto* id = entry.find("id"); id != nullptr && id->is_string()) {
+    row.id = id->get_string();
+  }
+  row.key = utils::json::generate(entry.at("key"));
+  row.value = utils::json::generate(entry.at("value"));
+  return row;
+}
 } // namespace couchbase::core::operations
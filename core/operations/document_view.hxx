@@ -28,6 +28,8 @@
 #include "core/timeout_defaults.hxx"
 #include "core/view_on_error.hxx"
 #include "core/view_scan_consistency.hxx"
+
+#include <tao/json/forward.hpp>
 #include "core/view_sort_order.hxx"
 
 namespace couchbase::core::operations
@@ -109,4 +111,11 @@ struct COUCHBASE_DEPRECATED(
     -> document_view_response;
 };
 
+/**
+ * Decodes single element of the "rows" array of the view response.
+ *
+ * @throws std::out_of_range if the key or the value of the row is missing
+ */
+auto
+parse_view_row(const tao::json::value& entry) -> document_view_response::row;
 } // namespace couchbase::core::operations
@@ -113,6 +113,25 @@ struct traits<couchbase::core::orphan_reporter_options> {
   }
 };
 
+template<>
+struct traits<couchbase::core::compression_policy_options> {
+  template<template<typename...> class Traits>
+  static void assign(tao::json::basic_value<Traits>& v,
+                     const couchbase::core::compression_policy_options& o)
+  {
+    tao::json::value disabled_collections = tao::json::empty_array;
+    for (const auto& keyspace : o.disabled_collections) {
+      disabled_collections.emplace_back(keyspace);
+    }
+    v = {
+      { "min_size", o.min_size },
+      { "min_ratio", o.min_ratio },
+      { "adaptive", o.adaptive },
+      { "disabled_collections", disabled_collections },
+    };
+  }
+};
+
 template<>
 struct traits<couchbase::core::tracing::threshold_logging_options> {
   template<template<typename...> class Traits>
@@ -140,6 +159,8 @@ struct traits<couchbase::core::metrics::logging_meter_options> {
   {
     v = {
       { "emit_interval", o.emit_interval },
+      { "percentiles", o.percentiles },
+      { "number_of_shards", o.number_of_shards },
     };
   }
 };
@@ -203,6 +224,8 @@ struct traits<couchbase::transactions::transactions_config::built> {
           { "cleanup_lost_attempts", o.cleanup_config.cleanup_lost_attempts },
           { "cleanup_client_attempts", o.cleanup_config.cleanup_client_attempts },
           { "cleanup_window", o.cleanup_config.cleanup_window },
+          { "max_concurrent_atr_reads", o.cleanup_config.max_concurrent_atr_reads },
+          { "max_atr_reads_per_second", o.cleanup_config.max_atr_reads_per_second },
           { "collections", tao::json::empty_array },
         },
       },
@@ -285,13 +308,17 @@ origin::to_json() const -> std::string
         { "show_queries", options_.show_queries },
         { "enable_unordered_execution", options_.enable_unordered_execution },
         { "enable_compression", options_.enable_compression },
+        { "compression_policy", options_.compression_policy },
         { "enable_tracing", options_.enable_tracing },
         { "enable_metrics", options_.enable_metrics },
         { "enable_orphan_reporting", options_.enable_orphan_reporting },
         { "tcp_keep_alive_interval", options_.tcp_keep_alive_interval },
         { "config_idle_redial_timeout", options_.config_idle_redial_timeout },
         { "max_http_connections", options_.max_http_connections },
+        { "kv_connections_per_node", options_.kv_connections_per_node },
+        { "prepared_statement_cache_capacity", options_.prepared_statement_cache_capacity },
         { "idle_http_connection_timeout", options_.idle_http_connection_timeout },
+        { "streaming_row_buffer_size", options_.streaming_row_buffer_size },
         { "metrics_options", options_.metrics_options },
         { "tracing_options", options_.tracing_options },
         { "orphan_reporter_options", options_.orphan_options },
@@ -20,7 +20,7 @@
 #include <couchbase/build_info.hxx>
 
 #include "logger/logger.hxx"
-#include "utils/concurrent_fixed_priority_queue.hxx"
+#include "utils/concurrent_top_n_sampler.hxx"
 #include "utils/json.hxx"
 
 #include <asio/steady_timer.hpp>
@@ -67,7 +67,8 @@ public:
 
   void add_orphan(orphan_attributes&& orphan)
   {
-    orphan_queue_.emplace(std::move(orphan));
+    const auto weight = orphan.total_duration.count();
+    orphan_queue_.emplace(weight, std::move(orphan));
   }
 
   void start()
@@ -86,9 +87,9 @@ public:
       return std::nullopt;
     }
 
-    auto [queue, dropped_count] = orphan_queue_.steal_data();
+    auto [orphans, dropped_count] = orphan_queue_.steal_data();
 
-    auto total_count = queue.size() + dropped_count;
+    auto total_count = orphans.size() + dropped_count;
 
     // We only do orphan reporting for KV at the moment. If we extend this to HTTP services, we must
     // update this to handle other types of services as well.
@@ -101,9 +102,8 @@ public:
     };
 
     tao::json::value entries = tao::json::empty_array;
-    while (!queue.empty()) {
-      entries.emplace_back(queue.top().to_json());
-      queue.pop();
+    for (const auto& orphan : orphans) {
+      entries.emplace_back(orphan.to_json());
     }
     report["kv"]["top_requests"] = entries;
 
@@ -128,7 +128,7 @@ private:
   }
 
   orphan_reporter_options options_;
-  utils::concurrent_fixed_priority_queue<orphan_attributes> orphan_queue_;
+  utils::concurrent_top_n_sampler<orphan_attributes> orphan_queue_;
   asio::steady_timer emit_timer_;
 };
 
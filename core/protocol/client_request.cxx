@@ -23,19 +23,23 @@
 namespace couchbase::core::protocol
 {
 auto
-compress_value(const std::vector<std::byte>& value, const std::vector<std::byte>::iterator& output)
-  -> std::pair<bool, std::uint32_t>
+compress_value(gsl::span<const std::byte> value, std::vector<std::byte>& output, double min_ratio)
+  -> bool
 {
-  static const double min_ratio = 0.83;
-
-  std::string compressed;
-  const std::size_t compressed_size =
-    snappy::Compress(reinterpret_cast<const char*>(value.data()), value.size(), &compressed);
+  // compress directly into the output, so that the value is not copied twice
+  const auto offset = output.size();
+  output.resize(offset + snappy::MaxCompressedLength(value.size()));
+  std::size_t compressed_size{ 0 };
+  snappy::RawCompress(reinterpret_cast<const char*>(value.data()),
+                      value.size(),
+                      reinterpret_cast<char*>(output.data() + offset),
+                      &compressed_size);
   if (gsl::narrow_cast<double>(compressed_size) / gsl::narrow_cast<double>(value.size()) <
       min_ratio) {
-    utils::to_binary(compressed, output);
-    return { true, gsl::narrow_cast<std::uint32_t>(compressed_size) };
+    output.resize(offset + compressed_size);
+    return true;
   }
-  return { false, 0 };
+  output.resize(offset);
+  return false;
 }
 } // namespace couchbase::core::protocol
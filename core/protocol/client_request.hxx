@@ -21,6 +21,8 @@
 
 #include "client_opcode.hxx"
 #include "client_response.hxx"
+#include "core/compression_policy.hxx"
+#include "core/io/mcbp_output_buffer.hxx"
 #include "core/utils/binary.hxx"
 #include "core/utils/byteswap.hxx"
 #include "datatype.hxx"
@@ -28,13 +30,25 @@
 
 #include <algorithm>
 #include <cstring>
+#include <gsl/span>
 #include <gsl/util>
+#include <memory>
+#include <utility>
+#include <vector>
 
 namespace couchbase::core::protocol
 {
+/**
+ * Appends the value compressed with snappy to the output, if the compression is worth it.
+ *
+ * @param min_ratio the compressed value is used only if its size relative to the original is
+ * below this ratio
+ * @return true if the compressed value has been appended, otherwise the output is left unchanged
+ */
 auto
-compress_value(const std::vector<std::byte>& value, const std::vector<std::byte>::iterator& output)
-  -> std::pair<bool, std::uint32_t>;
+compress_value(gsl::span<const std::byte> value,
+               std::vector<std::byte>& output,
+               double min_ratio = 0.83) -> bool;
 
 template<typename Body>
 class client_request
@@ -114,16 +128,79 @@ public:
     return generate_payload(false);
   }
 
+  /**
+   * Encodes the request like data(), but does not copy the value of the document into the message.
+   * Instead, the returned buffer refers to the value, and keeps value_owner (that must own the
+   * body of the request) alive until the buffer has been written.
+   *
+   * @param compression decides whether the value should be compressed, nullptr if the value must
+   * be sent as is (e.g. snappy has not been negotiated)
+   */
+  [[nodiscard]] auto gathered_data(core::compression_policy* compression,
+                                   std::shared_ptr<const void> value_owner)
+    -> io::mcbp_output_buffer
+  {
+    switch (opcode_) {
+      case protocol::client_opcode::insert:
+      case protocol::client_opcode::upsert:
+      case protocol::client_opcode::replace:
+        return generate_gathered_payload(compression, std::move(value_owner));
+      default:
+        break;
+    }
+    return io::mcbp_output_buffer{ generate_payload(false) };
+  }
+
 private:
+  static constexpr std::size_t min_size_to_compress{ 32 };
+
   [[nodiscard]] auto generate_payload(bool try_to_compress) -> std::vector<std::byte>
   {
+    const auto& value = body_.value();
+    auto payload = generate_head(value.size());
+    if (try_to_compress && value.size() > min_size_to_compress && compress_value(value, payload)) {
+      /* the compressed value meets requirements and was appended to the payload */
+      mark_compressed(payload);
+      return payload;
+    }
+    payload.insert(payload.end(), value.begin(), value.end());
+    return payload;
+  }
+
+  [[nodiscard]] auto generate_gathered_payload(core::compression_policy* compression,
+                                               std::shared_ptr<const void> value_owner)
+    -> io::mcbp_output_buffer
+  {
+    const gsl::span<const std::byte> value{ body_.value() };
+    auto head = generate_head(0);
+    if (compression != nullptr && compression->compress(value, head)) {
+      /* the compressed value is a new buffer anyway, so it is owned by the message */
+      mark_compressed(head);
+      return io::mcbp_output_buffer{ std::move(head) };
+    }
+    // the failed compression attempt might have left large capacity behind
+    head.shrink_to_fit();
+    return { std::move(head), value, std::move(value_owner) };
+  }
+
+  /**
+   * Encodes everything except the value: header, framing extras, extras and key.
+   *
+   * @param value_capacity additional capacity to reserve in the buffer for the value
+   */
+  [[nodiscard]] auto generate_head(std::size_t value_capacity) -> std::vector<std::byte>
+  {
+    const auto body_size = body_.size();
+    const auto head_size = header_size + body_size - body_.value().size();
+    std::vector<std::byte> payload{};
+    payload.reserve(head_size + value_capacity);
     // SA: for some reason GCC 8.5.0 on CentOS 8 sees here null-pointer dereference
     // JC: BoringSSL changes, noticed the same when building w/ GCC 11.3.0; TODO:  is 12 okay?
 #if defined(__GNUC__) && __GNUC__ >= 8 && __GNUC__ < 12
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wnull-dereference"
 #endif
-    std::vector<std::byte> payload(header_size + body_.size(), std::byte{});
+    payload.resize(head_size, std::byte{});
     payload[0] = static_cast<std::byte>(magic_);
     payload[1] = static_cast<std::byte>(opcode_);
 #if defined(__GNUC__) && __GNUC__ >= 8 && __GNUC__ < 12
@@ -150,8 +227,8 @@ private:
     std::uint16_t vbucket = utils::byte_swap(gsl::narrow_cast<std::uint16_t>(partition_));
     memcpy(payload.data() + 6, &vbucket, sizeof(vbucket));
 
-    std::uint32_t body_size = utils::byte_swap(gsl::narrow_cast<std::uint32_t>(body_.size()));
-    memcpy(payload.data() + 8, &body_size, sizeof(body_size));
+    std::uint32_t encoded_body_size = utils::byte_swap(gsl::narrow_cast<std::uint32_t>(body_size));
+    memcpy(payload.data() + 8, &encoded_body_size, sizeof(encoded_body_size));
 
     memcpy(payload.data() + 12, &opaque_, sizeof(opaque_));
     memcpy(payload.data() + 16, &cas_, sizeof(cas_));
@@ -161,24 +238,19 @@ private:
       body_itr = std::copy(framing_extras.begin(), framing_extras.end(), body_itr);
     }
     body_itr = std::copy(body_.extras().begin(), body_.extras().end(), body_itr);
-    body_itr = utils::to_binary(body_.key(), body_itr);
-
-    if (static const std::size_t min_size_to_compress = 32;
-        try_to_compress && body_.value().size() > min_size_to_compress) {
-      if (auto [compressed, new_value_size] = compress_value(body_.value(), body_itr); compressed) {
-        /* the compressed value meets requirements and was copied to the payload */
-        protocol::set_flag(payload[5], protocol::datatype::snappy);
-        std::uint32_t new_body_size = utils::byte_swap(body_size) -
-                                      gsl::narrow_cast<std::uint32_t>(body_.value().size()) +
-                                      new_value_size;
-        payload.resize(header_size + new_body_size);
-        new_body_size = utils::byte_swap(new_body_size);
-        memcpy(payload.data() + 8, &new_body_size, sizeof(new_body_size));
-        return payload;
-      }
-    }
-    std::copy(body_.value().begin(), body_.value().end(), body_itr);
+    utils::to_binary(body_.key(), body_itr);
     return payload;
   }
+
+  /**
+   * Sets the snappy flag, and updates the body size once the compressed value has been appended.
+   */
+  static void mark_compressed(std::vector<std::byte>& payload)
+  {
+    protocol::set_flag(payload[5], protocol::datatype::snappy);
+    std::uint32_t new_body_size =
+      utils::byte_swap(gsl::narrow_cast<std::uint32_t>(payload.size() - header_size));
+    memcpy(payload.data() + 8, &new_body_size, sizeof(new_body_size));
+  }
 };
 } // namespace couchbase::core::protocol
@@ -24,8 +24,87 @@
 #include <gsl/assert>
 #include <tao/json/value.hpp>
 
+#include <charconv>
+
 namespace couchbase::core::protocol
 {
+namespace
+{
+void
+skip_whitespace(std::string_view input, std::size_t& pos)
+{
+  while (pos < input.size() &&
+         (input[pos] == ' ' || input[pos] == '\t' || input[pos] == '\n' || input[pos] == '\r')) {
+    ++pos;
+  }
+}
+} // namespace
+
+auto
+peek_config_revision(std::string_view input) -> std::optional<config_revision>
+{
+  config_revision result{};
+  bool rev_found = false;
+  bool epoch_found = false;
+  std::size_t depth = 0;
+  std::size_t pos = 0;
+
+  while (pos < input.size() && !(rev_found && epoch_found)) {
+    const char c = input[pos];
+    if (c == '"') {
+      const std::size_t start = ++pos;
+      while (pos < input.size() && input[pos] != '"') {
+        if (input[pos] == '\\') {
+          ++pos;
+        }
+        ++pos;
+      }
+      if (pos >= input.size()) {
+        return {};
+      }
+      const auto token = input.substr(start, pos - start);
+      ++pos;
+      if (depth != 1 || (token != "rev" && token != "revEpoch")) {
+        continue;
+      }
+      skip_whitespace(input, pos);
+      if (pos >= input.size() || input[pos] != ':') {
+        continue; // string value, not a key
+      }
+      ++pos;
+      skip_whitespace(input, pos);
+      std::int64_t value{};
+      const auto [end, ec] = std::from_chars(input.data() + pos, input.data() + input.size(), value);
+      if (ec != std::errc{}) {
+        return {};
+      }
+      pos = static_cast<std::size_t>(end - input.data());
+      if (token == "rev") {
+        result.rev = value;
+        rev_found = true;
+      } else {
+        result.epoch = value;
+        epoch_found = true;
+      }
+      continue;
+    }
+    if (c == '{' || c == '[') {
+      ++depth;
+    } else if (c == '}' || c == ']') {
+      if (depth <= 1) {
+        break;
+      }
+      --depth;
+    }
+    ++pos;
+  }
+
+  if (!rev_found) {
+    return {};
+  }
+  return result;
+}
+
 auto
 parse_config(std::string_view input,
              std::string_view endpoint_address,
@@ -23,11 +23,46 @@
 #include "core/topology/configuration.hxx"
 #include "status.hxx"
 
+#include <cstdint>
+#include <optional>
 #include <string_view>
 
 namespace couchbase::core::protocol
 {
 
+/**
+ * Revision of the configuration, ordered the same way as topology::configuration.
+ */
+struct config_revision {
+  std::optional<std::int64_t> epoch{};
+  std::optional<std::int64_t> rev{};
+
+  auto operator==(const config_revision& other) const -> bool
+  {
+    return epoch == other.epoch && rev == other.rev;
+  }
+
+  auto operator<(const config_revision& other) const -> bool
+  {
+    return epoch < other.epoch || (epoch == other.epoch && rev < other.rev);
+  }
+
+  auto operator<=(const config_revision& other) const -> bool
+  {
+    return *this < other || *this == other;
+  }
+};
+
+/**
+ * Extracts top-level "rev" and "revEpoch" fields from the configuration text without building
+ * the JSON document.
+ *
+ * @return empty optional if the revision cannot be found, in which case the caller should fall
+ * back to parse_config().
+ */
+auto
+peek_config_revision(std::string_view input) -> std::optional<config_revision>;
+
 auto
 parse_config(std::string_view input,
              std::string_view endpoint_address,
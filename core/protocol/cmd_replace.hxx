@@ -26,6 +26,8 @@
 #include <couchbase/durability_level.hxx>
 #include <couchbase/mutation_token.hxx>
 
+#include <gsl/span>
+
 namespace couchbase::core::protocol
 {
 
@@ -66,7 +68,7 @@ public:
 private:
   std::vector<std::byte> key_{};
   std::vector<std::byte> extras_{};
-  std::vector<std::byte> content_{};
+  gsl::span<const std::byte> content_{};
   std::uint32_t flags_{};
   std::uint32_t expiry_{};
   std::vector<std::byte> framing_extras_{};
@@ -78,9 +80,13 @@ public:
 
   void preserve_expiry();
 
-  void content(const std::vector<std::byte>& content)
+  /**
+   * The body refers to the content without copying it, so the content must outlive the body and
+   * any buffer produced from it by client_request::gathered_data().
+   */
+  void content(gsl::span<const std::byte> content)
   {
-    content_ = { content.begin(), content.end() };
+    content_ = content;
   }
 
   void flags(std::uint32_t flags)
@@ -30,6 +30,7 @@
 #include <asio/experimental/concurrent_channel.hpp>
 #include <asio/io_context.hpp>
 
+#include <algorithm>
 #include <atomic>
 #include <memory>
 #include <mutex>
@@ -48,16 +49,16 @@ struct row_stream_end_signal {
 class row_streamer_impl : public std::enable_shared_from_this<row_streamer_impl>
 {
 public:
-  static constexpr std::size_t ROW_BUFFER_SIZE{ 100 };
-  static constexpr std::size_t ROW_BUFFER_FEED_THRESHOLD{ ROW_BUFFER_SIZE * 3 / 4 };
   static constexpr std::uint32_t LEXER_DEPTH{ 4 };
 
   row_streamer_impl(asio::io_context& io,
                     http_response_body body,
-                    const std::string& pointer_expression)
+                    const std::string& pointer_expression,
+                    std::size_t row_buffer_size)
     : io_{ io }
     , body_{ std::move(body) }
-    , rows_{ io_, ROW_BUFFER_SIZE }
+    , row_buffer_feed_threshold_{ std::max<std::size_t>(1, row_buffer_size) * 3 / 4 }
+    , rows_{ io_, std::max<std::size_t>(1, row_buffer_size) }
     , lexer_{ pointer_expression, LEXER_DEPTH }
   {
   }
@@ -156,7 +157,7 @@ public:
 private:
   void maybe_feed_lexer()
   {
-    if (feeding_ || received_all_data_ || buffered_row_count_ > ROW_BUFFER_FEED_THRESHOLD) {
+    if (feeding_ || received_all_data_ || buffered_row_count_ > row_buffer_feed_threshold_) {
       return;
     }
 
@@ -193,6 +194,7 @@ private:
 
   asio::io_context& io_;
   http_response_body body_;
+  std::size_t row_buffer_feed_threshold_;
   asio::experimental::concurrent_channel<void(std::error_code,
                                               std::variant<std::string, row_stream_end_signal>)>
     rows_;
@@ -208,8 +210,12 @@ private:
 
 row_streamer::row_streamer(asio::io_context& io,
                            couchbase::core::http_response_body body,
-                           const std::string& pointer_expression)
-  : impl_{ std::make_shared<row_streamer_impl>(io, std::move(body), pointer_expression) }
+                           const std::string& pointer_expression,
+                           std::size_t row_buffer_size)
+  : impl_{ std::make_shared<row_streamer_impl>(io,
+                                               std::move(body),
+                                               pointer_expression,
+                                               row_buffer_size) }
 {
 }
 
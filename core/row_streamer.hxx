@@ -19,6 +19,7 @@
 
 #include "utils/movable_function.hxx"
 
+#include <cstddef>
 #include <memory>
 #include <optional>
 #include <string>
@@ -37,9 +38,16 @@ class http_response_body;
 class row_streamer
 {
 public:
+  static constexpr std::size_t default_row_buffer_size{ 100 };
+
+  /**
+   * @param row_buffer_size maximum number of rows read ahead of the consumer. The body of the
+   * response is not read from the socket while the buffer is full.
+   */
   row_streamer(asio::io_context& io,
                http_response_body body,
-               const std::string& pointer_expression);
+               const std::string& pointer_expression,
+               std::size_t row_buffer_size = default_row_buffer_size);
 
   /**
    *  Starts the row stream and returns all the metadata preceding the first row. This typically
@@ -0,0 +1,157 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2025-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "salted_password_cache.h"
+
+#include <algorithm>
+#include <exception>
+#include <utility>
+
+namespace couchbase::core::sasl::mechanism::scram
+{
+namespace
+{
+void
+wipe(std::string& value)
+{
+  // write through volatile pointer, so that the compiler cannot drop the stores to the memory,
+  // that is about to be released
+  volatile char* data = value.data();
+  for (std::size_t i = 0; i < value.size(); ++i) {
+    data[i] = 0;
+  }
+  value.clear();
+}
+} // namespace
+
+salted_password_cache::secret::secret(std::string value)
+  : value{ std::move(value) }
+{
+}
+
+salted_password_cache::secret::~secret()
+{
+  wipe(value);
+}
+
+salted_password_cache::salted_password_cache(std::size_t capacity)
+  : capacity_{ std::max<std::size_t>(1, capacity) }
+{
+}
+
+auto
+salted_password_cache::instance() -> salted_password_cache&
+{
+  static salted_password_cache cache{};
+  return cache;
+}
+
+auto
+salted_password_cache::get(crypto::Algorithm algorithm,
+                           const std::string& username,
+                           const std::string& password,
+                           std::string_view salt,
+                           unsigned int iteration_count) -> std::string
+{
+  key_type key{ algorithm,
+                username,
+                crypto::digest(crypto::Algorithm::ALG_SHA256, password),
+                std::string{ salt },
+                iteration_count };
+
+  std::promise<std::shared_ptr<const secret>> barrier;
+  std::uint64_t derivation{};
+  {
+    std::unique_lock lock(mutex_);
+    if (auto it = entries_.find(key); it != entries_.end()) {
+      it->second.last_used = ++clock_;
+      auto salted_password = it->second.salted_password;
+      lock.unlock();
+      // the derivation might be still in progress in another thread
+      return salted_password.get()->value;
+    }
+    if (entries_.size() >= capacity_) {
+      evict_least_recently_used();
+    }
+    derivation = ++derivations_;
+    entries_.try_emplace(key, entry{ barrier.get_future().share(), ++clock_, derivation });
+  }
+
+  try {
+    auto salted_password = std::make_shared<const secret>(
+      crypto::PBKDF2_HMAC(algorithm, password, salt, iteration_count));
+    barrier.set_value(salted_password);
+    return salted_password->value;
+  } catch (...) {
+    barrier.set_exception(std::current_exception());
+    {
+      // the entry might have been evicted or invalidated meanwhile, and replaced by another thread
+      const std::scoped_lock lock(mutex_);
+      if (auto it = entries_.find(key);
+          it != entries_.end() && it->second.derivation == derivation) {
+        entries_.erase(it);
+      }
+    }
+    throw;
+  }
+}
+
+void
+salted_password_cache::invalidate(const std::string& username)
+{
+  const std::scoped_lock lock(mutex_);
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    if (std::get<1>(it->first) == username) {
+      it = entries_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void
+salted_password_cache::clear()
+{
+  const std::scoped_lock lock(mutex_);
+  entries_.clear();
+}
+
+auto
+salted_password_cache::size() const -> std::size_t
+{
+  const std::scoped_lock lock(mutex_);
+  return entries_.size();
+}
+
+auto
+salted_password_cache::derivations() const -> std::uint64_t
+{
+  const std::scoped_lock lock(mutex_);
+  return derivations_;
+}
+
+void
+salted_password_cache::evict_least_recently_used()
+{
+  auto oldest = std::min_element(entries_.begin(), entries_.end(), [](const auto& a, const auto& b) {
+    return a.second.last_used < b.second.last_used;
+  });
+  if (oldest != entries_.end()) {
+    entries_.erase(oldest);
+  }
+}
+} // namespace couchbase::core::sasl::mechanism::scram
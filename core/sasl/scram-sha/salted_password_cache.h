@@ -0,0 +1,112 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2025-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include "core/crypto/cbcrypto.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <tuple>
+
+namespace couchbase::core::sasl::mechanism::scram
+{
+/**
+ * Process-wide cache of the SCRAM salted passwords (results of PBKDF2), so that the sessions
+ * that authenticate the same user against the same server secret (salt and iteration count) do
+ * not have to repeat the expensive key derivation. Without the cache every connection bootstrap
+ * and every reauthentication recomputes it, which serializes reconnects after failover.
+ *
+ * The password itself is never stored, the entries are keyed by its digest. The cached values are
+ * wiped from memory as soon as they are evicted or invalidated and no longer in use.
+ *
+ * Concurrent requests for the same entry wait for the single derivation instead of running it in
+ * parallel.
+ */
+class salted_password_cache
+{
+public:
+  static constexpr std::size_t default_capacity{ 64 };
+
+  explicit salted_password_cache(std::size_t capacity = default_capacity);
+
+  [[nodiscard]] static auto instance() -> salted_password_cache&;
+
+  /**
+   * Returns the salted password, computing it with PBKDF2 if it is not cached yet.
+   *
+   * @throws std::invalid_argument - unsupported algorithm
+   *         std::runtime_error - Failures generating the HMAC
+   */
+  [[nodiscard]] auto get(crypto::Algorithm algorithm,
+                         const std::string& username,
+                         const std::string& password,
+                         std::string_view salt,
+                         unsigned int iteration_count) -> std::string;
+
+  /**
+   * Removes all entries of the user, e.g. when the credentials have been updated.
+   */
+  void invalidate(const std::string& username);
+
+  void clear();
+
+  [[nodiscard]] auto size() const -> std::size_t;
+
+  /**
+   * @return number of the key derivations performed by the cache
+   */
+  [[nodiscard]] auto derivations() const -> std::uint64_t;
+
+private:
+  /// the salted password, that is wiped from memory once the last reference is gone
+  struct secret {
+    explicit secret(std::string value);
+    secret(const secret&) = delete;
+    secret(secret&&) = delete;
+    auto operator=(const secret&) -> secret& = delete;
+    auto operator=(secret&&) -> secret& = delete;
+    ~secret();
+
+    std::string value;
+  };
+
+  // algorithm, username, password digest, salt, iteration count
+  using key_type = std::tuple<crypto::Algorithm, std::string, std::string, std::string, unsigned int>;
+
+  struct entry {
+    std::shared_future<std::shared_ptr<const secret>> salted_password;
+    std::uint64_t last_used;
+    /// sequence number of the derivation, that produces the salted password
+    std::uint64_t derivation;
+  };
+
+  void evict_least_recently_used();
+
+  const std::size_t capacity_;
+  mutable std::mutex mutex_{};
+  std::map<key_type, entry> entries_{};
+  std::uint64_t clock_{ 0 };
+  std::uint64_t derivations_{ 0 };
+};
+} // namespace couchbase::core::sasl::mechanism::scram
@@ -16,6 +16,7 @@
  */
 
 #include "scram-sha.h"
+#include "salted_password_cache.h"
 
 #include "core/crypto/cbcrypto.h"
 #include "core/logger/logger.hxx"
@@ -370,7 +371,8 @@ auto
 ClientBackend::generateSaltedPassword(const std::string& secret) -> bool
 {
   try {
-    saltedPassword = couchbase::core::crypto::PBKDF2_HMAC(algorithm, secret, salt, iterationCount);
+    saltedPassword = salted_password_cache::instance().get(
+      algorithm, usernameCallback(), secret, salt, iterationCount);
     return true;
   } catch (...) {
     return false;
@@ -23,11 +23,13 @@ namespace couchbase::core
 tls_context_provider::tls_context_provider()
   : ctx_(std::make_shared<asio::ssl::context>(asio::ssl::context::tls_client))
 {
+  tls_session_cache::enable(ctx_->native_handle());
 }
 
 tls_context_provider::tls_context_provider(std::shared_ptr<asio::ssl::context> ctx)
   : ctx_(std::move(ctx))
 {
+  tls_session_cache::enable(ctx_->native_handle());
 }
 
 auto
@@ -39,6 +41,14 @@ tls_context_provider::get_ctx() const -> std::shared_ptr<asio::ssl::context>
 void
 tls_context_provider::set_ctx(std::shared_ptr<asio::ssl::context> new_ctx)
 {
+  tls_session_cache::enable(new_ctx->native_handle());
   std::atomic_store(&ctx_, std::move(new_ctx));
+  session_cache_->clear();
+}
+
+auto
+tls_context_provider::session_cache() const -> const std::shared_ptr<tls_session_cache>&
+{
+  return session_cache_;
 }
 } // namespace couchbase::core
@@ -15,6 +15,8 @@
 
 #pragma once
 
+#include "tls_session_cache.hxx"
+
 #include <memory>
 
 namespace asio
@@ -35,10 +37,17 @@ public:
 
   explicit tls_context_provider(std::shared_ptr<asio::ssl::context> ctx);
 
+  /**
+   * Replaces the context for the new connections, and forgets the TLS sessions established with
+   * the old one.
+   */
   void set_ctx(std::shared_ptr<asio::ssl::context> new_ctx);
   [[nodiscard]] auto get_ctx() const -> std::shared_ptr<asio::ssl::context>;
 
+  [[nodiscard]] auto session_cache() const -> const std::shared_ptr<tls_session_cache>&;
+
 private:
   std::shared_ptr<asio::ssl::context> ctx_;
+  std::shared_ptr<tls_session_cache> session_cache_{ std::make_shared<tls_session_cache>() };
 };
 } // namespace couchbase::core
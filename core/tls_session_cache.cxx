@@ -0,0 +1,227 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ * Copyright 2025-Present Couchbase, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+ * except in compliance with the License. You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF
+ * ANY KIND, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "tls_session_cache.hxx"
+
+#include <asio/ssl.hpp>
+
+#include <algorithm>
+
+namespace couchbase::core
+{
+namespace
+{
+// attached to every SSL connection prepared by the cache, and released together with it
+struct binding {
+  std::weak_ptr<tls_session_cache> cache{};
+  std::string endpoint{};
+  std::uint64_t generation{ 0 };
+  bool offered_session{ false };
+};
+
+void
+release_binding(void* /* parent */,
+                void* pointer,
+                CRYPTO_EX_DATA* /* data */,
+                int /* index */,
+                long /* argl */,
+                void* /* argp */)
+{
+  delete static_cast<binding*>(pointer);
+}
+
+auto
+binding_index() -> int
+{
+  static const int index = SSL_get_ex_new_index(0, nullptr, nullptr, nullptr, release_binding);
+  return index;
+}
+
+auto
+get_binding(SSL* ssl) -> binding*
+{
+  return static_cast<binding*>(SSL_get_ex_data(ssl, binding_index()));
+}
+} // namespace
+
+tls_session_cache::tls_session_cache(std::size_t capacity)
+  : capacity_{ std::max<std::size_t>(1, capacity) }
+{
+}
+
+tls_session_cache::~tls_session_cache()
+{
+  for (const auto& [endpoint, entry] : sessions_) {
+    SSL_SESSION_free(entry.session);
+  }
+}
+
+void
+tls_session_cache::enable(ssl_ctx_st* ctx)
+{
+  SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+  SSL_CTX_sess_set_new_cb(ctx, on_new_session);
+}
+
+void
+tls_session_cache::prepare(ssl_st* ssl, const std::string& endpoint)
+{
+  auto* state = get_binding(ssl);
+  if (state == nullptr) {
+    auto new_state = std::make_unique<binding>();
+    if (SSL_set_ex_data(ssl, binding_index(), new_state.get()) != 1) {
+      return;
+    }
+    state = new_state.release();
+  }
+  state->cache = weak_from_this();
+  state->endpoint = endpoint;
+
+  const std::scoped_lock lock(mutex_);
+  state->generation = generation_;
+  state->offered_session = false;
+  auto it = sessions_.find(endpoint);
+  if (it == sessions_.end()) {
+    return;
+  }
+  if (SSL_SESSION_is_resumable(it->second.session) != 1) {
+    // the connection, that has used the session, has not been shut down properly
+    SSL_SESSION_free(it->second.session);
+    order_.erase(it->second.position);
+    sessions_.erase(it);
+    return;
+  }
+  state->offered_session = SSL_set_session(ssl, it->second.session) == 1;
+}
+
+void
+tls_session_cache::handshake_completed(ssl_st* ssl, std::error_code ec)
+{
+  const auto* state = get_binding(ssl);
+  if (ec) {
+    if (state != nullptr && state->offered_session) {
+      remove(state->endpoint, state->generation);
+    }
+    return;
+  }
+  const auto resumed = SSL_session_reused(ssl) == 1;
+  const std::scoped_lock lock(mutex_);
+  if (resumed) {
+    ++stats_.resumed_handshakes;
+  } else {
+    ++stats_.full_handshakes;
+  }
+}
+
+auto
+tls_session_cache::holds_session_of(ssl_st* ssl) const -> bool
+{
+  const auto* state = get_binding(ssl);
+  const auto* session = SSL_get_session(ssl);
+  if (state == nullptr || session == nullptr || state->cache.lock().get() != this) {
+    return false;
+  }
+  const std::scoped_lock lock(mutex_);
+  if (state->generation != generation_) {
+    return false;
+  }
+  auto it = sessions_.find(state->endpoint);
+  return it != sessions_.end() && it->second.session == session;
+}
+
+void
+tls_session_cache::clear()
+{
+  const std::scoped_lock lock(mutex_);
+  for (const auto& [endpoint, entry] : sessions_) {
+    SSL_SESSION_free(entry.session);
+  }
+  sessions_.clear();
+  order_.clear();
+  ++generation_;
+}
+
+auto
+tls_session_cache::size() const -> std::size_t
+{
+  const std::scoped_lock lock(mutex_);
+  return sessions_.size();
+}
+
+auto
+tls_session_cache::stats() const -> tls_session_cache_stats
+{
+  const std::scoped_lock lock(mutex_);
+  return stats_;
+}
+
+auto
+tls_session_cache::on_new_session(ssl_st* ssl, ssl_session_st* session) -> int
+{
+  const auto* state = get_binding(ssl);
+  if (state == nullptr) {
+    return 0;
+  }
+  auto cache = state->cache.lock();
+  if (!cache) {
+    return 0;
+  }
+  // returning 1 passes the reference of the session to the cache
+  return cache->store(state->endpoint, state->generation, session) ? 1 : 0;
+}
+
+auto
+tls_session_cache::store(const std::string& endpoint,
+                         std::uint64_t generation,
+                         ssl_session_st* session) -> bool
+{
+  if (SSL_SESSION_is_resumable(session) != 1) {
+    return false;
+  }
+  const std::scoped_lock lock(mutex_);
+  if (generation != generation_) {
+    // the connection has been established before the cache was cleared
+    return false;
+  }
+  if (auto it = sessions_.find(endpoint); it != sessions_.end()) {
+    SSL_SESSION_free(it->second.session);
+    it->second.session = session;
+    order_.splice(order_.end(), order_, it->second.position);
+    return true;
+  }
+  if (sessions_.size() >= capacity_) {
+    auto oldest = sessions_.find(order_.front());
+    SSL_SESSION_free(oldest->second.session);
+    sessions_.erase(oldest);
+    order_.pop_front();
+  }
+  sessions_.try_emplace(endpoint, entry{ session, order_.insert(order_.end(), endpoint) });
+  return true;
+}
+
+void
+tls_session_cache::remove(const std::string& endpoint, std::uint64_t generation)
+{
+  const std::scoped_lock lock(mutex_);
+  if (generation != generation_) {
+    return;
+  }
+  if (auto it = sessions_.find(endpoint); it != sessions_.end()) {
+    SSL_SESSION_free(it->second.session);
+    order_.erase(it->second.position);
+    sessions_.erase(it);
+  }
+}
+} // namespace couchbase::core
@@ -0,0 +1,113 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ * Copyright 2025-Present Couchbase, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+ * except in compliance with the License. You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF
+ * ANY KIND, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <system_error>
+
+struct ssl_st;
+struct ssl_ctx_st;
+struct ssl_session_st;
+
+namespace couchbase::core
+{
+struct tls_session_cache_stats {
+  std::uint64_t full_handshakes{};
+  std::uint64_t resumed_handshakes{};
+};
+
+/**
+ * Client-side cache of the TLS sessions (session tickets or session IDs) keyed by the endpoint, so
+ * that reconnects and new KV or HTTP connections to the same node can resume the session instead
+ * of doing the full handshake.
+ *
+ * The cache is shared by all TLS streams of the cluster through tls_context_provider, and the
+ * SSL contexts have to be prepared with enable() to deliver the new sessions to it.
+ */
+class tls_session_cache : public std::enable_shared_from_this<tls_session_cache>
+{
+public:
+  static constexpr std::size_t default_capacity{ 1024 };
+
+  explicit tls_session_cache(std::size_t capacity = default_capacity);
+  tls_session_cache(const tls_session_cache&) = delete;
+  tls_session_cache(tls_session_cache&&) = delete;
+  auto operator=(const tls_session_cache&) -> tls_session_cache& = delete;
+  auto operator=(tls_session_cache&&) -> tls_session_cache& = delete;
+  ~tls_session_cache();
+
+  /**
+   * Configures the SSL context to hand out the client sessions to the cache of the connection,
+   * instead of the internal store of the SSL library.
+   */
+  static void enable(ssl_ctx_st* ctx);
+
+  /**
+   * Offers the cached session of the endpoint to the connection, and binds the connection to the
+   * cache, so that the sessions issued by the server will be stored for the endpoint.
+   *
+   * Must be called before the handshake.
+   */
+  void prepare(ssl_st* ssl, const std::string& endpoint);
+
+  /**
+   * Records the outcome of the handshake. The session of the endpoint is dropped if the handshake
+   * has failed, as it might be the reason of the failure.
+   */
+  void handshake_completed(ssl_st* ssl, std::error_code ec);
+
+  /**
+   * @return true if the current session of the connection is the one cached for its endpoint,
+   * i.e. the next connection to the endpoint would try to resume it.
+   */
+  [[nodiscard]] auto holds_session_of(ssl_st* ssl) const -> bool;
+
+  /**
+   * Forgets all sessions, e.g. when the TLS configuration or credentials have been changed. The
+   * sessions issued later for the connections that were established before are ignored.
+   */
+  void clear();
+
+  [[nodiscard]] auto size() const -> std::size_t;
+  [[nodiscard]] auto stats() const -> tls_session_cache_stats;
+
+private:
+  static auto on_new_session(ssl_st* ssl, ssl_session_st* session) -> int;
+
+  auto store(const std::string& endpoint, std::uint64_t generation, ssl_session_st* session)
+    -> bool;
+  void remove(const std::string& endpoint, std::uint64_t generation);
+
+  struct entry {
+    ssl_session_st* session;
+    std::list<std::string>::iterator position;
+  };
+
+  const std::size_t capacity_;
+  mutable std::mutex mutex_{};
+  std::map<std::string, entry> sessions_{};
+  // endpoints from the least to the most recently stored
+  std::list<std::string> order_{};
+  std::uint64_t generation_{ 0 };
+  tls_session_cache_stats stats_{};
+};
+} // namespace couchbase::core
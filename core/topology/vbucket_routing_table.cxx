@@ -0,0 +1,69 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2025-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "vbucket_routing_table.hxx"
+
+#include "configuration.hxx"
+#include "core/utils/crc32.hxx"
+
+#include <algorithm>
+
+namespace couchbase::core::topology
+{
+vbucket_routing_table::vbucket_routing_table(const configuration& config)
+{
+  if (!config.vbmap.has_value() || config.vbmap->empty()) {
+    return;
+  }
+  const auto& vbmap = config.vbmap.value();
+  number_of_vbuckets_ = vbmap.size();
+  for (const auto& row : vbmap) {
+    row_size_ = std::max(row_size_, row.size());
+  }
+  // rows shorter than the widest one are padded with -1, which means "no server"
+  map_.resize(number_of_vbuckets_ * row_size_, -1);
+  for (std::size_t vbucket = 0; vbucket < number_of_vbuckets_; ++vbucket) {
+    std::copy(vbmap[vbucket].begin(),
+              vbmap[vbucket].end(),
+              map_.begin() + static_cast<std::ptrdiff_t>(vbucket * row_size_));
+  }
+}
+
+auto
+vbucket_routing_table::map_key(const std::string& key, std::size_t index) const
+  -> std::pair<std::uint16_t, std::optional<std::size_t>>
+{
+  if (empty()) {
+    return { 0, {} };
+  }
+  const std::uint32_t crc = utils::hash_crc32(key.data(), key.size());
+  auto vbucket = static_cast<std::uint16_t>(crc % number_of_vbuckets_);
+  return { vbucket, server_by_vbucket(vbucket, index) };
+}
+
+auto
+vbucket_routing_table::map_key(const std::vector<std::byte>& key, std::size_t index) const
+  -> std::pair<std::uint16_t, std::optional<std::size_t>>
+{
+  if (empty()) {
+    return { 0, {} };
+  }
+  const std::uint32_t crc = utils::hash_crc32(key.data(), key.size());
+  auto vbucket = static_cast<std::uint16_t>(crc % number_of_vbuckets_);
+  return { vbucket, server_by_vbucket(vbucket, index) };
+}
+} // namespace couchbase::core::topology
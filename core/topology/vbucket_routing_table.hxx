@@ -0,0 +1,78 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2025-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace couchbase::core::topology
+{
+struct configuration;
+
+/**
+ * Immutable snapshot of the partition map of the bucket configuration.
+ *
+ * The map is stored as a single contiguous array with a row of (replicas + 1) node indexes per
+ * vbucket, so that routing of the key is one CRC32 and one array load. Instances are published by
+ * the bucket on configuration update, and never modified afterwards, which allows reading them
+ * without taking the configuration lock.
+ */
+class vbucket_routing_table
+{
+public:
+  vbucket_routing_table() = default;
+  explicit vbucket_routing_table(const configuration& config);
+
+  [[nodiscard]] auto empty() const -> bool
+  {
+    return number_of_vbuckets_ == 0;
+  }
+
+  [[nodiscard]] auto number_of_vbuckets() const -> std::size_t
+  {
+    return number_of_vbuckets_;
+  }
+
+  [[nodiscard]] auto map_key(const std::string& key, std::size_t index) const
+    -> std::pair<std::uint16_t, std::optional<std::size_t>>;
+  [[nodiscard]] auto map_key(const std::vector<std::byte>& key, std::size_t index) const
+    -> std::pair<std::uint16_t, std::optional<std::size_t>>;
+
+  [[nodiscard]] auto server_by_vbucket(std::uint16_t vbucket, std::size_t index) const
+    -> std::optional<std::size_t>
+  {
+    if (vbucket >= number_of_vbuckets_ || index >= row_size_) {
+      return {};
+    }
+    if (auto server_index = map_[(static_cast<std::size_t>(vbucket) * row_size_) + index];
+        server_index >= 0) {
+      return static_cast<std::size_t>(server_index);
+    }
+    return {};
+  }
+
+private:
+  std::size_t number_of_vbuckets_{ 0 };
+  std::size_t row_size_{ 0 };
+  std::vector<std::int16_t> map_{};
+};
+} // namespace couchbase::core::topology
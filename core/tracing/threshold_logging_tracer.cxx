@@ -24,7 +24,7 @@
 #include "core/meta/version.hxx"
 #include "core/platform/uuid.h"
 #include "core/service_type_fmt.hxx"
-#include "core/utils/concurrent_fixed_priority_queue.hxx"
+#include "core/utils/concurrent_top_n_sampler.hxx"
 #include "core/utils/json.hxx"
 
 #include <asio/steady_timer.hpp>
@@ -201,7 +201,7 @@ public:
   }
 };
 
-using fixed_span_queue = utils::concurrent_fixed_priority_queue<reported_span>;
+using fixed_span_queue = utils::concurrent_top_n_sampler<reported_span>;
 
 auto
 convert(const std::shared_ptr<threshold_logging_span>& span) -> reported_span
@@ -278,7 +278,10 @@ public:
     if (span->total_duration() > options_.threshold_for_service(service.value())) {
       if (const auto queue = threshold_queues_.find(service.value());
           queue != threshold_queues_.end()) {
-        queue->second.emplace(convert(span));
+        // the span is converted into JSON only if it is slow enough to make it into the report
+        queue->second.offer(span->total_duration().count(), [&span]() {
+          return convert(span);
+        });
       }
     }
   }
@@ -302,9 +305,9 @@ private:
       if (threshold_queue.empty()) {
         continue;
       }
-      auto [queue, _] = threshold_queue.steal_data();
+      auto [spans, _] = threshold_queue.steal_data();
       tao::json::value report{
-        { "count", queue.size() },
+        { "count", spans.size() },
         { "service", fmt::format("{}", service) },
 #if COUCHBASE_CXX_CLIENT_DEBUG_BUILD
         { "emit_interval_ms", options_.threshold_emit_interval.count() },
@@ -316,9 +319,8 @@ private:
 #endif
       };
       tao::json::value entries = tao::json::empty_array;
-      while (!queue.empty()) {
-        entries.emplace_back(queue.top().payload);
-        queue.pop();
+      for (auto& span : spans) {
+        entries.emplace_back(std::move(span.payload));
       }
       report["top"] = entries;
       CB_LOG_WARNING("Operations over threshold: {}", utils::json::generate(report));
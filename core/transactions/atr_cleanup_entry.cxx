@@ -477,6 +477,12 @@ atr_cleanup_entry::ready() const -> bool
   return std::chrono::steady_clock::now() > min_start_time_;
 }
 
+auto
+atr_cleanup_entry::expired() const -> bool
+{
+  return atr_entry_ != nullptr && atr_entry_->has_expired(safety_margin_ms_);
+}
+
 auto
 atr_cleanup_queue::pop(bool check_time) -> std::optional<atr_cleanup_entry>
 {
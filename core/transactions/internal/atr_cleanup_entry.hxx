@@ -93,6 +93,8 @@ public:
 
   void clean(transactions_cleanup_attempt* result = nullptr);
   [[nodiscard]] auto ready() const -> bool;
+  // true if the entry has been constructed from the ATR entry, that has expired
+  [[nodiscard]] auto expired() const -> bool;
   [[nodiscard]] auto atr_id() const -> couchbase::core::document_id
   {
     return atr_id_;
@@ -0,0 +1,110 @@
+/*
+ *     Copyright 2025-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+
+namespace couchbase::core::transactions
+{
+/**
+ * Limits the ATR reads of the lost attempts cleanup. The limits are shared by all collections
+ * (and buckets) that are being cleaned:
+ *  - at most max_in_flight reads are outstanding at any time,
+ *  - at most max_per_second reads are started per second (token bucket, that allows bursts of up
+ *    to one second worth of reads). Zero disables this limit.
+ */
+class atr_read_limiter
+{
+public:
+  using clock = std::chrono::steady_clock;
+
+  atr_read_limiter(std::size_t max_in_flight,
+                   std::size_t max_per_second,
+                   clock::time_point now = clock::now())
+    : max_in_flight_{ std::max<std::size_t>(1, max_in_flight) }
+    , max_per_second_{ max_per_second }
+    , tokens_{ static_cast<double>(max_per_second) }
+    , last_refill_{ now }
+  {
+  }
+
+  /**
+   * Tries to start a read.
+   *
+   * @param now current time
+   * @param retry_after receives time to wait before the rate allows next read. It is zero when
+   * the read is throttled by the number of reads in flight, in which case the caller should wait
+   * for @ref release().
+   * @return true if the read can be started, and must be followed by @ref release()
+   */
+  auto try_acquire(clock::time_point now, clock::duration& retry_after) -> bool
+  {
+    const std::scoped_lock lock(mutex_);
+    retry_after = clock::duration::zero();
+    if (in_flight_ >= max_in_flight_) {
+      return false;
+    }
+    if (max_per_second_ > 0) {
+      refill(now);
+      if (tokens_ < 1.0) {
+        retry_after = std::chrono::duration_cast<clock::duration>(
+          std::chrono::duration<double>((1.0 - tokens_) / static_cast<double>(max_per_second_)));
+        retry_after = std::max(retry_after, clock::duration{ 1 });
+        return false;
+      }
+      tokens_ -= 1.0;
+    }
+    ++in_flight_;
+    return true;
+  }
+
+  void release()
+  {
+    const std::scoped_lock lock(mutex_);
+    if (in_flight_ > 0) {
+      --in_flight_;
+    }
+  }
+
+  [[nodiscard]] auto in_flight() const -> std::size_t
+  {
+    const std::scoped_lock lock(mutex_);
+    return in_flight_;
+  }
+
+private:
+  void refill(clock::time_point now)
+  {
+    if (now <= last_refill_) {
+      return;
+    }
+    const std::chrono::duration<double> elapsed = now - last_refill_;
+    tokens_ = std::min(static_cast<double>(max_per_second_),
+                       tokens_ + elapsed.count() * static_cast<double>(max_per_second_));
+    last_refill_ = now;
+  }
+
+  const std::size_t max_in_flight_;
+  const std::size_t max_per_second_;
+  std::size_t in_flight_{ 0 };
+  double tokens_;
+  clock::time_point last_refill_;
+  mutable std::mutex mutex_{};
+};
+} // namespace couchbase::core::transactions
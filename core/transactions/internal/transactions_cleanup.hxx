@@ -23,7 +23,10 @@
 #include <couchbase/transactions/transactions_config.hxx>
 
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <list>
+#include <memory>
 #include <thread>
 
 namespace couchbase::core
@@ -32,6 +35,10 @@ namespace couchbase::core
 class cluster;
 namespace transactions
 {
+class active_transaction_record;
+struct lost_attempts_cleanup_state;
+struct lost_attempts_pass;
+
 // only really used when we force cleanup, in tests
 class transactions_cleanup_attempt
 {
@@ -84,6 +91,26 @@ public:
 struct atr_cleanup_stats {
   bool exists{};
   std::size_t num_entries{};
+  std::size_t num_cleaned{};
+  std::size_t num_failed{};
+};
+
+/**
+ * Counters of the lost attempts cleanup, accumulated over all collections since the start.
+ */
+struct lost_attempts_cleanup_stats {
+  // number of passes over the ATRs of a collection, that have been completed
+  std::size_t passes_completed{};
+  // duration of the most recently completed pass
+  std::chrono::milliseconds last_pass_duration{};
+  std::size_t atrs_read{};
+  std::size_t atr_read_failures{};
+  // expired attempts, that have been cleaned up successfully
+  std::size_t attempts_cleaned{};
+  std::size_t attempts_failed{};
+  // ATRs of the current passes, that have not been read yet
+  std::size_t backlog{};
+  std::size_t atr_reads_in_flight{};
 };
 
 class transactions_cleanup
@@ -132,6 +159,7 @@ public:
   auto get_active_clients(const couchbase::transactions::transaction_keyspace& keyspace,
                           const std::string& uuid) -> client_record_details;
   void remove_client_record_from_all_buckets(const std::string& uuid);
+  [[nodiscard]] auto lost_attempts_stats() const -> lost_attempts_cleanup_stats;
   void start();
   void stop();
   void close();
@@ -145,7 +173,8 @@ private:
   atr_cleanup_queue atr_queue_;
   mutable std::condition_variable cv_;
   mutable std::mutex mutex_;
-  std::list<std::thread> lost_attempt_cleanup_workers_;
+  std::thread lost_attempts_thr_;
+  std::shared_ptr<lost_attempts_cleanup_state> lost_attempts_;
 
   const std::string client_uuid_;
   std::list<couchbase::transactions::transaction_keyspace> collections_;
@@ -162,11 +191,18 @@ private:
   auto interruptable_wait(std::chrono::duration<R, P> time) -> bool;
 
   void lost_attempts_loop();
-  void clean_collection(const couchbase::transactions::transaction_keyspace& keyspace);
+  void lost_attempts_worker(const couchbase::transactions::transaction_keyspace& keyspace);
+  auto start_lost_attempts_pass(lost_attempts_pass& pass) -> bool;
+  void read_atr(const couchbase::transactions::transaction_keyspace& keyspace,
+                const std::string& atr_id);
   void create_client_record(const couchbase::transactions::transaction_keyspace& keyspace);
   auto handle_atr_cleanup(const core::document_id& atr_id,
                           std::vector<transactions_cleanup_attempt>* result = nullptr)
     -> atr_cleanup_stats;
+  auto clean_atr_entries(const core::document_id& atr_id,
+                         const active_transaction_record& atr,
+                         std::vector<transactions_cleanup_attempt>* results = nullptr)
+    -> atr_cleanup_stats;
   bool running_{ false };
 };
 } // namespace transactions
@@ -20,19 +20,30 @@
 #include "cleanup_testing_hooks.hxx"
 #include "uid_generator.hxx"
 
+#include "internal/atr_read_limiter.hxx"
 #include "internal/client_record.hxx"
 #include "internal/logging.hxx"
 #include "internal/transaction_fields.hxx"
 #include "internal/transactions_cleanup.hxx"
 #include "internal/utils.hxx"
 
+#include "core/metrics/meter_wrapper.hxx"
 #include "core/operations.hxx"
 #include "core/utils/byteswap.hxx"
 
 #include <couchbase/fmt/transaction_keyspace.hxx>
 
+#include <tao/json/value.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
 #include <functional>
+#include <list>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
 #include <utility>
 
 namespace couchbase::core::transactions
@@ -101,92 +112,264 @@ transactions_cleanup::interruptable_wait(std::chrono::duration<R, P> time) -> bo
   return running_;
 }
 
+/**
+ * State of the lost attempts cleanup, that is shared with the completion handlers of the ATR reads.
+ * The handlers might outlive the cleanup object, so they never refer to it directly.
+ */
+struct lost_attempts_cleanup_state {
+  struct completed_read {
+    couchbase::transactions::transaction_keyspace keyspace;
+    core::document_id atr_id;
+    std::error_code ec;
+    std::optional<active_transaction_record> atr;
+  };
+
+  lost_attempts_cleanup_state(std::size_t max_concurrent_atr_reads,
+                              std::size_t max_atr_reads_per_second)
+    : limiter{ max_concurrent_atr_reads, max_atr_reads_per_second }
+  {
+  }
+
+  atr_read_limiter limiter;
+  std::mutex mutex{};
+  std::condition_variable cv{};
+  bool stopped{ false };
+  bool collections_changed{ false };
+  std::list<completed_read> completed_reads{};
+  lost_attempts_cleanup_stats stats{};
+
+  auto snapshot() -> lost_attempts_cleanup_stats
+  {
+    const std::scoped_lock lock(mutex);
+    auto result = stats;
+    result.atr_reads_in_flight = limiter.in_flight();
+    return result;
+  }
+};
+
+/**
+ * Pass over the ATRs of the collection, that are assigned to this client. The reads of the ATRs are
+ * spread evenly over the cleanup window.
+ */
+struct lost_attempts_pass {
+  explicit lost_attempts_pass(couchbase::transactions::transaction_keyspace ks)
+    : keyspace{ std::move(ks) }
+  {
+  }
+
+  couchbase::transactions::transaction_keyspace keyspace;
+  bool active{ false };
+  std::vector<std::string> atr_ids{};
+  std::size_t next_atr{ 0 };
+  std::size_t reads_in_flight{ 0 };
+  std::chrono::steady_clock::time_point started{};
+  std::chrono::steady_clock::duration interval{};
+  std::chrono::steady_clock::time_point next_start{};
+};
+
+auto
+transactions_cleanup::start_lost_attempts_pass(lost_attempts_pass& pass) -> bool
+{
+  CB_LOST_ATTEMPT_CLEANUP_LOG_INFO("cleanup for {} starting", pass.keyspace);
+  try {
+    auto details = get_active_clients(pass.keyspace, client_uuid_);
+    const auto& all_atrs = atr_ids::all();
+    const std::size_t stride = std::max<std::size_t>(1, details.num_active_clients);
+
+    pass.atr_ids.clear();
+    for (std::size_t idx = details.index_of_this_client; idx < all_atrs.size(); idx += stride) {
+      pass.atr_ids.emplace_back(all_atrs[idx]);
+    }
+    CB_LOST_ATTEMPT_CLEANUP_LOG_INFO(
+      "{} active clients (including this one), {} ATRs to check in {}ms",
+      details.num_active_clients,
+      pass.atr_ids.size(),
+      config_.cleanup_config.cleanup_window.count());
+
+    pass.active = true;
+    pass.next_atr = 0;
+    pass.started = std::chrono::steady_clock::now();
+    pass.interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                      config_.cleanup_config.cleanup_window) /
+                    static_cast<std::chrono::steady_clock::rep>(
+                      std::max<std::size_t>(1, pass.atr_ids.size()));
+    return true;
+  } catch (const std::exception& ex) {
+    // we must have gotten an exception trying to get the client records.   Let's wait 3 sec and
+    // try again
+    CB_LOST_ATTEMPT_CLEANUP_LOG_ERROR(
+      "cleanup of {} failed with {}, trying again in 3 sec...", pass.keyspace, ex.what());
+    pass.next_start = std::chrono::steady_clock::now() + std::chrono::seconds(3);
+    return false;
+  }
+}
+
+void
+transactions_cleanup::read_atr(const couchbase::transactions::transaction_keyspace& keyspace,
+                               const std::string& atr_id)
+{
+  core::document_id id{ keyspace.bucket, keyspace.scope, keyspace.collection, atr_id };
+  active_transaction_record::get_atr(
+    cluster_,
+    id,
+    [state = lost_attempts_, keyspace, id](std::error_code ec,
+                                           std::optional<active_transaction_record> atr) mutable {
+      state->limiter.release();
+      {
+        const std::scoped_lock lock(state->mutex);
+        state->completed_reads.push_back(
+          { std::move(keyspace), std::move(id), ec, std::move(atr) });
+      }
+      state->cv.notify_all();
+    });
+}
+
+void
+transactions_cleanup::lost_attempts_loop()
+{
+  CB_LOST_ATTEMPT_CLEANUP_LOG_DEBUG("lost attempts cleanup loop starting...");
+  const auto state = lost_attempts_;
+  // every collection is cleaned by its own worker, as the reads of the client record and the
+  // cleanup of the entries are blocking, and must not hold back the other collections
+  std::list<std::pair<couchbase::transactions::transaction_keyspace, std::thread>> workers;
+
+  while (is_running()) {
+    for (const auto& keyspace : collections()) {
+      if (std::none_of(workers.begin(), workers.end(), [&keyspace](const auto& worker) {
+            return worker.first == keyspace;
+          })) {
+        workers.emplace_back(keyspace, std::thread([this, keyspace]() {
+                               lost_attempts_worker(keyspace);
+                             }));
+      }
+    }
+
+    std::unique_lock lock(state->mutex);
+    state->cv.wait(lock, [&state]() {
+      return state->stopped || state->collections_changed;
+    });
+    state->collections_changed = false;
+  }
+  for (auto& [keyspace, worker] : workers) {
+    worker.join();
+  }
+  CB_LOST_ATTEMPT_CLEANUP_LOG_DEBUG("lost attempts cleanup loop stopping");
+}
+
 void
-transactions_cleanup::clean_collection(
+transactions_cleanup::lost_attempts_worker(
   const couchbase::transactions::transaction_keyspace& keyspace)
 {
-  // first make sure the collection is in the list
+  CB_LOST_ATTEMPT_CLEANUP_LOG_DEBUG("lost attempts cleanup of {} starting...", keyspace);
+  const auto state = lost_attempts_;
+  lost_attempts_pass pass{ keyspace };
+  std::size_t reported_backlog{ 0 };
+
   while (is_running()) {
+    std::list<lost_attempts_cleanup_state::completed_read> completed_reads;
     {
-      const std::scoped_lock<std::mutex> lock(mutex_);
-      if (collections_.end() == std::find(collections_.begin(), collections_.end(), keyspace)) {
-        CB_LOST_ATTEMPT_CLEANUP_LOG_DEBUG(
-          "cleanup for {} ending, no longer in collection cleanup list", keyspace);
-        return;
+      const std::scoped_lock lock(state->mutex);
+      for (auto read = state->completed_reads.begin(); read != state->completed_reads.end();) {
+        auto next = std::next(read);
+        if (read->keyspace == keyspace) {
+          completed_reads.splice(completed_reads.end(), state->completed_reads, read);
+        }
+        read = next;
       }
     }
-    CB_LOST_ATTEMPT_CLEANUP_LOG_INFO("cleanup for {} starting", keyspace);
-    // we are running, and collection is in the list, so lets clean it.
-    try {
-      auto details = get_active_clients(keyspace, client_uuid_);
-
-      auto all_atrs = atr_ids::all();
-
-      const auto cleanup_window = std::chrono::duration_cast<std::chrono::microseconds>(
-        config_.cleanup_config.cleanup_window);
-      auto start = std::chrono::steady_clock::now();
-      CB_LOST_ATTEMPT_CLEANUP_LOG_INFO(
-        "{} active clients (including this one), {} ATRs to check in {}ms",
-        details.num_active_clients,
-        all_atrs.size(),
-        config_.cleanup_config.cleanup_window.count());
-
-      for (auto it = all_atrs.begin() + details.index_of_this_client; it < all_atrs.end();
-           it += details.num_active_clients) {
-        auto atrs_left_for_this_client =
-          std::distance(it, all_atrs.end()) /
-          std::max<decltype(it)::difference_type>(1, details.num_active_clients);
-        const auto now = std::chrono::steady_clock::now();
-        const auto elapsed_in_cleanup_window =
-          std::chrono::duration_cast<std::chrono::microseconds>(now - start);
-        const auto remaining_in_cleanup_window = cleanup_window - elapsed_in_cleanup_window;
-        const auto budget_for_this_atr = std::chrono::microseconds(
-          remaining_in_cleanup_window.count() /
-          std::max<decltype(it)::difference_type>(1, atrs_left_for_this_client));
-        // clean the ATR entry
-        std::string atr_id = *it;
-        if (!is_running()) {
-          CB_LOST_ATTEMPT_CLEANUP_LOG_DEBUG("cleanup of {} complete", keyspace);
-          return;
-        }
+    for (auto& read : completed_reads) {
+      if (!is_running()) {
+        break;
+      }
+      --pass.reads_in_flight;
+      atr_cleanup_stats atr_stats{};
+      if (read.ec) {
+        CB_LOST_ATTEMPT_CLEANUP_LOG_ERROR(
+          "cleanup of atr {} failed with {}, moving on", read.atr_id.key(), read.ec.message());
+      } else if (read.atr) {
+        atr_stats = clean_atr_entries(read.atr_id, read.atr.value());
+      }
+      const std::scoped_lock lock(state->mutex);
+      if (read.ec) {
+        ++state->stats.atr_read_failures;
+      } else {
+        ++state->stats.atrs_read;
+      }
+      state->stats.attempts_cleaned += atr_stats.num_cleaned;
+      state->stats.attempts_failed += atr_stats.num_failed;
+    }
 
-        try {
-          handle_atr_cleanup({ keyspace.bucket, keyspace.scope, keyspace.collection, atr_id });
-        } catch (const std::exception& e) {
-          CB_LOST_ATTEMPT_CLEANUP_LOG_ERROR(
-            "cleanup of atr {} failed with {}, moving on", atr_id, e.what());
+    auto now = std::chrono::steady_clock::now();
+    auto wake_up = now + config_.cleanup_config.cleanup_window;
+    if (!pass.active && now >= pass.next_start && is_running()) {
+      start_lost_attempts_pass(pass);
+      now = std::chrono::steady_clock::now();
+    }
+    if (!pass.active) {
+      wake_up = std::min(wake_up, pass.next_start);
+    } else {
+      while (pass.next_atr < pass.atr_ids.size() && is_running()) {
+        const auto due =
+          pass.started +
+          pass.interval * static_cast<std::chrono::steady_clock::rep>(pass.next_atr);
+        if (due > now) {
+          wake_up = std::min(wake_up, due);
+          break;
         }
-
-        const auto atr_end = std::chrono::steady_clock::now();
-        const auto atr_used = std::chrono::duration_cast<std::chrono::microseconds>(atr_end - now);
-        const auto atr_left = budget_for_this_atr - atr_used;
-
-        // Too verbose to log, but leaving here commented as it may be useful later for internal
-        // debugging
-        /*CB_LOST_ATTEMPT_CLEANUP_LOG_INFO("{} {} atrs_left_for_this_client={}
-           elapsed_in_cleanup_window={}us " "remaining_in_cleanup_window={}us
-           budget_for_this_atr={}us atr_used={}us atr_left={}us", bucket_name, atr_id,
-           atrs_left_for_this_client, elapsed_in_cleanup_window.count(),
-                                    remaining_in_cleanup_window.count(),
-                                    budget_for_this_atr.count(),
-                                    atr_used.count(),
-                                    atr_left.count());*/
-
-        if (atr_left.count() > 0 &&
-            atr_left.count() < 1000000000) { // safety check protects against bugs
-          if (!interruptable_wait(atr_left)) {
-            return;
+        std::chrono::steady_clock::duration retry_after{};
+        if (!state->limiter.try_acquire(now, retry_after)) {
+          // zero means that the completion of the read in flight will wake us up
+          if (retry_after > std::chrono::steady_clock::duration::zero()) {
+            wake_up = std::min(wake_up, now + retry_after);
           }
+          break;
         }
+        read_atr(pass.keyspace, pass.atr_ids[pass.next_atr]);
+        ++pass.next_atr;
+        ++pass.reads_in_flight;
+      }
+
+      if (pass.next_atr == pass.atr_ids.size() && pass.reads_in_flight == 0) {
+        const auto duration =
+          std::chrono::duration_cast<std::chrono::milliseconds>(now - pass.started);
+        pass.active = false;
+        pass.next_start = std::max(now, pass.started + config_.cleanup_config.cleanup_window);
+        wake_up = std::min(wake_up, pass.next_start);
+        const std::scoped_lock lock(state->mutex);
+        ++state->stats.passes_completed;
+        state->stats.last_pass_duration = duration;
+        CB_LOST_ATTEMPT_CLEANUP_LOG_DEBUG(
+          "cleanup of {} complete in {}ms, {} attempts cleaned, {} failed in total",
+          pass.keyspace,
+          duration.count(),
+          state->stats.attempts_cleaned,
+          state->stats.attempts_failed);
       }
-    } catch (const std::exception& ex) {
-      CB_LOST_ATTEMPT_CLEANUP_LOG_ERROR("cleanup failed with {}, trying again in 3 sec...",
-                                        ex.what());
-      // we must have gotten an exception trying to get the client records.   Let's wait 3 sec and
-      // try again
-      std::this_thread::sleep_for(std::chrono::seconds(3));
     }
+
+    const std::size_t backlog = pass.atr_ids.size() - pass.next_atr;
+    std::unique_lock lock(state->mutex);
+    state->stats.backlog = state->stats.backlog + backlog - reported_backlog;
+    reported_backlog = backlog;
+    state->cv.wait_until(lock, wake_up, [&state, &keyspace]() {
+      return state->stopped ||
+             std::any_of(state->completed_reads.begin(),
+                         state->completed_reads.end(),
+                         [&keyspace](const auto& read) {
+                           return read.keyspace == keyspace;
+                         });
+    });
+  }
+  CB_LOST_ATTEMPT_CLEANUP_LOG_DEBUG("lost attempts cleanup of {} stopping", keyspace);
+}
+
+auto
+transactions_cleanup::lost_attempts_stats() const -> lost_attempts_cleanup_stats
+{
+  if (!lost_attempts_) {
+    return {};
   }
+  return lost_attempts_->snapshot();
 }
 
 auto
@@ -194,31 +377,45 @@ transactions_cleanup::handle_atr_cleanup(const core::document_id& atr_id,
                                          std::vector<transactions_cleanup_attempt>* results)
   -> atr_cleanup_stats
 {
-  atr_cleanup_stats stats;
   auto atr = active_transaction_record::get_atr(cluster_, atr_id);
-  if (atr) {
-    // ok, loop through the attempts and clean them all.  The entry will
-    // check if expired, nothing much to do here except call clean.
-    stats.exists = true;
-    stats.num_entries = atr->entries().size();
-    for (const auto& entry : atr->entries()) {
-      // If we were passed results, then we are testing, and want to set the
-      // check_if_expired to false.
-      atr_cleanup_entry cleanup_entry(entry, atr_id, *this, results == nullptr);
-      try {
-        if (results != nullptr) {
-          results->emplace_back(cleanup_entry);
-        }
-        cleanup_entry.clean(results != nullptr ? &results->back() : nullptr);
-        if (results != nullptr) {
-          results->back().success(true);
-        }
-      } catch (const std::exception& e) {
-        CB_LOST_ATTEMPT_CLEANUP_LOG_ERROR(
-          "cleanup of {} failed: {}, moving on", cleanup_entry, e.what());
-        if (results != nullptr) {
-          results->back().success(false);
-        }
+  if (!atr) {
+    return {};
+  }
+  return clean_atr_entries(atr_id, atr.value(), results);
+}
+
+auto
+transactions_cleanup::clean_atr_entries(const core::document_id& atr_id,
+                                        const active_transaction_record& atr,
+                                        std::vector<transactions_cleanup_attempt>* results)
+  -> atr_cleanup_stats
+{
+  atr_cleanup_stats stats;
+  // ok, loop through the attempts and clean them all.  The entry will
+  // check if expired, nothing much to do here except call clean.
+  stats.exists = true;
+  stats.num_entries = atr.entries().size();
+  for (const auto& entry : atr.entries()) {
+    // If we were passed results, then we are testing, and want to set the
+    // check_if_expired to false.
+    atr_cleanup_entry cleanup_entry(entry, atr_id, *this, results == nullptr);
+    try {
+      if (results != nullptr) {
+        results->emplace_back(cleanup_entry);
+      }
+      cleanup_entry.clean(results != nullptr ? &results->back() : nullptr);
+      if (results != nullptr) {
+        results->back().success(true);
+      }
+      if (!cleanup_entry.check_if_expired() || cleanup_entry.expired()) {
+        ++stats.num_cleaned;
+      }
+    } catch (const std::exception& e) {
+      CB_LOST_ATTEMPT_CLEANUP_LOG_ERROR(
+        "cleanup of {} failed: {}, moving on", cleanup_entry, e.what());
+      ++stats.num_failed;
+      if (results != nullptr) {
+        results->back().success(false);
       }
     }
   }
@@ -586,12 +783,16 @@ transactions_cleanup::add_collection(const couchbase::transactions::transaction_
     auto it = std::find(collections_.begin(), collections_.end(), keyspace);
     if (it == collections_.end()) {
       collections_.emplace_back(keyspace);
-      // start cleaning right away
-      lost_attempt_cleanup_workers_.emplace_back([this, keyspace = collections_.back()]() {
-        this->clean_collection(keyspace);
-      });
     }
     lock.unlock();
+    // start cleaning right away
+    if (lost_attempts_) {
+      {
+        const std::scoped_lock state_lock(lost_attempts_->mutex);
+        lost_attempts_->collections_changed = true;
+      }
+      lost_attempts_->cv.notify_all();
+    }
     CB_ATTEMPT_CLEANUP_LOG_DEBUG("added {} to lost transaction cleanup", keyspace);
   }
 }
@@ -606,6 +807,30 @@ transactions_cleanup::start()
       attempts_loop();
     });
   }
+  if (config_.cleanup_config.cleanup_lost_attempts) {
+    lost_attempts_ = std::make_shared<lost_attempts_cleanup_state>(
+      config_.cleanup_config.max_concurrent_atr_reads,
+      config_.cleanup_config.max_atr_reads_per_second);
+    lost_attempts_thr_ = std::thread([this] {
+      lost_attempts_loop();
+    });
+    if (const auto meter = cluster_.meter(); meter) {
+      meter->add_report_section(
+        fmt::format("transactions_cleanup/{}", client_uuid_), [state = lost_attempts_]() {
+          const auto stats = state->snapshot();
+          return tao::json::value{
+            { "passes_completed", stats.passes_completed },
+            { "last_pass_duration_ms", stats.last_pass_duration.count() },
+            { "atrs_read", stats.atrs_read },
+            { "atr_read_failures", stats.atr_read_failures },
+            { "attempts_cleaned", stats.attempts_cleaned },
+            { "attempts_failed", stats.attempts_failed },
+            { "backlog", stats.backlog },
+            { "atr_reads_in_flight", stats.atr_reads_in_flight },
+          };
+        });
+    }
+  }
   if (config_.metadata_collection) {
     add_collection({ config_.metadata_collection->bucket,
                      config_.metadata_collection->scope,
@@ -628,11 +853,19 @@ transactions_cleanup::stop()
     cleanup_thr_.join();
     CB_ATTEMPT_CLEANUP_LOG_DEBUG("cleanup attempt thread closed");
   }
-  for (auto& t : lost_attempt_cleanup_workers_) {
-    CB_LOST_ATTEMPT_CLEANUP_LOG_DEBUG("shutting down all lost attempt threads...");
-    if (t.joinable()) {
-      t.join();
+  if (lost_attempts_) {
+    if (const auto meter = cluster_.meter(); meter) {
+      meter->remove_report_section(fmt::format("transactions_cleanup/{}", client_uuid_));
     }
+    {
+      const std::scoped_lock lock(lost_attempts_->mutex);
+      lost_attempts_->stopped = true;
+    }
+    lost_attempts_->cv.notify_all();
+  }
+  if (lost_attempts_thr_.joinable()) {
+    CB_LOST_ATTEMPT_CLEANUP_LOG_DEBUG("shutting down lost attempts thread...");
+    lost_attempts_thr_.join();
   }
 }
 
@@ -640,7 +873,7 @@ void
 transactions_cleanup::close()
 {
   stop();
-  CB_LOST_ATTEMPT_CLEANUP_LOG_DEBUG("all lost attempt cleanup threads closed");
+  CB_LOST_ATTEMPT_CLEANUP_LOG_DEBUG("lost attempts cleanup thread closed");
   remove_client_record_from_all_buckets(client_uuid_);
 }
 
@@ -0,0 +1,192 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2025 Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace couchbase::core::utils
+{
+namespace detail
+{
+inline auto
+this_thread_sampler_shard() -> std::size_t
+{
+  static std::atomic<std::size_t> next_shard{ 0 };
+  thread_local const std::size_t shard = next_shard.fetch_add(1, std::memory_order_relaxed);
+  return shard;
+}
+} // namespace detail
+
+/**
+ * Keeps the N items with the largest weight, offered from many threads.
+ *
+ * Every thread writes into its own shard, and every shard keeps its own top N, so the merged
+ * result is the same as if all items were offered to a single bounded priority queue. Once any
+ * shard is full, its smallest weight is published as a floor, and items that are not heavier
+ * than the floor are rejected without taking a lock.
+ */
+template<typename T>
+class concurrent_top_n_sampler
+{
+public:
+  static constexpr std::size_t default_number_of_shards{ 8 };
+
+  explicit concurrent_top_n_sampler(std::size_t capacity,
+                                    std::size_t number_of_shards = default_number_of_shards)
+    : capacity_{ capacity }
+    , shards_(std::max<std::size_t>(1, number_of_shards))
+  {
+    for (auto& s : shards_) {
+      s.heap.reserve(capacity_);
+    }
+  }
+
+  concurrent_top_n_sampler(const concurrent_top_n_sampler&) = delete;
+  concurrent_top_n_sampler(concurrent_top_n_sampler&&) = delete;
+  auto operator=(const concurrent_top_n_sampler&) -> concurrent_top_n_sampler& = delete;
+  auto operator=(concurrent_top_n_sampler&&) -> concurrent_top_n_sampler& = delete;
+  ~concurrent_top_n_sampler() = default;
+
+  /**
+   * Offers the item, that will be constructed by the factory only if its weight is large enough
+   * to make it into the sample.
+   *
+   * @return true if the item has been added to the sample
+   */
+  template<typename Factory>
+  auto offer(std::int64_t weight, Factory&& make_item) -> bool
+  {
+    auto& s = shards_[detail::this_thread_sampler_shard() % shards_.size()];
+    s.number_of_offered.fetch_add(1, std::memory_order_relaxed);
+
+    if (capacity_ == 0 || weight <= floor_.load(std::memory_order_relaxed)) {
+      return false;
+    }
+
+    const std::scoped_lock lock(s.mutex);
+    if (s.heap.size() < capacity_) {
+      s.heap.push_back({ weight, std::forward<Factory>(make_item)() });
+      std::push_heap(s.heap.begin(), s.heap.end(), lighter);
+    } else {
+      if (weight <= s.heap.front().weight) {
+        return false;
+      }
+      std::pop_heap(s.heap.begin(), s.heap.end(), lighter);
+      s.heap.back() = { weight, std::forward<Factory>(make_item)() };
+      std::push_heap(s.heap.begin(), s.heap.end(), lighter);
+    }
+    if (s.heap.size() == capacity_) {
+      raise_floor(s.heap.front().weight);
+    }
+    return true;
+  }
+
+  auto emplace(std::int64_t weight, T&& item) -> bool
+  {
+    return offer(weight, [&item]() -> T&& {
+      return std::move(item);
+    });
+  }
+
+  /**
+   * @return true if the sample has no items, e.g. because nothing has been offered, or because the
+   * capacity is zero
+   */
+  [[nodiscard]] auto empty() -> bool
+  {
+    return std::all_of(shards_.begin(), shards_.end(), [](shard& s) {
+      const std::scoped_lock lock(s.mutex);
+      return s.heap.empty();
+    });
+  }
+
+  /**
+   * Clears the sample, and returns the items ordered from the heaviest to the lightest, along with
+   * the number of items that have been offered, but not returned.
+   */
+  auto steal_data() -> std::pair<std::vector<T>, std::size_t>
+  {
+    std::vector<entry> entries;
+    std::size_t number_of_offered{ 0 };
+    for (auto& s : shards_) {
+      const std::scoped_lock lock(s.mutex);
+      number_of_offered += s.number_of_offered.exchange(0, std::memory_order_relaxed);
+      std::move(s.heap.begin(), s.heap.end(), std::back_inserter(entries));
+      s.heap.clear();
+    }
+    // reset the floor only when all shards are empty, otherwise it might be raised again by the
+    // shard that has not been drained yet
+    floor_.store(std::numeric_limits<std::int64_t>::min(), std::memory_order_relaxed);
+
+    const auto number_of_kept = std::min(capacity_, entries.size());
+    std::partial_sort(entries.begin(),
+                      entries.begin() + static_cast<std::ptrdiff_t>(number_of_kept),
+                      entries.end(),
+                      [](const entry& lhs, const entry& rhs) {
+                        return lhs.weight > rhs.weight;
+                      });
+
+    std::vector<T> data;
+    data.reserve(number_of_kept);
+    for (std::size_t i = 0; i < number_of_kept; ++i) {
+      data.emplace_back(std::move(entries[i].item));
+    }
+    // items might be offered concurrently with stealing, so the counter could lag behind
+    const auto dropped_count = std::max(number_of_offered, number_of_kept) - number_of_kept;
+    return { std::move(data), dropped_count };
+  }
+
+private:
+  struct entry {
+    std::int64_t weight;
+    T item;
+  };
+
+  struct alignas(64) shard {
+    std::mutex mutex{};
+    std::vector<entry> heap{};
+    std::atomic<std::size_t> number_of_offered{ 0 };
+  };
+
+  static auto lighter(const entry& lhs, const entry& rhs) -> bool
+  {
+    // min-heap, the lightest item is at the front
+    return lhs.weight > rhs.weight;
+  }
+
+  void raise_floor(std::int64_t weight)
+  {
+    auto current = floor_.load(std::memory_order_relaxed);
+    while (current < weight &&
+           !floor_.compare_exchange_weak(current, weight, std::memory_order_relaxed)) {
+    }
+  }
+
+  std::size_t capacity_;
+  std::vector<shard> shards_;
+  alignas(64) std::atomic<std::int64_t> floor_{ std::numeric_limits<std::int64_t>::min() };
+};
+} // namespace couchbase::core::utils
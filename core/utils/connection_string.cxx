@@ -536,6 +536,12 @@ extract_options(connection_string& connstr)
        * The period of time an HTTP connection can be idle before it is forcefully disconnected.
        */
       parse_option(connstr.options.idle_http_connection_timeout, name, value, connstr.warnings);
+    } else if (name == "streaming_row_buffer_size") {
+      /**
+       * The number of rows of query, analytics and search results, that are buffered ahead of the
+       * consumer of the row stream.
+       */
+      parse_option(connstr.options.streaming_row_buffer_size, name, value, connstr.warnings);
     } else if (name == "bootstrap_timeout") {
       /**
        * The period of time allocated to complete bootstrap
@@ -561,6 +567,16 @@ extract_options(connection_string& connstr)
        * Announce support of compression (snappy) to server
        */
       parse_option(connstr.options.enable_compression, name, value, connstr.warnings);
+    } else if (name == "compression_min_size") {
+      /**
+       * Values smaller than this number of bytes are never compressed
+       */
+      parse_option(connstr.options.compression_policy.min_size, name, value, connstr.warnings);
+    } else if (name == "compression_adaptive") {
+      /**
+       * Stop compressing for a while after a series of values with poor compression ratio
+       */
+      parse_option(connstr.options.compression_policy.adaptive, name, value, connstr.warnings);
     } else if (name == "enable_tracing") {
       /**
        * true - use threshold_logging_tracer
@@ -573,6 +589,12 @@ extract_options(connection_string& connstr)
        * false - use noop_meter
        */
       parse_option(connstr.options.enable_metrics, name, value, connstr.warnings);
+    } else if (name == "metrics_number_of_shards") {
+      /**
+       * Number of shards of each value recorder of logging_meter (default 1)
+       */
+      parse_option(
+        connstr.options.metrics_options.number_of_shards, name, value, connstr.warnings);
     } else if (name == "tls_verify") {
       parse_option(connstr.options.tls_verify, name, value, connstr.warnings);
     } else if (name == "tls_disable_deprecated_protocols") {
@@ -592,6 +614,18 @@ extract_options(connection_string& connstr)
       parse_option(connstr.options.allow_enterprise_analytics, name, value, connstr.warnings);
     } else if (name == "enable_lazy_connections") {
       parse_option(connstr.options.enable_lazy_connections, name, value, connstr.warnings);
+    } else if (name == "kv_connections_per_node") {
+      /**
+       * Number of KV connections to open to each node of the bucket (default 1)
+       */
+      parse_option(connstr.options.kv_connections_per_node, name, value, connstr.warnings);
+    } else if (name == "prepared_statement_cache_capacity") {
+      /**
+       * Maximum number of prepared query statements, that the SDK keeps (default 5000). Zero
+       * disables the cache, and non-adhoc queries are sent as ad hoc statements.
+       */
+      parse_option(
+        connstr.options.prepared_statement_cache_capacity, name, value, connstr.warnings);
     } else {
       connstr.warnings.push_back(
         fmt::format(R"(unknown parameter "{}" in connection string (value "{}"))", name, value));
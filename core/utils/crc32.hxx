@@ -5,11 +5,20 @@
  * src/usr.bin/cksum/crc32.c.
  */
 
+#pragma once
+
+#include <array>
+#include <cstddef>
 #include <cstdint>
 
+#if defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#define COUCHBASE_CXX_CLIENT_HAS_HARDWARE_CRC32 1
+#endif
+
 namespace couchbase::core::utils
 {
-static const std::uint32_t crc32tab[256] = {
+static constexpr std::uint32_t crc32tab[256] = {
   0x00000000, 0x77073096, 0xee0e612c, 0x990951ba, 0x076dc419, 0x706af48f, 0xe963a535, 0x9e6495a3,
   0x0edb8832, 0x79dcb8a4, 0xe0d5e91e, 0x97d2d988, 0x09b64c2b, 0x7eb17cbd, 0xe7b82d07, 0x90bf1d91,
   0x1db71064, 0x6ab020f2, 0xf3b97148, 0x84be41de, 0x1adad47d, 0x6ddde4eb, 0xf4d4b551, 0x83d385c7,
@@ -44,15 +53,116 @@ static const std::uint32_t crc32tab[256] = {
   0xb3667a2e, 0xc4614ab8, 0x5d681b02, 0x2a6f2b94, 0xb40bbe37, 0xc30c8ea1, 0x5a05df1b, 0x2d02ef8d,
 };
 
+namespace detail
+{
+constexpr auto
+make_crc32_slicing_tables() -> std::array<std::array<std::uint32_t, 256>, 8>
+{
+  std::array<std::array<std::uint32_t, 256>, 8> tables{};
+  for (std::size_t i = 0; i < 256; ++i) {
+    tables[0][i] = crc32tab[i];
+  }
+  for (std::size_t i = 0; i < 256; ++i) {
+    for (std::size_t k = 1; k < 8; ++k) {
+      tables[k][i] = (tables[k - 1][i] >> 8) ^ tables[0][tables[k - 1][i] & 0xff];
+    }
+  }
+  return tables;
+}
+
+/*
+ * Table k holds the CRC contribution of a byte that is followed by k zero bytes, which allows to
+ * fold eight input bytes per iteration (Intel's "slicing-by-8").
+ */
+inline constexpr auto crc32_slicing_tables = make_crc32_slicing_tables();
+
+constexpr auto
+load_le32(const unsigned char* data) -> std::uint32_t
+{
+  return static_cast<std::uint32_t>(data[0]) | (static_cast<std::uint32_t>(data[1]) << 8) |
+         (static_cast<std::uint32_t>(data[2]) << 16) | (static_cast<std::uint32_t>(data[3]) << 24);
+}
+} // namespace detail
+
+/**
+ * Reference implementation, consumes one byte per iteration.
+ */
 static inline auto
-hash_crc32(const char* key, std::size_t key_length) -> std::uint32_t
+crc32_bytewise(std::uint32_t crc, const char* data, std::size_t length) -> std::uint32_t
+{
+  for (std::size_t x = 0; x < length; x++) {
+    crc = (crc >> 8) ^ crc32tab[(crc ^ static_cast<std::uint8_t>(data[x])) & 0xff];
+  }
+  return crc;
+}
+
+/**
+ * Portable implementation, consumes eight bytes per iteration and falls back to
+ * crc32_bytewise() for the tail.
+ */
+static inline auto
+crc32_slicing_by_8(std::uint32_t crc, const char* data, std::size_t length) -> std::uint32_t
 {
-  std::uint32_t crc = UINT32_MAX;
+  const auto& t = detail::crc32_slicing_tables;
+  const auto* bytes = reinterpret_cast<const unsigned char*>(data);
+  while (length >= 8) {
+    const std::uint32_t one = crc ^ detail::load_le32(bytes);
+    const std::uint32_t two = detail::load_le32(bytes + 4);
+    crc = t[7][one & 0xff] ^ t[6][(one >> 8) & 0xff] ^ t[5][(one >> 16) & 0xff] ^ t[4][one >> 24] ^
+          t[3][two & 0xff] ^ t[2][(two >> 8) & 0xff] ^ t[1][(two >> 16) & 0xff] ^ t[0][two >> 24];
+    bytes += 8;
+    length -= 8;
+  }
+  return crc32_bytewise(crc, reinterpret_cast<const char*>(bytes), length);
+}
 
-  for (std::uint64_t x = 0; x < key_length; x++) {
-    crc = (crc >> 8) ^ crc32tab[(crc ^ static_cast<std::uint64_t>(key[x])) & 0xff];
+#if defined(COUCHBASE_CXX_CLIENT_HAS_HARDWARE_CRC32)
+/**
+ * ARMv8 CRC32 instructions, which use the same (IEEE 802.3) polynomial as the table.
+ */
+static inline auto
+crc32_hardware(std::uint32_t crc, const char* data, std::size_t length) -> std::uint32_t
+{
+  const auto* bytes = reinterpret_cast<const unsigned char*>(data);
+  while (length >= 8) {
+    std::uint64_t word = 0;
+    for (std::size_t i = 0; i < 8; ++i) {
+      word |= static_cast<std::uint64_t>(bytes[i]) << (8 * i);
+    }
+    crc = __crc32d(crc, word);
+    bytes += 8;
+    length -= 8;
+  }
+  while (length > 0) {
+    crc = __crc32b(crc, *bytes);
+    ++bytes;
+    --length;
   }
+  return crc;
+}
+#endif
 
+/**
+ * Updates running CRC32 (without pre- and post-conditioning) using the fastest implementation
+ * available for the target.
+ *
+ * Note that SSE4.2 crc32 instruction implements CRC32C (Castagnoli polynomial) and cannot be used
+ * here, because vBucket mapping must stay compatible with the server and other SDKs.
+ */
+static inline auto
+crc32_update(std::uint32_t crc, const char* data, std::size_t length) -> std::uint32_t
+{
+#if defined(COUCHBASE_CXX_CLIENT_HAS_HARDWARE_CRC32)
+  return crc32_hardware(crc, data, length);
+#else
+  return crc32_slicing_by_8(crc, data, length);
+#endif
+}
+
+static inline auto
+hash_crc32(const char* key, std::size_t key_length) -> std::uint32_t
+{
+  const std::uint32_t crc = crc32_update(UINT32_MAX, key, key_length);
   return ((~crc) >> 16) & 0x7fff;
 }
 
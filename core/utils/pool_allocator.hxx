@@ -0,0 +1,221 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2025-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace couchbase::core::utils
+{
+namespace detail
+{
+/**
+ * Free list of memory blocks of the same size.
+ *
+ * Every thread keeps up to batch_size blocks in its own list, which is used without locks. The
+ * threads exchange whole batches through the process-wide list, so that the blocks released on
+ * the IO thread can be reused by the application thread, that allocates them, while the mutex is
+ * taken only once per batch_size allocations or deallocations.
+ */
+template<std::size_t Size, std::size_t Alignment>
+class fixed_size_pool
+{
+public:
+  static constexpr std::size_t batch_size{ 32 };
+  static constexpr std::size_t max_cached_batches{ 32 };
+
+  static auto instance() -> fixed_size_pool&
+  {
+    // intentionally leaked, so that objects released during static destruction can still use it
+    static auto* pool = new fixed_size_pool();
+    return *pool;
+  }
+
+  auto allocate() -> void*
+  {
+    auto& blocks = local_blocks().blocks;
+    if (blocks.empty()) {
+      acquire_batch(blocks);
+    }
+    if (!blocks.empty()) {
+      void* block = blocks.back();
+      blocks.pop_back();
+      return block;
+    }
+    return ::operator new(Size, std::align_val_t{ Alignment });
+  }
+
+  void deallocate(void* block) noexcept
+  {
+    auto& blocks = local_blocks().blocks;
+    if (blocks.size() >= batch_size) {
+      release_batch(blocks);
+    }
+    if (blocks.capacity() > blocks.size()) {
+      blocks.push_back(block);
+      return;
+    }
+    ::operator delete(block, std::align_val_t{ Alignment });
+  }
+
+private:
+  struct thread_blocks {
+    std::vector<void*> blocks{};
+
+    thread_blocks()
+    {
+      blocks.reserve(batch_size);
+    }
+
+    thread_blocks(const thread_blocks&) = delete;
+    thread_blocks(thread_blocks&&) = delete;
+    auto operator=(const thread_blocks&) -> thread_blocks& = delete;
+    auto operator=(thread_blocks&&) -> thread_blocks& = delete;
+
+    ~thread_blocks()
+    {
+      free_blocks(blocks);
+    }
+  };
+
+  static auto local_blocks() -> thread_blocks&
+  {
+    thread_local thread_blocks local{};
+    return local;
+  }
+
+  static void free_blocks(std::vector<void*>& blocks) noexcept
+  {
+    for (void* block : blocks) {
+      ::operator delete(block, std::align_val_t{ Alignment });
+    }
+    blocks.clear();
+  }
+
+  fixed_size_pool()
+  {
+    full_batches_.reserve(max_cached_batches);
+    empty_batches_.reserve(max_cached_batches);
+  }
+
+  /**
+   * Replaces the empty list of the thread with a full batch, if there is any.
+   */
+  void acquire_batch(std::vector<void*>& blocks)
+  {
+    const std::scoped_lock lock(mutex_);
+    if (full_batches_.empty()) {
+      return;
+    }
+    empty_batches_.push_back(std::move(blocks));
+    blocks = std::move(full_batches_.back());
+    full_batches_.pop_back();
+  }
+
+  /**
+   * Hands over the full list of the thread, and replaces it with an empty one. When the
+   * process-wide list is full, the blocks are freed instead.
+   */
+  void release_batch(std::vector<void*>& blocks) noexcept
+  {
+    bool handed_over{ false };
+    {
+      const std::scoped_lock lock(mutex_);
+      if (full_batches_.size() < max_cached_batches) {
+        std::vector<void*> replacement{};
+        if (!empty_batches_.empty()) {
+          replacement = std::move(empty_batches_.back());
+          empty_batches_.pop_back();
+        }
+        full_batches_.push_back(std::move(blocks));
+        blocks = std::move(replacement);
+        handed_over = true;
+      }
+    }
+    if (!handed_over) {
+      free_blocks(blocks);
+    }
+    if (blocks.capacity() < batch_size) {
+      try {
+        blocks.reserve(batch_size);
+      } catch (const std::bad_alloc&) {
+        // deallocate() frees the blocks, that do not fit into the list
+      }
+    }
+  }
+
+  std::vector<std::vector<void*>> full_batches_{};
+  // lists, that have been handed over in exchange for the full ones, each keeps its capacity
+  std::vector<std::vector<void*>> empty_batches_{};
+  std::mutex mutex_{};
+};
+} // namespace detail
+
+/**
+ * Allocator, that recycles single-object allocations through per-thread free lists, which
+ * exchange batches of blocks between the threads.
+ *
+ * Intended for std::allocate_shared() of the objects created for every operation, which are
+ * usually allocated on the application thread and released on the IO thread. Up to
+ * (detail::fixed_size_pool::max_cached_batches + 1) * detail::fixed_size_pool::batch_size blocks
+ * of each size and thread are kept for reuse.
+ */
+template<typename T>
+class pool_allocator
+{
+public:
+  using value_type = T;
+
+  pool_allocator() noexcept = default;
+
+  template<typename U>
+  explicit pool_allocator(const pool_allocator<U>& /* other */) noexcept
+  {
+  }
+
+  auto allocate(std::size_t n) -> T*
+  {
+    if (n == 1) {
+      return static_cast<T*>(detail::fixed_size_pool<sizeof(T), alignof(T)>::instance().allocate());
+    }
+    return std::allocator<T>{}.allocate(n);
+  }
+
+  void deallocate(T* ptr, std::size_t n) noexcept
+  {
+    if (n == 1) {
+      return detail::fixed_size_pool<sizeof(T), alignof(T)>::instance().deallocate(ptr);
+    }
+    std::allocator<T>{}.deallocate(ptr, n);
+  }
+
+  template<typename U>
+  auto operator==(const pool_allocator<U>& /* other */) const noexcept -> bool
+  {
+    return true;
+  }
+
+  template<typename U>
+  auto operator!=(const pool_allocator<U>& /* other */) const noexcept -> bool
+  {
+    return false;
+  }
+};
+} // namespace couchbase::core::utils
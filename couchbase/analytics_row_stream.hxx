@@ -0,0 +1,126 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2025. Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include <couchbase/codec/encoded_value.hxx>
+#include <couchbase/error.hxx>
+#include <couchbase/analytics_meta_data.hxx>
+
+#include <functional>
+#include <future>
+#include <memory>
+#include <optional>
+#include <utility>
+
+namespace couchbase
+{
+#ifndef COUCHBASE_CXX_CLIENT_DOXYGEN
+class analytics_row_stream_impl;
+#endif
+
+/**
+ * The signature for the handler of the @ref analytics_row_stream#next_row() operation.
+ *
+ * The row is empty when all rows have been consumed. In this case the error carries the failure
+ * reported by the analytics engine after the rows (if any), and the metadata becomes available.
+ *
+ * @since 1.3.2
+ * @uncommitted
+ */
+using analytics_row_handler = std::function<void(error, std::optional<codec::binary>)>;
+
+/**
+ * Represents rows of @ref cluster#analytics_query_stream() and @ref scope#analytics_query_stream()
+ * calls, that are delivered one by one while the response is still being received.
+ *
+ * The response body is read from the network only as fast as the rows are consumed, so only a
+ * small window of the result is held in memory regardless of its size.
+ *
+ * @since 1.3.2
+ * @uncommitted
+ */
+class analytics_row_stream
+{
+public:
+  /**
+   * @since 1.3.2
+   * @internal
+   */
+  analytics_row_stream() = default;
+
+  /**
+   * @since 1.3.2
+   * @internal
+   */
+  explicit analytics_row_stream(std::shared_ptr<analytics_row_stream_impl> impl);
+
+  /**
+   * Retrieves the next row of the result.
+   *
+   * The method must not be called again until the handler of the previous call has been invoked.
+   *
+   * @param handler the handler that implements @ref analytics_row_handler
+   *
+   * @since 1.3.2
+   * @uncommitted
+   */
+  void next_row(analytics_row_handler&& handler) const;
+
+  /**
+   * Retrieves the next row of the result.
+   *
+   * @return future object that carries the next row, or empty optional after the last row
+   *
+   * @since 1.3.2
+   * @uncommitted
+   */
+  [[nodiscard]] auto next_row() const
+    -> std::future<std::pair<error, std::optional<codec::binary>>>;
+
+  /**
+   * Returns the metadata of the query. The metadata is sent by the analytics engine after the rows,
+   * so it is only available once all rows have been consumed.
+   *
+   * @return response metadata, or empty optional if the stream has not been consumed yet
+   *
+   * @since 1.3.2
+   * @uncommitted
+   */
+  [[nodiscard]] auto meta_data() const -> std::optional<analytics_meta_data>;
+
+  /**
+   * Stops receiving rows and closes the connection.
+   *
+   * @since 1.3.2
+   * @uncommitted
+   */
+  void cancel() const;
+
+private:
+  std::shared_ptr<analytics_row_stream_impl> impl_{};
+};
+
+/**
+ * The signature for the handler of the @ref cluster#analytics_query_stream() and
+ * @ref scope#analytics_query_stream() operations.
+ *
+ * @since 1.3.2
+ * @uncommitted
+ */
+using analytics_stream_handler = std::function<void(error, analytics_row_stream)>;
+} // namespace couchbase
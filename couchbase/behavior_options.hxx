@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <string>
 
 namespace couchbase
@@ -73,6 +74,12 @@ public:
     return *this;
   }
 
+  auto streaming_row_buffer_size(std::size_t size) -> behavior_options&
+  {
+    streaming_row_buffer_size_ = size;
+    return *this;
+  }
+
   struct built {
     std::string user_agent_extra;
     bool show_queries;
@@ -82,6 +89,7 @@ public:
     bool dump_configuration;
     std::string network;
     bool preserve_bootstrap_nodes_order;
+    std::size_t streaming_row_buffer_size;
   };
 
   [[nodiscard]] auto build() const -> built
@@ -95,6 +103,7 @@ public:
       dump_configuration_,
       network_,
       preserve_bootstrap_nodes_order_,
+      streaming_row_buffer_size_,
     };
   }
 
@@ -107,5 +116,6 @@ private:
   bool dump_configuration_{ false };
   std::string network_{ "auto" };
   bool preserve_bootstrap_nodes_order_{ false };
+  std::size_t streaming_row_buffer_size_{ 100 };
 };
 } // namespace couchbase
@@ -49,6 +49,9 @@
 
 #include <future>
 #include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace couchbase
 {
@@ -158,6 +161,44 @@ public:
   [[nodiscard]] auto get(std::string document_id, const get_options& options = {}) const
     -> std::future<std::pair<error, get_result>>;
 
+  /**
+   * Fetches a batch of full documents from this collection.
+   *
+   * Every distinct ID is fetched with a regular get operation. The operations are grouped by the
+   * node that owns the document and started together, and they share one timeout, that starts
+   * when the batch is submitted. The handler is invoked once, after the last operation has
+   * completed.
+   *
+   * @param document_ids the IDs of the documents to fetch.
+   * @param options options to customize the get requests.
+   * @param handler the handler that implements @ref get_multi_handler
+   *
+   * @exception errc::key_value::document_not_found for the documents that are not found in the
+   * collection.
+   * @exception errc::common::ambiguous_timeout
+   * @exception errc::common::unambiguous_timeout
+   *
+   * @since 1.3.2
+   * @uncommitted
+   */
+  void get_multi(std::vector<std::string> document_ids,
+                 const get_options& options,
+                 get_multi_handler&& handler) const;
+
+  /**
+   * Fetches a batch of full documents from this collection.
+   *
+   * @param document_ids the IDs of the documents to fetch.
+   * @param options options to customize the get requests.
+   * @return future object that carries the results of all documents
+   *
+   * @since 1.3.2
+   * @uncommitted
+   */
+  [[nodiscard]] auto get_multi(std::vector<std::string> document_ids,
+                               const get_options& options = {}) const
+    -> std::future<get_multi_result>;
+
   /**
    * Fetches a full document and resets its expiration time to the value provided.
    *
@@ -526,6 +567,85 @@ public:
       std::move(document_id), create_encode_fn<Transcoder, Document>(std::move(document)), options);
   }
 
+  /**
+   * Upserts a batch of encoded documents which might or might not exist yet.
+   *
+   * Every distinct ID is stored with a regular upsert operation, and all of them are started
+   * together, grouped by the node that owns the document. If an ID occurs more than once, only its
+   * last document is stored. The operations share one timeout, that starts when the batch is
+   * submitted. The handler is invoked once, after the last operation has completed.
+   *
+   * @param documents pairs of the document ID and the encoded content of the document.
+   * @param options custom options to customize the upsert behavior.
+   * @param handler callable that implements @ref upsert_multi_handler
+   *
+   * @exception errc::common::ambiguous_timeout
+   * @exception errc::common::unambiguous_timeout
+   *
+   * @since 1.3.2
+   * @uncommitted
+   */
+  void upsert_multi(std::vector<std::pair<std::string, codec::encoded_value>> documents,
+                    const upsert_options& options,
+                    upsert_multi_handler&& handler) const;
+
+  /**
+   * Upserts a batch of encoded documents which might or might not exist yet.
+   *
+   * @param documents pairs of the document ID and the encoded content of the document.
+   * @param options custom options to customize the upsert behavior.
+   * @return future object that carries the results of all documents
+   *
+   * @since 1.3.2
+   * @uncommitted
+   */
+  [[nodiscard]] auto upsert_multi(
+    std::vector<std::pair<std::string, codec::encoded_value>> documents,
+    const upsert_options& options) const -> std::future<upsert_multi_result>;
+
+  /**
+   * Upserts a batch of documents which might or might not exist yet.
+   *
+   * @tparam Transcoder type of the transcoder that will be used to encode the documents
+   * @tparam Document type of the documents
+   *
+   * @param documents pairs of the document ID and the content of the document.
+   * @param options custom options to customize the upsert behavior.
+   * @param handler callable that implements @ref upsert_multi_handler
+   *
+   * @since 1.3.2
+   * @uncommitted
+   */
+  template<typename Transcoder = codec::default_json_transcoder, typename Document>
+  void upsert_multi(std::vector<std::pair<std::string, Document>> documents,
+                    const upsert_options& options,
+                    upsert_multi_handler&& handler) const
+  {
+    return upsert_multi(
+      encode_documents<Transcoder, Document>(std::move(documents)), options, std::move(handler));
+  }
+
+  /**
+   * Upserts a batch of documents which might or might not exist yet.
+   *
+   * @tparam Transcoder type of the transcoder that will be used to encode the documents
+   * @tparam Document type of the documents
+   *
+   * @param documents pairs of the document ID and the content of the document.
+   * @param options custom options to customize the upsert behavior.
+   * @return future object that carries the results of all documents
+   *
+   * @since 1.3.2
+   * @uncommitted
+   */
+  template<typename Transcoder = codec::default_json_transcoder, typename Document>
+  [[nodiscard]] auto upsert_multi(std::vector<std::pair<std::string, Document>> documents,
+                                  const upsert_options& options = {}) const
+    -> std::future<upsert_multi_result>
+  {
+    return upsert_multi(encode_documents<Transcoder, Document>(std::move(documents)), options);
+  }
+
   /**
    * Inserts an encoded body of the document which does not exist yet with custom options.
    *
@@ -775,6 +895,45 @@ public:
   [[nodiscard]] auto remove(std::string document_id, const remove_options& options = {}) const
     -> std::future<std::pair<error, mutation_result>>;
 
+  /**
+   * Removes a batch of documents from a collection.
+   *
+   * Every distinct ID is removed with a regular remove operation. The operations are grouped by
+   * the node that owns the document and started together, and they share one timeout, that starts
+   * when the batch is submitted. The handler is invoked once, after the last operation has
+   * completed.
+   *
+   * @param document_ids the IDs of the documents to remove.
+   * @param options custom options to customize the remove behavior. The CAS, if set, is applied
+   * to every document.
+   * @param handler callable that implements @ref remove_multi_handler
+   *
+   * @exception errc::key_value::document_not_found for the documents that are not found in the
+   * collection.
+   * @exception errc::common::ambiguous_timeout
+   * @exception errc::common::unambiguous_timeout
+   *
+   * @since 1.3.2
+   * @uncommitted
+   */
+  void remove_multi(std::vector<std::string> document_ids,
+                    const remove_options& options,
+                    remove_multi_handler&& handler) const;
+
+  /**
+   * Removes a batch of documents from a collection.
+   *
+   * @param document_ids the IDs of the documents to remove.
+   * @param options custom options to customize the remove behavior.
+   * @return future object that carries the results of all documents
+   *
+   * @since 1.3.2
+   * @uncommitted
+   */
+  [[nodiscard]] auto remove_multi(std::vector<std::string> document_ids,
+                                  const remove_options& options = {}) const
+    -> std::future<remove_multi_result>;
+
   /**
    * Performs mutations to document fragments
    *
@@ -1245,6 +1404,20 @@ private:
 
   [[nodiscard]] auto crypto_manager() const -> const std::shared_ptr<crypto::manager>&;
 
+  template<typename Transcoder, typename Document>
+  [[nodiscard]] auto encode_documents(
+    std::vector<std::pair<std::string, Document>> documents) const
+    -> std::vector<std::pair<std::string, codec::encoded_value>>
+  {
+    std::vector<std::pair<std::string, codec::encoded_value>> encoded{};
+    encoded.reserve(documents.size());
+    for (auto& [document_id, document] : documents) {
+      encoded.emplace_back(std::move(document_id),
+                           create_encode_fn<Transcoder, Document>(std::move(document))());
+    }
+    return encoded;
+  }
+
   template<typename Transcoder, typename Document>
   [[nodiscard]] auto create_encode_fn(Document document) const
     -> std::function<codec::encoded_value()>
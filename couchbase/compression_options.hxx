@@ -18,6 +18,8 @@
 #pragma once
 
 #include <cstddef>
+#include <set>
+#include <string>
 
 namespace couchbase
 {
@@ -42,10 +44,39 @@ public:
     return *this;
   }
 
+  /**
+   * Stop trying to compress values for a while after a series of values that did not compress well
+   * (e.g. images or already compressed data), so that the CPU is not wasted on them.
+   *
+   * @since 1.3.2
+   * @uncommitted
+   */
+  auto adaptive(bool enabled) -> compression_options&
+  {
+    adaptive_ = enabled;
+    return *this;
+  }
+
+  /**
+   * Never compress the values written to the collection.
+   *
+   * @since 1.3.2
+   * @uncommitted
+   */
+  auto disable_for_collection(const std::string& bucket_name,
+                              const std::string& scope_name,
+                              const std::string& collection_name) -> compression_options&
+  {
+    disabled_collections_.insert(bucket_name + "." + scope_name + "." + collection_name);
+    return *this;
+  }
+
   struct built {
     bool enabled;
     std::size_t min_size;
     double min_ratio;
+    bool adaptive;
+    std::set<std::string> disabled_collections;
   };
 
   [[nodiscard]] auto build() const -> built
@@ -54,6 +85,8 @@ public:
       enabled_,
       min_size_,
       min_ratio_,
+      adaptive_,
+      disabled_collections_,
     };
   }
 
@@ -61,5 +94,7 @@ private:
   bool enabled_{ true };
   std::size_t min_size_{ 32 };
   double min_ratio_{ 0.83 };
+  bool adaptive_{ true };
+  std::set<std::string> disabled_collections_{};
 };
 } // namespace couchbase
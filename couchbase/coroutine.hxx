@@ -0,0 +1,476 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2025. Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#define COUCHBASE_CXX_CLIENT_HAS_COROUTINES 1
+
+#include <couchbase/cluster.hxx>
+#include <couchbase/collection.hxx>
+#include <couchbase/query_row_stream.hxx>
+#include <couchbase/scan_result.hxx>
+#include <couchbase/scope.hxx>
+
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+/**
+ * C++20 coroutine front-end for the asynchronous operations.
+ *
+ * Every function in this namespace returns an awaitable, that starts the operation when it is
+ * awaited, and resumes the awaiting coroutine directly from the completion handler, i.e. on the
+ * thread that runs the IO context of the cluster. Unlike the overloads that return std::future,
+ * there is no shared state and no thread is blocked while the operation is in flight. The result
+ * of the operation is stored in the awaitable itself, which lives in the frame of the awaiting
+ * coroutine.
+ *
+ * The awaitables can be used with any coroutine type that does not restrict what can be awaited.
+ * Coroutines that do (like asio::awaitable) can wrap the same callback-based operations with
+ * their own initiation function.
+ *
+ * @code{.cpp}
+ * auto [err, res] = co_await couchbase::coro::get(collection, "my-document");
+ * @endcode
+ *
+ * @since 1.3.2
+ * @uncommitted
+ */
+namespace couchbase::coro
+{
+/**
+ * Awaitable that starts an operation with the initiator, and resumes the awaiting coroutine once
+ * the operation has completed.
+ *
+ * The initiator is invoked with a copyable completion handler, that accepts @ref error followed by
+ * the results of the operation.
+ *
+ * @tparam Initiator callable that starts the operation
+ * @tparam Results types of the results passed to the completion handler after the error
+ *
+ * @since 1.3.2
+ * @uncommitted
+ */
+template<typename Initiator, typename... Results>
+class operation_awaitable
+{
+public:
+  explicit operation_awaitable(Initiator initiator)
+    : initiator_{ std::move(initiator) }
+  {
+  }
+
+  operation_awaitable(const operation_awaitable&) = delete;
+  operation_awaitable(operation_awaitable&&) = delete;
+  auto operator=(const operation_awaitable&) -> operation_awaitable& = delete;
+  auto operator=(operation_awaitable&&) -> operation_awaitable& = delete;
+  ~operation_awaitable() = default;
+
+  [[nodiscard]] auto await_ready() const noexcept -> bool
+  {
+    return false;
+  }
+
+  auto await_suspend(std::coroutine_handle<> awaiting) -> bool
+  {
+    awaiting_ = awaiting;
+    std::move(initiator_)([this](error err, Results... results) {
+      result_.emplace(std::move(err), std::move(results)...);
+      // whoever comes second resumes the coroutine: the handler, or await_suspend() itself when
+      // the operation has completed before the initiator returned
+      if (state_.exchange(state::completed, std::memory_order_acq_rel) == state::suspended) {
+        awaiting_.resume();
+      }
+    });
+    return state_.exchange(state::suspended, std::memory_order_acq_rel) != state::completed;
+  }
+
+  /**
+   * @return the error if the operation has no results, otherwise the pair of the error and the
+   * result, like the overloads that return std::future.
+   */
+  auto await_resume()
+  {
+    if constexpr (sizeof...(Results) == 0) {
+      return std::get<0>(std::move(*result_));
+    } else {
+      return std::make_from_tuple<std::pair<error, Results...>>(std::move(*result_));
+    }
+  }
+
+private:
+  enum class state {
+    initiating,
+    suspended,
+    completed,
+  };
+
+  Initiator initiator_;
+  std::coroutine_handle<> awaiting_{};
+  std::atomic<state> state_{ state::initiating };
+  std::optional<std::tuple<error, Results...>> result_{};
+};
+
+/**
+ * Creates awaitable for the operation, that completes with the error and the given results.
+ *
+ * @since 1.3.2
+ * @uncommitted
+ */
+template<typename... Results, typename Initiator>
+[[nodiscard]] auto
+make_awaitable(Initiator initiator) -> operation_awaitable<Initiator, Results...>
+{
+  return operation_awaitable<Initiator, Results...>{ std::move(initiator) };
+}
+
+/**
+ * @since 1.3.2
+ * @uncommitted
+ */
+[[nodiscard]] inline auto
+get(const collection& collection, std::string document_id, const get_options& options = {})
+{
+  return make_awaitable<get_result>(
+    [collection, document_id = std::move(document_id), options](auto&& handler) mutable {
+      collection.get(std::move(document_id), options, std::move(handler));
+    });
+}
+
+/**
+ * @since 1.3.2
+ * @uncommitted
+ */
+[[nodiscard]] inline auto
+get_and_touch(const collection& collection,
+              std::string document_id,
+              std::chrono::seconds duration,
+              const get_and_touch_options& options = {})
+{
+  return make_awaitable<get_result>(
+    [collection, document_id = std::move(document_id), duration, options](auto&& handler) mutable {
+      collection.get_and_touch(std::move(document_id), duration, options, std::move(handler));
+    });
+}
+
+/**
+ * @since 1.3.2
+ * @uncommitted
+ */
+[[nodiscard]] inline auto
+get_and_lock(const collection& collection,
+             std::string document_id,
+             std::chrono::seconds lock_duration,
+             const get_and_lock_options& options = {})
+{
+  return make_awaitable<get_result>([collection,
+                                     document_id = std::move(document_id),
+                                     lock_duration,
+                                     options](auto&& handler) mutable {
+    collection.get_and_lock(std::move(document_id), lock_duration, options, std::move(handler));
+  });
+}
+
+/**
+ * @since 1.3.2
+ * @uncommitted
+ */
+[[nodiscard]] inline auto
+get_any_replica(const collection& collection,
+                std::string document_id,
+                const get_any_replica_options& options = {})
+{
+  return make_awaitable<get_replica_result>(
+    [collection, document_id = std::move(document_id), options](auto&& handler) mutable {
+      collection.get_any_replica(std::move(document_id), options, std::move(handler));
+    });
+}
+
+/**
+ * @since 1.3.2
+ * @uncommitted
+ */
+[[nodiscard]] inline auto
+exists(const collection& collection, std::string document_id, const exists_options& options = {})
+{
+  return make_awaitable<exists_result>(
+    [collection, document_id = std::move(document_id), options](auto&& handler) mutable {
+      collection.exists(std::move(document_id), options, std::move(handler));
+    });
+}
+
+/**
+ * @since 1.3.2
+ * @uncommitted
+ */
+[[nodiscard]] inline auto
+touch(const collection& collection,
+      std::string document_id,
+      std::chrono::seconds duration,
+      const touch_options& options = {})
+{
+  return make_awaitable<result>(
+    [collection, document_id = std::move(document_id), duration, options](auto&& handler) mutable {
+      collection.touch(std::move(document_id), duration, options, std::move(handler));
+    });
+}
+
+/**
+ * @since 1.3.2
+ * @uncommitted
+ */
+[[nodiscard]] inline auto
+unlock(const collection& collection,
+       std::string document_id,
+       couchbase::cas cas,
+       const unlock_options& options = {})
+{
+  return make_awaitable<>(
+    [collection, document_id = std::move(document_id), cas, options](auto&& handler) mutable {
+      collection.unlock(std::move(document_id), cas, options, std::move(handler));
+    });
+}
+
+/**
+ * @tparam Transcoder type of the transcoder that will be used to encode the document
+ * @tparam Document type of the document
+ *
+ * @since 1.3.2
+ * @uncommitted
+ */
+template<typename Transcoder = codec::default_json_transcoder, typename Document>
+[[nodiscard]] auto
+upsert(const collection& collection,
+       std::string document_id,
+       Document document,
+       const upsert_options& options = {})
+{
+  return make_awaitable<mutation_result>([collection,
+                                          document_id = std::move(document_id),
+                                          document = std::move(document),
+                                          options](auto&& handler) mutable {
+    collection.template upsert<Transcoder>(
+      std::move(document_id), std::move(document), options, std::move(handler));
+  });
+}
+
+/**
+ * @tparam Transcoder type of the transcoder that will be used to encode the document
+ * @tparam Document type of the document
+ *
+ * @since 1.3.2
+ * @uncommitted
+ */
+template<typename Transcoder = codec::default_json_transcoder, typename Document>
+[[nodiscard]] auto
+insert(const collection& collection,
+       std::string document_id,
+       Document document,
+       const insert_options& options = {})
+{
+  return make_awaitable<mutation_result>([collection,
+                                          document_id = std::move(document_id),
+                                          document = std::move(document),
+                                          options](auto&& handler) mutable {
+    collection.template insert<Transcoder>(
+      std::move(document_id), std::move(document), options, std::move(handler));
+  });
+}
+
+/**
+ * @tparam Transcoder type of the transcoder that will be used to encode the document
+ * @tparam Document type of the document
+ *
+ * @since 1.3.2
+ * @uncommitted
+ */
+template<typename Transcoder = codec::default_json_transcoder, typename Document>
+[[nodiscard]] auto
+replace(const collection& collection,
+        std::string document_id,
+        Document document,
+        const replace_options& options = {})
+{
+  return make_awaitable<mutation_result>([collection,
+                                          document_id = std::move(document_id),
+                                          document = std::move(document),
+                                          options](auto&& handler) mutable {
+    collection.template replace<Transcoder>(
+      std::move(document_id), std::move(document), options, std::move(handler));
+  });
+}
+
+/**
+ * @since 1.3.2
+ * @uncommitted
+ */
+[[nodiscard]] inline auto
+remove(const collection& collection, std::string document_id, const remove_options& options = {})
+{
+  return make_awaitable<mutation_result>(
+    [collection, document_id = std::move(document_id), options](auto&& handler) mutable {
+      collection.remove(std::move(document_id), options, std::move(handler));
+    });
+}
+
+/**
+ * @since 1.3.2
+ * @uncommitted
+ */
+[[nodiscard]] inline auto
+lookup_in(const collection& collection,
+          std::string document_id,
+          const lookup_in_specs& specs,
+          const lookup_in_options& options = {})
+{
+  return make_awaitable<lookup_in_result>(
+    [collection, document_id = std::move(document_id), specs, options](auto&& handler) mutable {
+      collection.lookup_in(std::move(document_id), specs, options, std::move(handler));
+    });
+}
+
+/**
+ * @since 1.3.2
+ * @uncommitted
+ */
+[[nodiscard]] inline auto
+mutate_in(const collection& collection,
+          std::string document_id,
+          const mutate_in_specs& specs,
+          const mutate_in_options& options = {})
+{
+  return make_awaitable<mutate_in_result>(
+    [collection, document_id = std::move(document_id), specs, options](auto&& handler) mutable {
+      collection.mutate_in(std::move(document_id), specs, options, std::move(handler));
+    });
+}
+
+/**
+ * Starts the scan. The items are fetched with @ref next(const scan_result&).
+ *
+ * The scan type is taken by value, because the awaitable might be awaited after the argument
+ * has been destroyed.
+ *
+ * @tparam ScanType concrete scan type: @ref range_scan, @ref prefix_scan or @ref sampling_scan
+ *
+ * @since 1.3.2
+ * @uncommitted
+ */
+template<typename ScanType,
+         std::enable_if_t<std::is_base_of_v<scan_type, ScanType>, bool> = true>
+[[nodiscard]] auto
+scan(const collection& collection, ScanType scan_type, const scan_options& options = {})
+{
+  return make_awaitable<scan_result>(
+    [collection, scan_type = std::move(scan_type), options](auto&& handler) mutable {
+      collection.scan(scan_type, options, std::move(handler));
+    });
+}
+
+/**
+ * Fetches the next item of the scan, the item is empty once all items have been consumed.
+ *
+ * @since 1.3.2
+ * @uncommitted
+ */
+[[nodiscard]] inline auto
+next(const scan_result& scan)
+{
+  return make_awaitable<std::optional<scan_result_item>>([scan](auto&& handler) mutable {
+    scan.next(std::move(handler));
+  });
+}
+
+/**
+ * @since 1.3.2
+ * @uncommitted
+ */
+[[nodiscard]] inline auto
+query(const cluster& cluster, std::string statement, const query_options& options = {})
+{
+  return make_awaitable<query_result>(
+    [cluster, statement = std::move(statement), options](auto&& handler) mutable {
+      cluster.query(std::move(statement), options, std::move(handler));
+    });
+}
+
+/**
+ * @since 1.3.2
+ * @uncommitted
+ */
+[[nodiscard]] inline auto
+query(const scope& scope, std::string statement, const query_options& options = {})
+{
+  return make_awaitable<query_result>(
+    [scope, statement = std::move(statement), options](auto&& handler) mutable {
+      scope.query(std::move(statement), options, std::move(handler));
+    });
+}
+
+/**
+ * Starts the query, that delivers the rows with @ref next_row(const query_row_stream&).
+ *
+ * @since 1.3.2
+ * @uncommitted
+ */
+[[nodiscard]] inline auto
+query_stream(const cluster& cluster, std::string statement, const query_options& options = {})
+{
+  return make_awaitable<query_row_stream>(
+    [cluster, statement = std::move(statement), options](auto&& handler) mutable {
+      cluster.query_stream(std::move(statement), options, std::move(handler));
+    });
+}
+
+/**
+ * Starts the query, that delivers the rows with @ref next_row(const query_row_stream&).
+ *
+ * @since 1.3.2
+ * @uncommitted
+ */
+[[nodiscard]] inline auto
+query_stream(const scope& scope, std::string statement, const query_options& options = {})
+{
+  return make_awaitable<query_row_stream>(
+    [scope, statement = std::move(statement), options](auto&& handler) mutable {
+      scope.query_stream(std::move(statement), options, std::move(handler));
+    });
+}
+
+/**
+ * Fetches the next row of the query, the row is empty once all rows have been consumed.
+ *
+ * @since 1.3.2
+ * @uncommitted
+ */
+[[nodiscard]] inline auto
+next_row(const query_row_stream& stream)
+{
+  return make_awaitable<std::optional<codec::binary>>([stream](auto&& handler) mutable {
+    stream.next_row(std::move(handler));
+  });
+}
+} // namespace couchbase::coro
+
+#endif
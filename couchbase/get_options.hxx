@@ -23,8 +23,11 @@
 
 #include <chrono>
 #include <functional>
+#include <map>
 #include <memory>
 #include <optional>
+#include <string>
+#include <utility>
 
 namespace couchbase
 {
@@ -109,4 +112,21 @@ private:
  * @uncommitted
  */
 using get_handler = std::function<void(error, get_result)>;
+
+/**
+ * The results of the @ref collection#get_multi() operation: the outcome of every requested
+ * document, keyed by its ID.
+ *
+ * @since 1.3.2
+ * @uncommitted
+ */
+using get_multi_result = std::map<std::string, std::pair<error, get_result>>;
+
+/**
+ * The signature for the handler of the @ref collection#get_multi() operation
+ *
+ * @since 1.3.2
+ * @uncommitted
+ */
+using get_multi_handler = std::function<void(get_multi_result)>;
 } // namespace couchbase
@@ -22,6 +22,8 @@
 #include <chrono>
 #include <cstddef>
 #include <memory>
+#include <utility>
+#include <vector>
 
 namespace couchbase
 {
@@ -42,6 +44,34 @@ public:
     return *this;
   }
 
+  /**
+   * Sets the percentiles, that the default (logging) meter reports for each operation.
+   *
+   * @param percentiles list of percentiles in range (0, 100], e.g. `{ 50.0, 99.0, 99.9 }`
+   * @return this options builder for chaining purposes.
+   */
+  auto percentiles(std::vector<double> percentiles) -> metrics_options&
+  {
+    percentiles_ = std::move(percentiles);
+    return *this;
+  }
+
+  /**
+   * Sets the number of shards of each value recorder of the default (logging) meter.
+   *
+   * Every shard keeps its own histograms, so that the threads recording into the same recorder do
+   * not contend on a single histogram, but each shard costs about 200KB per recorder. More than one
+   * shard only pays off when many IO threads record the same operation.
+   *
+   * @param number_of_shards number of shards, zero is treated as one.
+   * @return this options builder for chaining purposes.
+   */
+  auto number_of_shards(std::size_t number_of_shards) -> metrics_options&
+  {
+    number_of_shards_ = number_of_shards == 0 ? 1 : number_of_shards;
+    return *this;
+  }
+
   auto meter(std::shared_ptr<metrics::meter> custom_meter) -> metrics_options&
   {
     meter_ = std::move(custom_meter);
@@ -52,6 +82,8 @@ public:
     bool enabled;
     std::chrono::milliseconds emit_interval;
     std::shared_ptr<metrics::meter> meter;
+    std::vector<double> percentiles;
+    std::size_t number_of_shards;
   };
 
   [[nodiscard]] auto build() const -> built
@@ -60,6 +92,8 @@ public:
       enabled_,
       emit_interval_,
       meter_,
+      percentiles_,
+      number_of_shards_,
     };
   }
 
@@ -67,5 +101,7 @@ private:
   bool enabled_{ true };
   std::chrono::milliseconds emit_interval_{ default_emit_interval };
   std::shared_ptr<metrics::meter> meter_{ nullptr };
+  std::vector<double> percentiles_{ 50.0, 90.0, 99.0, 99.9, 100.0 };
+  std::size_t number_of_shards_{ 1 };
 };
 } // namespace couchbase
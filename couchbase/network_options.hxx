@@ -34,6 +34,8 @@ public:
   static constexpr std::chrono::milliseconds default_config_poll_interval{ 2'500 };
   static constexpr std::chrono::milliseconds default_config_poll_floor{ 50 };
   static constexpr std::chrono::milliseconds default_idle_http_connection_timeout{ 4'500 };
+  static constexpr std::size_t default_num_io_threads{ 1 };
+  static constexpr std::size_t default_kv_connections_per_node{ 1 };
 
   /**
    * Selects network to use.
@@ -130,6 +132,44 @@ public:
     return *this;
   }
 
+  /**
+   * Sets number of threads that drive the IO engine of the cluster.
+   *
+   * All network sessions, timers and completion handlers of the cluster are executed by the IO
+   * threads. Single thread is sufficient for most of the applications, but workloads with high
+   * rate of operations might benefit from spreading the IO across several cores.
+   *
+   * Note, that with more than one IO thread, the handlers of the operations might be invoked
+   * concurrently from different threads.
+   *
+   * @param number_of_threads number of IO threads (zero will be treated as one)
+   * @return this object for chaining purposes.
+   *
+   * @volatile This option is considered unstable and may change in future releases.
+   */
+  auto num_io_threads(std::size_t number_of_threads) -> network_options&
+  {
+    num_io_threads_ = number_of_threads == 0 ? 1 : number_of_threads;
+    return *this;
+  }
+
+  /**
+   * Sets number of KV connections that will be opened to each node of the bucket.
+   *
+   * Operations are routed to the connection with the smallest number of outstanding requests, so
+   * that large values or slow responses do not stall everything behind them.
+   *
+   * @param number_of_connections number of connections per node (zero will be treated as one)
+   * @return this object for chaining purposes.
+   *
+   * @volatile This option is considered unstable and may change in future releases.
+   */
+  auto kv_connections_per_node(std::size_t number_of_connections) -> network_options&
+  {
+    kv_connections_per_node_ = number_of_connections == 0 ? 1 : number_of_connections;
+    return *this;
+  }
+
   struct built {
     std::string network;
     std::string server_group;
@@ -140,6 +180,8 @@ public:
     std::chrono::milliseconds idle_http_connection_timeout;
     std::optional<std::size_t> max_http_connections;
     bool enable_lazy_connections;
+    std::size_t num_io_threads;
+    std::size_t kv_connections_per_node;
   };
 
   [[nodiscard]] auto build() const -> built
@@ -154,6 +196,8 @@ public:
       idle_http_connection_timeout_,
       max_http_connections_,
       enable_lazy_connections_,
+      num_io_threads_,
+      kv_connections_per_node_,
     };
   }
 
@@ -168,5 +212,7 @@ private:
   std::chrono::milliseconds idle_http_connection_timeout_{ default_idle_http_connection_timeout };
   std::optional<std::size_t> max_http_connections_{};
   bool enable_lazy_connections_{ false };
+  std::size_t num_io_threads_{ default_num_io_threads };
+  std::size_t kv_connections_per_node_{ default_kv_connections_per_node };
 };
 } // namespace couchbase
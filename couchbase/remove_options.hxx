@@ -25,8 +25,11 @@
 
 #include <chrono>
 #include <functional>
+#include <map>
 #include <memory>
 #include <optional>
+#include <string>
+#include <utility>
 #include <vector>
 
 namespace couchbase
@@ -101,4 +104,21 @@ private:
  * @uncommitted
  */
 using remove_handler = std::function<void(error, mutation_result)>;
+
+/**
+ * The results of the @ref collection#remove_multi() operation: the outcome of every document,
+ * keyed by its ID.
+ *
+ * @since 1.3.2
+ * @uncommitted
+ */
+using remove_multi_result = std::map<std::string, std::pair<error, mutation_result>>;
+
+/**
+ * The signature for the handler of the @ref collection#remove_multi() operation
+ *
+ * @since 1.3.2
+ * @uncommitted
+ */
+using remove_multi_handler = std::function<void(remove_multi_result)>;
 } // namespace couchbase
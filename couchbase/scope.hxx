@@ -18,12 +18,15 @@
 #pragma once
 
 #include <couchbase/analytics_options.hxx>
+#include <couchbase/analytics_row_stream.hxx>
 #include <couchbase/collection.hxx>
 #include <couchbase/query_options.hxx>
+#include <couchbase/query_row_stream.hxx>
 #include <couchbase/scope_search_index_manager.hxx>
 #include <couchbase/search_options.hxx>
 #include <couchbase/search_query.hxx>
 #include <couchbase/search_request.hxx>
+#include <couchbase/search_row_stream.hxx>
 
 #include <memory>
 
@@ -113,6 +116,40 @@ public:
   [[nodiscard]] auto query(std::string statement, const query_options& options = {}) const
     -> std::future<std::pair<error, query_result>>;
 
+  /**
+   * Performs a query against the query (N1QL) services, and streams the rows of the result.
+   *
+   * Unlike @ref query(), the rows are not collected into memory. The handler is invoked as soon as
+   * the query engine starts sending the rows, and the rows are retrieved one by one with
+   * @ref query_row_stream#next_row(). The metadata is available once all rows have been consumed.
+   *
+   * @param statement the N1QL query statement.
+   * @param options options to customize the query request.
+   * @param handler the handler that implements @ref query_stream_handler
+   *
+   * @exception errc::common::ambiguous_timeout
+   * @exception errc::common::unambiguous_timeout
+   *
+   * @since 1.3.2
+   * @uncommitted
+   */
+  void query_stream(std::string statement,
+                    const query_options& options,
+                    query_stream_handler&& handler) const;
+
+  /**
+   * Performs a query against the query (N1QL) services, and streams the rows of the result.
+   *
+   * @param statement the N1QL query statement.
+   * @param options options to customize the query request.
+   * @return future object that carries the row stream
+   *
+   * @since 1.3.2
+   * @uncommitted
+   */
+  [[nodiscard]] auto query_stream(std::string statement, const query_options& options = {}) const
+    -> std::future<std::pair<error, query_row_stream>>;
+
   /**
    * Performs a request against the full text search services.
    *
@@ -159,6 +196,46 @@ public:
                             const search_options& options = {}) const
     -> std::future<std::pair<error, search_result>>;
 
+  /**
+   * Performs a request against the full text search services, and streams the rows of the result.
+   *
+   * Unlike @ref search(), the rows are not collected into memory. The handler is invoked as soon as
+   * the search engine starts sending the rows, and the rows are retrieved one by one with
+   * @ref search_row_stream#next_row(). The metadata and facets are available once all rows have
+   * been consumed.
+   *
+   * @param index_name name of the search index
+   * @param request request object, see @ref search_request for more details.
+   * @param options options to customize the query request.
+   * @param handler the handler that implements @ref search_stream_handler
+   *
+   * @exception errc::common::ambiguous_timeout
+   * @exception errc::common::unambiguous_timeout
+   *
+   * @since 1.3.2
+   * @uncommitted
+   */
+  void search_stream(std::string index_name,
+                     search_request request,
+                     const search_options& options,
+                     search_stream_handler&& handler) const;
+
+  /**
+   * Performs a request against the full text search services, and streams the rows of the result.
+   *
+   * @param index_name name of the search index
+   * @param request request object, see @ref search_request for more details.
+   * @param options options to customize the query request.
+   * @return future object that carries the row stream
+   *
+   * @since 1.3.2
+   * @uncommitted
+   */
+  [[nodiscard]] auto search_stream(std::string index_name,
+                                   search_request request,
+                                   const search_options& options = {}) const
+    -> std::future<std::pair<error, search_row_stream>>;
+
   /**
    * Performs a query against the analytics services.
    *
@@ -193,6 +270,42 @@ public:
   [[nodiscard]] auto analytics_query(std::string statement, const analytics_options& options = {})
     const -> std::future<std::pair<error, analytics_result>>;
 
+  /**
+   * Performs a query against the analytics services, and streams the rows of the result.
+   *
+   * Unlike @ref analytics_query(), the rows are not collected into memory. The handler is invoked
+   * as soon as the analytics engine starts sending the rows, and the rows are retrieved one by one
+   * with @ref analytics_row_stream#next_row(). The metadata is available once all rows have been
+   * consumed.
+   *
+   * @param statement the query statement.
+   * @param options options to customize the query request.
+   * @param handler the handler that implements @ref analytics_stream_handler
+   *
+   * @exception errc::common::ambiguous_timeout
+   * @exception errc::common::unambiguous_timeout
+   *
+   * @since 1.3.2
+   * @uncommitted
+   */
+  void analytics_query_stream(std::string statement,
+                              const analytics_options& options,
+                              analytics_stream_handler&& handler) const;
+
+  /**
+   * Performs a query against the analytics services, and streams the rows of the result.
+   *
+   * @param statement the query statement.
+   * @param options options to customize the query request.
+   * @return future object that carries the row stream
+   *
+   * @since 1.3.2
+   * @uncommitted
+   */
+  [[nodiscard]] auto analytics_query_stream(std::string statement,
+                                            const analytics_options& options = {}) const
+    -> std::future<std::pair<error, analytics_row_stream>>;
+
   /**
    * Provides access to search index management services at the scope level
    *
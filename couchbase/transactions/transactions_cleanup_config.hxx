@@ -18,6 +18,7 @@
 #include <couchbase/transactions/transaction_keyspace.hxx>
 
 #include <chrono>
+#include <cstddef>
 #include <list>
 
 namespace couchbase::transactions
@@ -121,18 +122,83 @@ public:
     return *this;
   }
 
+  /**
+   * @brief Set the maximum number of ATRs that the lost attempts cleanup reads concurrently.
+   *
+   * The limit is shared by all collections being cleaned, so the number of outstanding reads does
+   * not grow with the number of collections.
+   *
+   * @param value maximum number of ATR reads in flight.
+   * @return reference to this, so calls can be chained.
+   *
+   * @since 1.3.2
+   * @uncommitted
+   */
+  auto max_concurrent_atr_reads(std::size_t value) -> transactions_cleanup_config&
+  {
+    max_concurrent_atr_reads_ = value;
+    return *this;
+  }
+
+  /**
+   * @brief Get the maximum number of concurrent ATR reads of the lost attempts cleanup.
+   *
+   * @return maximum number of ATR reads in flight.
+   *
+   * @since 1.3.2
+   * @uncommitted
+   */
+  [[nodiscard]] auto max_concurrent_atr_reads() const -> std::size_t
+  {
+    return max_concurrent_atr_reads_;
+  }
+
+  /**
+   * @brief Set the maximum rate of ATR reads of the lost attempts cleanup.
+   *
+   * The rate is shared by all collections being cleaned. By default it is zero, and the reads are
+   * only paced by the @ref cleanup_window().
+   *
+   * @param value maximum number of ATR reads per second, or zero to disable the limit.
+   * @return reference to this, so calls can be chained.
+   *
+   * @since 1.3.2
+   * @uncommitted
+   */
+  auto max_atr_reads_per_second(std::size_t value) -> transactions_cleanup_config&
+  {
+    max_atr_reads_per_second_ = value;
+    return *this;
+  }
+
+  /**
+   * @brief Get the maximum rate of ATR reads of the lost attempts cleanup.
+   *
+   * @return maximum number of ATR reads per second, zero if not limited.
+   *
+   * @since 1.3.2
+   * @uncommitted
+   */
+  [[nodiscard]] auto max_atr_reads_per_second() const -> std::size_t
+  {
+    return max_atr_reads_per_second_;
+  }
+
   /** @private */
   struct built {
     bool cleanup_lost_attempts;
     bool cleanup_client_attempts;
     std::chrono::milliseconds cleanup_window;
     std::list<couchbase::transactions::transaction_keyspace> collections;
+    std::size_t max_concurrent_atr_reads;
+    std::size_t max_atr_reads_per_second;
   };
 
   /** @private */
   [[nodiscard]] auto build() const -> built
   {
-    return { cleanup_lost_attempts_, cleanup_client_attempts_, cleanup_window_, collections_ };
+    return { cleanup_lost_attempts_,   cleanup_client_attempts_,  cleanup_window_,
+             collections_,            max_concurrent_atr_reads_, max_atr_reads_per_second_ };
   }
 
 private:
@@ -140,5 +206,7 @@ private:
   bool cleanup_client_attempts_{ true };
   std::chrono::milliseconds cleanup_window_{ std::chrono::seconds(60) };
   std::list<couchbase::transactions::transaction_keyspace> collections_{};
+  std::size_t max_concurrent_atr_reads_{ 16 };
+  std::size_t max_atr_reads_per_second_{ 0 };
 };
 } // namespace couchbase::transactions
@@ -25,8 +25,11 @@
 
 #include <chrono>
 #include <functional>
+#include <map>
 #include <memory>
 #include <optional>
+#include <string>
+#include <utility>
 #include <vector>
 
 namespace couchbase
@@ -136,4 +139,21 @@ private:
  * @uncommitted
  */
 using upsert_handler = std::function<void(error, mutation_result)>;
+
+/**
+ * The results of the @ref collection#upsert_multi() operation: the outcome of every document,
+ * keyed by its ID.
+ *
+ * @since 1.3.2
+ * @uncommitted
+ */
+using upsert_multi_result = std::map<std::string, std::pair<error, mutation_result>>;
+
+/**
+ * The signature for the handler of the @ref collection#upsert_multi() operation
+ *
+ * @since 1.3.2
+ * @uncommitted
+ */
+using upsert_multi_handler = std::function<void(upsert_multi_result)>;
 } // namespace couchbase
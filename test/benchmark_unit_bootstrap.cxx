@@ -0,0 +1,79 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2025-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test_helper.hxx"
+
+#include "utils/mock_mcbp_server.hxx"
+
+#include "core/sasl/scram-sha/salted_password_cache.h"
+
+#include <couchbase/cluster.hxx>
+
+#include <spdlog/fmt/bundled/core.h>
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+namespace
+{
+constexpr std::size_t number_of_sessions{ 100 };
+
+void
+bootstrap_session(const test::utils::mock_mcbp_server& server)
+{
+  auto cluster = test::utils::connect(server);
+  cluster.close().get();
+}
+
+template<typename Operation>
+void
+report_bootstrap_time(const std::string& name, Operation&& operation)
+{
+  auto& cache = couchbase::core::sasl::mechanism::scram::salted_password_cache::instance();
+  const auto derivations = cache.derivations();
+  const auto start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < number_of_sessions; ++i) {
+    operation();
+  }
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  fmt::println("{}: {} sessions in {}ms, {} key derivations",
+               name,
+               number_of_sessions,
+               std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count(),
+               cache.derivations() - derivations);
+}
+} // namespace
+
+TEST_CASE("benchmark: SCRAM bootstrap against mock server", "[benchmark]")
+{
+  test::utils::mock_mcbp_server_options options{};
+  // default iteration count of SCRAM-SHA512 secrets on Couchbase Server
+  options.scram_iteration_count = 15'000;
+  test::utils::mock_mcbp_server server{ options };
+
+  auto& cache = couchbase::core::sasl::mechanism::scram::salted_password_cache::instance();
+
+  // clearing the cache before every session shows the cost of the bootstrap without it
+  report_bootstrap_time("cold cache", [&server, &cache]() {
+    cache.clear();
+    bootstrap_session(server);
+  });
+  report_bootstrap_time("warm cache", [&server]() {
+    bootstrap_session(server);
+  });
+}
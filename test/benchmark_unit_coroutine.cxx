@@ -0,0 +1,107 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2025-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test_helper.hxx"
+
+#include "utils/coroutine_task.hxx"
+#include "utils/mock_mcbp_server.hxx"
+
+#include <couchbase/codec/tao_json_serializer.hxx>
+#include <couchbase/coroutine.hxx>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <tao/json/value.hpp>
+
+#include <cstddef>
+#include <string>
+#include <system_error>
+
+namespace
+{
+constexpr std::size_t operations_per_run{ 100 };
+
+auto
+get_sequentially(couchbase::collection collection) -> test::utils::coroutine_task<std::error_code>
+{
+  for (std::size_t i = 0; i < operations_per_run; ++i) {
+    auto [err, res] = co_await couchbase::coro::get(collection, "foo");
+    if (err) {
+      co_return err.ec();
+    }
+  }
+  co_return std::error_code{};
+}
+
+auto
+upsert_sequentially(couchbase::collection collection, tao::json::value document)
+  -> test::utils::coroutine_task<std::error_code>
+{
+  for (std::size_t i = 0; i < operations_per_run; ++i) {
+    auto [err, res] = co_await couchbase::coro::upsert(collection, "foo", document);
+    if (err) {
+      co_return err.ec();
+    }
+  }
+  co_return std::error_code{};
+}
+} // namespace
+
+TEST_CASE("benchmark: coroutine and future front-ends against mock server", "[benchmark]")
+{
+  test::utils::mock_mcbp_server server{};
+  auto cluster = test::utils::connect(server);
+  auto collection = cluster.bucket(server.options().bucket_name).default_collection();
+
+  const tao::json::value document{
+    { "name", "Couchbase" },
+    { "type", "benchmark" },
+  };
+  {
+    auto [err, result] = collection.upsert("foo", document).get();
+    REQUIRE_SUCCESS(err.ec());
+  }
+
+  // The future can only be waited for outside of the IO thread, so each future operation
+  // blocks the benchmark thread, while the coroutine chains the operations on the IO thread.
+  BENCHMARK("future: 100 x get")
+  {
+    for (std::size_t i = 0; i < operations_per_run; ++i) {
+      auto [err, res] = collection.get("foo").get();
+      REQUIRE_SUCCESS(err.ec());
+    }
+  };
+
+  BENCHMARK("coroutine: 100 x get")
+  {
+    REQUIRE_SUCCESS(get_sequentially(collection).result.get());
+  };
+
+  BENCHMARK("future: 100 x upsert")
+  {
+    for (std::size_t i = 0; i < operations_per_run; ++i) {
+      auto [err, res] = collection.upsert("foo", document).get();
+      REQUIRE_SUCCESS(err.ec());
+    }
+  };
+
+  BENCHMARK("coroutine: 100 x upsert")
+  {
+    REQUIRE_SUCCESS(upsert_sequentially(collection, document).result.get());
+  };
+
+  cluster.close().get();
+}
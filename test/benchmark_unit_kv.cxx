@@ -0,0 +1,183 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2025-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test_helper.hxx"
+
+#include "utils/mock_mcbp_server.hxx"
+
+#include <couchbase/cluster.hxx>
+#include <couchbase/codec/tao_json_serializer.hxx>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <spdlog/fmt/bundled/core.h>
+#include <tao/json/value.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+std::atomic_size_t allocations_count{ 0 };
+} // namespace
+
+// Counts the allocations of the whole process (SDK, mock server and the benchmark itself), so the
+// numbers are only meaningful relative to each other.
+auto
+operator new(std::size_t size) -> void*
+{
+  ++allocations_count;
+  if (void* pointer = std::malloc(size == 0 ? 1 : size); pointer != nullptr) {
+    return pointer;
+  }
+  throw std::bad_alloc{};
+}
+
+void
+operator delete(void* pointer) noexcept
+{
+  std::free(pointer);
+}
+
+void
+operator delete(void* pointer, std::size_t /* size */) noexcept
+{
+  std::free(pointer);
+}
+
+namespace
+{
+struct kv_fixture {
+  explicit kv_fixture(test::utils::mock_mcbp_server_options options = {})
+    : server{ std::move(options) }
+    , cluster{ test::utils::connect(server) }
+    , collection{ cluster.bucket(server.options().bucket_name).default_collection() }
+  {
+  }
+
+  kv_fixture(const kv_fixture&) = delete;
+  kv_fixture(kv_fixture&&) = delete;
+  auto operator=(const kv_fixture&) -> kv_fixture& = delete;
+  auto operator=(kv_fixture&&) -> kv_fixture& = delete;
+
+  ~kv_fixture()
+  {
+    cluster.close().get();
+  }
+
+  test::utils::mock_mcbp_server server;
+  couchbase::cluster cluster;
+  couchbase::collection collection;
+};
+
+const tao::json::value document{
+  { "name", "Couchbase" },
+  { "type", "benchmark" },
+  { "numbers", tao::json::value::array({ 1, 2, 3, 4, 5, 6, 7, 8 }) },
+};
+
+template<typename Operation>
+void
+report_latency_profile(const std::string& name, std::size_t iterations, Operation&& operation)
+{
+  std::vector<std::chrono::nanoseconds> latencies{};
+  latencies.reserve(iterations);
+
+  const auto allocations_before = allocations_count.load();
+  const auto start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < iterations; ++i) {
+    const auto operation_start = std::chrono::steady_clock::now();
+    operation(i);
+    latencies.emplace_back(std::chrono::steady_clock::now() - operation_start);
+  }
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  const auto allocations = allocations_count.load() - allocations_before;
+
+  std::sort(latencies.begin(), latencies.end());
+  const auto percentile = [&latencies](double p) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+             latencies[static_cast<std::size_t>(p * static_cast<double>(latencies.size() - 1))])
+      .count();
+  };
+  fmt::println("{}: {} ops, {:.0f} ops/s, p50={}us, p99={}us, {:.1f} allocations/op",
+               name,
+               iterations,
+               static_cast<double>(iterations) / std::chrono::duration<double>(elapsed).count(),
+               percentile(0.50),
+               percentile(0.99),
+               static_cast<double>(allocations) / static_cast<double>(iterations));
+}
+} // namespace
+
+TEST_CASE("benchmark: get and upsert against mock server", "[benchmark]")
+{
+  kv_fixture fixture{};
+  {
+    auto [err, result] = fixture.collection.upsert("foo", document).get();
+    REQUIRE_SUCCESS(err.ec());
+  }
+
+  BENCHMARK("get")
+  {
+    auto [err, result] = fixture.collection.get("foo").get();
+    REQUIRE_SUCCESS(err.ec());
+  };
+
+  BENCHMARK("upsert")
+  {
+    auto [err, result] = fixture.collection.upsert("foo", document).get();
+    REQUIRE_SUCCESS(err.ec());
+  };
+}
+
+TEST_CASE("benchmark: latency profile against mock server", "[benchmark]")
+{
+  constexpr std::size_t iterations{ 10'000 };
+
+  test::utils::mock_mcbp_server_options options{};
+  SECTION("no latency")
+  {
+  }
+  SECTION("100us latency")
+  {
+    options.latency = std::chrono::microseconds{ 100 };
+  }
+  SECTION("compressed responses")
+  {
+    options.compress_responses = true;
+  }
+  SECTION("not my vbucket on every 100th operation")
+  {
+    options.not_my_vbucket_every = 100;
+  }
+
+  kv_fixture fixture{ options };
+
+  report_latency_profile("upsert", iterations, [&fixture](std::size_t i) {
+    auto [err, result] = fixture.collection.upsert(fmt::format("doc-{}", i % 100), document).get();
+    REQUIRE_SUCCESS(err.ec());
+  });
+  report_latency_profile("get", iterations, [&fixture](std::size_t i) {
+    auto [err, result] = fixture.collection.get(fmt::format("doc-{}", i % 100)).get();
+    REQUIRE_SUCCESS(err.ec());
+  });
+}
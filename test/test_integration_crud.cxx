@@ -1208,3 +1208,73 @@ TEST_CASE(
     REQUIRE(tao::json::empty_object == resp.content_as<tao::json::value>());
   }
 }
+
+TEST_CASE("integration: multi-document operations with public API", "[integration]")
+{
+  test::utils::integration_test_guard integration;
+
+  auto cluster = integration.public_cluster();
+  auto collection = cluster.bucket(integration.ctx.bucket).default_collection();
+
+  std::vector<std::pair<std::string, tao::json::value>> documents{};
+  std::vector<std::string> ids{};
+  for (int i = 0; i < 50; ++i) {
+    auto id = test::utils::uniq_id("multi");
+    ids.push_back(id);
+    documents.emplace_back(id, tao::json::value{ { "index", i } });
+  }
+
+  {
+    auto results = collection.upsert_multi(documents).get();
+    REQUIRE(results.size() == ids.size());
+    for (const auto& [id, outcome] : results) {
+      REQUIRE_SUCCESS(outcome.first.ec());
+      REQUIRE_FALSE(outcome.second.cas().empty());
+    }
+  }
+
+  auto missing_id = test::utils::uniq_id("missing");
+  {
+    auto request_ids = ids;
+    request_ids.push_back(missing_id);
+    auto results = collection.get_multi(request_ids).get();
+    REQUIRE(results.size() == request_ids.size());
+    for (int i = 0; i < static_cast<int>(ids.size()); ++i) {
+      const auto& [err, resp] = results.at(ids[static_cast<std::size_t>(i)]);
+      REQUIRE_SUCCESS(err.ec());
+      REQUIRE(resp.content_as<tao::json::value>() == tao::json::value{ { "index", i } });
+    }
+    REQUIRE(results.at(missing_id).first.ec() == couchbase::errc::key_value::document_not_found);
+  }
+
+  {
+    // duplicate IDs are collapsed, and the last document of the upsert batch wins
+    const auto& id = ids.front();
+    std::vector<std::pair<std::string, tao::json::value>> duplicates{
+      { id, tao::json::value{ { "index", -1 } } },
+      { id, tao::json::value{ { "index", -2 } } },
+    };
+    auto upserted = collection.upsert_multi(duplicates).get();
+    REQUIRE(upserted.size() == 1);
+    REQUIRE_SUCCESS(upserted.at(id).first.ec());
+
+    auto results = collection.get_multi({ id, id }).get();
+    REQUIRE(results.size() == 1);
+    REQUIRE_SUCCESS(results.at(id).first.ec());
+    REQUIRE(results.at(id).second.content_as<tao::json::value>() ==
+            tao::json::value{ { "index", -2 } });
+  }
+
+  {
+    auto results = collection.remove_multi(ids).get();
+    REQUIRE(results.size() == ids.size());
+    for (const auto& [id, outcome] : results) {
+      REQUIRE_SUCCESS(outcome.first.ec());
+    }
+  }
+
+  {
+    auto results = collection.get_multi({}).get();
+    REQUIRE(results.empty());
+  }
+}
@@ -0,0 +1,218 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2025 Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test_helper.hxx"
+
+#include "core/compression_policy.hxx"
+#include "core/document_id.hxx"
+#include "core/io/mcbp_output_buffer.hxx"
+#include "core/protocol/client_request.hxx"
+#include "core/protocol/cmd_upsert.hxx"
+#include "core/protocol/datatype.hxx"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+using upsert_request = couchbase::core::protocol::client_request<
+  couchbase::core::protocol::upsert_request_body>;
+
+auto
+make_request(const std::vector<std::byte>& value) -> upsert_request
+{
+  upsert_request req;
+  req.opaque(42);
+  req.partition(115);
+  req.body().id(couchbase::core::document_id{ "default", "_default", "_default", "foo" });
+  req.body().flags(0x02000006);
+  req.body().content(value);
+  return req;
+}
+
+auto
+make_incompressible_value(std::size_t size) -> std::vector<std::byte>
+{
+  std::mt19937 gen{ 42 }; // NOLINT(cert-msc32-c,cert-msc51-cpp)
+  std::uniform_int_distribution<int> dist{ 0, 255 };
+  std::vector<std::byte> value(size);
+  for (auto& b : value) {
+    b = static_cast<std::byte>(dist(gen));
+  }
+  return value;
+}
+
+auto
+flatten(const couchbase::core::io::mcbp_output_buffer& buffer) -> std::vector<std::byte>
+{
+  std::vector<std::byte> data{ buffer.head };
+  data.insert(data.end(), buffer.value.begin(), buffer.value.end());
+  return data;
+}
+} // namespace
+
+TEST_CASE("unit: gathered request refers to the value instead of copying it", "[unit]")
+{
+  auto owner = std::make_shared<int>(0);
+  couchbase::core::compression_policy policy{ {} };
+
+  SECTION("value is not compressed")
+  {
+    const auto value = make_incompressible_value(100'000);
+
+    auto gathered = make_request(value).gathered_data(&policy, owner);
+    REQUIRE(gathered.value.data() == value.data());
+    REQUIRE(gathered.value.size() == value.size());
+    REQUIRE(gathered.value_owner == owner);
+    REQUIRE(gathered.head.size() < 100);
+    REQUIRE(flatten(gathered) == make_request(value).data(true));
+  }
+
+  SECTION("compressed value is owned by the message")
+  {
+    const std::vector<std::byte> value(100'000, std::byte{ 'x' });
+
+    auto gathered = make_request(value).gathered_data(&policy, owner);
+    REQUIRE(gathered.value.empty());
+    REQUIRE(gathered.value_owner == nullptr);
+    REQUIRE(gathered.head.size() < value.size());
+    REQUIRE(couchbase::core::protocol::has_flag(gathered.head[5],
+                                                couchbase::core::protocol::datatype::snappy));
+    REQUIRE(gathered.head == make_request(value).data(true));
+  }
+
+  SECTION("small value")
+  {
+    const std::vector<std::byte> value{ std::byte{ '4' }, std::byte{ '2' } };
+
+    auto gathered = make_request(value).gathered_data(&policy, owner);
+    REQUIRE(gathered.value.size() == 2);
+    REQUIRE(flatten(gathered) == make_request(value).data(true));
+  }
+}
+
+TEST_CASE("benchmark: encode large upsert", "[.][benchmark]")
+{
+  auto owner = std::make_shared<int>(0);
+
+  for (const std::size_t size : { 100'000, 1'000'000 }) {
+    const auto value = make_incompressible_value(size);
+
+    BENCHMARK("contiguous: " + std::to_string(size) + " bytes")
+    {
+      return make_request(value).data(false).size();
+    };
+
+    BENCHMARK("gathered: " + std::to_string(size) + " bytes")
+    {
+      return make_request(value).gathered_data(nullptr, owner).size();
+    };
+  }
+}
+
+TEST_CASE("unit: compression policy", "[unit]")
+{
+  const std::vector<std::byte> compressible(1'000, std::byte{ 'x' });
+  const auto incompressible = make_incompressible_value(1'000);
+
+  SECTION("small values are not compressed")
+  {
+    couchbase::core::compression_policy policy{ { 2'000 } };
+
+    std::vector<std::byte> output{};
+    REQUIRE_FALSE(policy.compress(compressible, output));
+    REQUIRE(output.empty());
+    REQUIRE(policy.stats().number_of_attempts == 0);
+  }
+
+  SECTION("counts saved bytes")
+  {
+    couchbase::core::compression_policy policy{ {} };
+
+    std::vector<std::byte> output{ std::byte{ 0 } };
+    REQUIRE(policy.compress(compressible, output));
+    REQUIRE_FALSE(policy.compress(incompressible, output));
+    const auto stats = policy.stats();
+    REQUIRE(stats.number_of_attempts == 2);
+    REQUIRE(stats.number_of_compressed_values == 1);
+    REQUIRE(stats.bytes_before_compression == 2'000);
+    REQUIRE(stats.bytes_saved == compressible.size() - (output.size() - 1));
+  }
+
+  SECTION("disabled collection")
+  {
+    couchbase::core::compression_policy_options options{};
+    options.disabled_collections.insert("travel-sample.inventory.hotel");
+    const couchbase::core::compression_policy policy{ options };
+
+    REQUIRE_FALSE(policy.enabled_for(
+      couchbase::core::document_id{ "travel-sample", "inventory", "hotel", "foo" }));
+    REQUIRE(policy.enabled_for(
+      couchbase::core::document_id{ "travel-sample", "inventory", "airline", "foo" }));
+  }
+
+  SECTION("disabled collection of bucket with dots in the name")
+  {
+    couchbase::core::compression_policy_options options{};
+    options.disabled_collections.insert("travel.sample.inventory.hotel");
+    const couchbase::core::compression_policy policy{ options };
+
+    REQUIRE_FALSE(policy.enabled_for(
+      couchbase::core::document_id{ "travel.sample", "inventory", "hotel", "foo" }));
+    REQUIRE(policy.enabled_for(
+      couchbase::core::document_id{ "travel", "sample", "inventory", "foo" }));
+  }
+
+  SECTION("adaptive mode backs off after poor ratios")
+  {
+    using couchbase::core::compression_policy;
+    compression_policy policy{ {} };
+
+    std::vector<std::byte> output{};
+    for (std::uint32_t i = 0; i < compression_policy::poor_ratio_streak_to_back_off; ++i) {
+      REQUIRE_FALSE(policy.compress(incompressible, output));
+    }
+    for (std::uint32_t i = 0; i < compression_policy::initial_back_off; ++i) {
+      REQUIRE_FALSE(policy.compress(compressible, output));
+    }
+    REQUIRE(policy.stats().number_of_skipped_values == compression_policy::initial_back_off);
+    REQUIRE(policy.stats().number_of_attempts ==
+            compression_policy::poor_ratio_streak_to_back_off);
+
+    // the good ratio resets the back off
+    REQUIRE(policy.compress(compressible, output));
+  }
+
+  SECTION("non-adaptive mode tries every value")
+  {
+    couchbase::core::compression_policy_options options{};
+    options.adaptive = false;
+    couchbase::core::compression_policy policy{ options };
+
+    std::vector<std::byte> output{};
+    for (int i = 0; i < 100; ++i) {
+      REQUIRE_FALSE(policy.compress(incompressible, output));
+    }
+    REQUIRE(policy.compress(compressible, output));
+    REQUIRE(policy.stats().number_of_skipped_values == 0);
+  }
+}
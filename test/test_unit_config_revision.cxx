@@ -0,0 +1,92 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2025-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test_helper.hxx"
+
+#include "core/protocol/cmd_get_cluster_config.hxx"
+
+#include <string>
+
+TEST_CASE("unit: peek_config_revision extracts top-level revision", "[unit]")
+{
+  using couchbase::core::protocol::peek_config_revision;
+
+  SECTION("revision with epoch")
+  {
+    auto revision = peek_config_revision(R"({"rev":1073,"revEpoch":2,"name":"default"})");
+    REQUIRE(revision.has_value());
+    CHECK(revision->rev == 1073);
+    CHECK(revision->epoch == 2);
+  }
+
+  SECTION("revision without epoch")
+  {
+    auto revision = peek_config_revision(R"({ "name" : "default", "rev" : 42 })");
+    REQUIRE(revision.has_value());
+    CHECK(revision->rev == 42);
+    CHECK_FALSE(revision->epoch.has_value());
+  }
+
+  SECTION("nested fields and string values are ignored")
+  {
+    auto revision = peek_config_revision(
+      R"({"nodesExt":[{"rev":1,"hostname":"rev"}],"uuid":"a\"rev\"b","name":"rev","rev":7})");
+    REQUIRE(revision.has_value());
+    CHECK(revision->rev == 7);
+    CHECK_FALSE(revision->epoch.has_value());
+  }
+
+  SECTION("missing or malformed revision")
+  {
+    CHECK_FALSE(peek_config_revision(R"({"name":"default"})").has_value());
+    CHECK_FALSE(peek_config_revision(R"({"rev":"abc"})").has_value());
+    CHECK_FALSE(peek_config_revision(R"({"name":"unterminated)").has_value());
+    CHECK_FALSE(peek_config_revision("").has_value());
+  }
+}
+
+TEST_CASE("unit: peek_config_revision agrees with parse_config", "[unit]")
+{
+  using couchbase::core::protocol::config_revision;
+  using couchbase::core::protocol::parse_config;
+  using couchbase::core::protocol::peek_config_revision;
+
+  const std::string config_text = R"({
+    "rev": 2718,
+    "nodesExt": [
+      {"services": {"kv": 11210, "mgmt": 8091}, "thisNode": true, "hostname": "$HOST"}
+    ],
+    "clusterCapabilitiesVer": [1, 0],
+    "revEpoch": 3
+  })";
+
+  auto config = parse_config(config_text, "127.0.0.1", 11210);
+  auto revision = peek_config_revision(config_text);
+  REQUIRE(revision.has_value());
+  CHECK(revision.value() == config_revision{ config.epoch, config.rev });
+}
+
+TEST_CASE("unit: config_revision ordering", "[unit]")
+{
+  using couchbase::core::protocol::config_revision;
+
+  CHECK(config_revision{ {}, 10 } < config_revision{ {}, 11 });
+  CHECK(config_revision{ {}, 100 } < config_revision{ 1, 1 });
+  CHECK(config_revision{ 1, 100 } < config_revision{ 2, 1 });
+  CHECK(config_revision{ 2, 5 } <= config_revision{ 2, 5 });
+  CHECK_FALSE(config_revision{ 2, 6 } <= config_revision{ 2, 5 });
+}
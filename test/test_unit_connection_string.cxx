@@ -532,6 +532,27 @@ TEST_CASE("unit: connection string", "[unit]")
         "1%3B%20v8%2F7.7.299.11-node.12%3B%20ssl%2F1.1.1c)");
       CHECK(spec.options.user_agent_extra ==
             "couchnode/4.1.1 (node/12.11.1; v8/7.7.299.11-node.12; ssl/1.1.1c)");
+
+      spec = couchbase::core::utils::parse_connection_string(
+        "couchbase://127.0.0.1?kv_connections_per_node=4");
+      CHECK(spec.options.kv_connections_per_node == 4);
+
+      spec = couchbase::core::utils::parse_connection_string(
+        "couchbase://127.0.0.1?prepared_statement_cache_capacity=100");
+      CHECK(spec.options.prepared_statement_cache_capacity == 100);
+
+      spec = couchbase::core::utils::parse_connection_string(
+        "couchbase://127.0.0.1?metrics_number_of_shards=4");
+      CHECK(spec.options.metrics_options.number_of_shards == 4);
+
+      spec = couchbase::core::utils::parse_connection_string(
+        "couchbase://127.0.0.1?streaming_row_buffer_size=16");
+      CHECK(spec.options.streaming_row_buffer_size == 16);
+
+      spec = couchbase::core::utils::parse_connection_string(
+        "couchbase://127.0.0.1?compression_min_size=1024&compression_adaptive=false");
+      CHECK(spec.options.compression_policy.min_size == 1024);
+      CHECK_FALSE(spec.options.compression_policy.adaptive);
     }
   }
 
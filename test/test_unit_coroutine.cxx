@@ -0,0 +1,126 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2025-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test_helper.hxx"
+
+#include "utils/coroutine_task.hxx"
+#include "utils/mock_mcbp_server.hxx"
+
+#include <couchbase/codec/tao_json_serializer.hxx>
+#include <couchbase/coroutine.hxx>
+
+#include <spdlog/fmt/bundled/core.h>
+#include <tao/json/value.hpp>
+
+#include <set>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace
+{
+struct roundtrip_result {
+  std::error_code upsert_ec{};
+  std::error_code get_ec{};
+  std::error_code missing_ec{};
+  tao::json::value content{};
+  std::thread::id caller{};
+  std::thread::id resumed_on{};
+};
+
+auto
+roundtrip(couchbase::collection collection) -> test::utils::coroutine_task<roundtrip_result>
+{
+  roundtrip_result result{};
+  result.caller = std::this_thread::get_id();
+
+  auto [upsert_err, upsert_res] = co_await couchbase::coro::upsert(
+    collection, "coro", tao::json::value{ { "awaited", true } });
+  result.upsert_ec = upsert_err.ec();
+  result.resumed_on = std::this_thread::get_id();
+
+  auto [get_err, get_res] = co_await couchbase::coro::get(collection, "coro");
+  result.get_ec = get_err.ec();
+  if (!get_err) {
+    result.content = get_res.content_as<tao::json::value>();
+  }
+
+  auto [missing_err, missing_res] = co_await couchbase::coro::get(collection, "missing");
+  result.missing_ec = missing_err.ec();
+
+  co_return result;
+}
+
+auto
+scan_ids(couchbase::collection collection)
+  -> test::utils::coroutine_task<std::pair<std::error_code, std::set<std::string>>>
+{
+  std::set<std::string> ids{};
+  auto [err, scan] = co_await couchbase::coro::scan(collection, couchbase::prefix_scan{ "item-" });
+  if (err) {
+    co_return std::make_pair(err.ec(), ids);
+  }
+  while (true) {
+    auto [item_err, item] = co_await couchbase::coro::next(scan);
+    if (item_err) {
+      co_return std::make_pair(item_err.ec(), ids);
+    }
+    if (!item) {
+      break;
+    }
+    ids.insert(item->id());
+  }
+  co_return std::make_pair(std::error_code{}, ids);
+}
+} // namespace
+
+TEST_CASE("unit: coroutine front-end resumes on the IO thread", "[unit]")
+{
+  test::utils::mock_mcbp_server server{};
+  auto cluster = test::utils::connect(server);
+  auto collection = cluster.bucket(server.options().bucket_name).default_collection();
+
+  auto result = roundtrip(collection).result.get();
+  REQUIRE_SUCCESS(result.upsert_ec);
+  REQUIRE_SUCCESS(result.get_ec);
+  REQUIRE(result.content == tao::json::value{ { "awaited", true } });
+  REQUIRE(result.missing_ec == couchbase::errc::key_value::document_not_found);
+  REQUIRE(result.resumed_on != result.caller);
+
+  cluster.close().get();
+}
+
+TEST_CASE("unit: coroutine front-end scans the collection", "[unit]")
+{
+  test::utils::mock_mcbp_server server{};
+  std::set<std::string> expected{};
+  for (int i = 0; i < 20; ++i) {
+    auto key = fmt::format("item-{}", i);
+    server.upsert(key, { std::byte{ '{' }, std::byte{ '}' } });
+    expected.insert(key);
+  }
+
+  auto cluster = test::utils::connect(server);
+  auto collection = cluster.bucket(server.options().bucket_name).default_collection();
+
+  auto [ec, ids] = scan_ids(collection).result.get();
+  REQUIRE_SUCCESS(ec);
+  REQUIRE(ids == expected);
+
+  cluster.close().get();
+}
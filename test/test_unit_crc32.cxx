@@ -0,0 +1,120 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2025-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test_helper.hxx"
+
+#include "core/utils/crc32.hxx"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+auto
+random_keys(std::size_t number_of_keys, std::size_t key_length) -> std::vector<std::string>
+{
+  std::mt19937 gen{ 42 };
+  std::uniform_int_distribution<int> dist{ 0, 255 };
+  std::vector<std::string> keys;
+  keys.reserve(number_of_keys);
+  for (std::size_t i = 0; i < number_of_keys; ++i) {
+    std::string key(key_length, '\0');
+    for (auto& c : key) {
+      c = static_cast<char>(dist(gen));
+    }
+    keys.emplace_back(std::move(key));
+  }
+  return keys;
+}
+} // namespace
+
+TEST_CASE("unit: crc32 matches known check value", "[unit]")
+{
+  using namespace couchbase::core::utils;
+
+  const std::string input{ "123456789" };
+  REQUIRE(~crc32_bytewise(UINT32_MAX, input.data(), input.size()) == 0xcbf43926);
+  REQUIRE(~crc32_slicing_by_8(UINT32_MAX, input.data(), input.size()) == 0xcbf43926);
+  REQUIRE(~crc32_update(UINT32_MAX, input.data(), input.size()) == 0xcbf43926);
+#if defined(COUCHBASE_CXX_CLIENT_HAS_HARDWARE_CRC32)
+  REQUIRE(~crc32_hardware(UINT32_MAX, input.data(), input.size()) == 0xcbf43926);
+#endif
+
+  REQUIRE(hash_crc32("", 0) == 0);
+}
+
+TEST_CASE("unit: crc32 implementations are bit-exact with the reference table", "[unit]")
+{
+  using namespace couchbase::core::utils;
+
+  // cover every tail length and misaligned starting offsets
+  const auto buffer = random_keys(1, 512).front();
+  for (std::size_t offset = 0; offset < 8; ++offset) {
+    for (std::size_t length = 0; length + offset <= 300; ++length) {
+      const auto* data = buffer.data() + offset;
+      const auto expected = crc32_bytewise(UINT32_MAX, data, length);
+      REQUIRE(crc32_slicing_by_8(UINT32_MAX, data, length) == expected);
+      REQUIRE(crc32_update(UINT32_MAX, data, length) == expected);
+#if defined(COUCHBASE_CXX_CLIENT_HAS_HARDWARE_CRC32)
+      REQUIRE(crc32_hardware(UINT32_MAX, data, length) == expected);
+#endif
+    }
+  }
+}
+
+TEST_CASE("benchmark: crc32 key hashing", "[.][benchmark]")
+{
+  using namespace couchbase::core::utils;
+
+  for (const std::size_t key_length : { 8U, 16U, 32U, 64U, 128U, 250U }) {
+    const auto keys = random_keys(1024, key_length);
+
+    BENCHMARK("bytewise " + std::to_string(key_length) + " byte keys")
+    {
+      std::uint32_t sum = 0;
+      for (const auto& key : keys) {
+        sum += crc32_bytewise(UINT32_MAX, key.data(), key.size());
+      }
+      return sum;
+    };
+
+    BENCHMARK("slicing-by-8 " + std::to_string(key_length) + " byte keys")
+    {
+      std::uint32_t sum = 0;
+      for (const auto& key : keys) {
+        sum += crc32_slicing_by_8(UINT32_MAX, key.data(), key.size());
+      }
+      return sum;
+    };
+
+#if defined(COUCHBASE_CXX_CLIENT_HAS_HARDWARE_CRC32)
+    BENCHMARK("hardware " + std::to_string(key_length) + " byte keys")
+    {
+      std::uint32_t sum = 0;
+      for (const auto& key : keys) {
+        sum += crc32_hardware(UINT32_MAX, key.data(), key.size());
+      }
+      return sum;
+    };
+#endif
+  }
+}
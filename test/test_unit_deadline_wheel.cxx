@@ -0,0 +1,160 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2025-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test_helper.hxx"
+
+#include "core/io/deadline_wheel.hxx"
+
+#include <asio/io_context.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+namespace
+{
+using couchbase::core::io::deadline_listener;
+using couchbase::core::io::deadline_wheel;
+
+class recording_listener : public deadline_listener
+{
+public:
+  explicit recording_listener(deadline_wheel::clock::time_point expiry)
+    : expiry_{ expiry }
+  {
+  }
+
+  void on_deadline() override
+  {
+    fired_at_ = deadline_wheel::clock::now();
+    ++number_of_calls_;
+  }
+
+  [[nodiscard]] auto expiry() const -> deadline_wheel::clock::time_point
+  {
+    return expiry_;
+  }
+
+  [[nodiscard]] auto fired_at() const -> deadline_wheel::clock::time_point
+  {
+    return fired_at_;
+  }
+
+  [[nodiscard]] auto number_of_calls() const -> int
+  {
+    return number_of_calls_;
+  }
+
+private:
+  deadline_wheel::clock::time_point expiry_;
+  deadline_wheel::clock::time_point fired_at_{};
+  int number_of_calls_{ 0 };
+};
+} // namespace
+
+TEST_CASE("unit: deadline_wheel fires deadlines, but never early", "[unit]")
+{
+  asio::io_context ctx;
+  // small wheel to make sure that deadlines wrap around the slots
+  auto wheel = std::make_shared<deadline_wheel>(ctx, std::chrono::milliseconds{ 2 }, 8);
+
+  std::vector<std::shared_ptr<recording_listener>> listeners;
+  const auto now = deadline_wheel::clock::now();
+  for (int i = 0; i < 50; ++i) {
+    auto listener = std::make_shared<recording_listener>(now + std::chrono::milliseconds{ i });
+    wheel->schedule(listener->expiry(), listener);
+    listeners.emplace_back(std::move(listener));
+  }
+  REQUIRE(wheel->size() == 50);
+
+  ctx.run();
+
+  REQUIRE(wheel->size() == 0);
+  for (const auto& listener : listeners) {
+    REQUIRE(listener->number_of_calls() == 1);
+    REQUIRE(listener->fired_at() >= listener->expiry());
+  }
+}
+
+TEST_CASE("unit: deadline_wheel does not fire cancelled deadlines", "[unit]")
+{
+  asio::io_context ctx;
+  auto wheel = std::make_shared<deadline_wheel>(ctx, std::chrono::milliseconds{ 2 }, 8);
+
+  const auto expiry = deadline_wheel::clock::now() + std::chrono::milliseconds{ 10 };
+  auto cancelled = std::make_shared<recording_listener>(expiry);
+  auto kept = std::make_shared<recording_listener>(expiry);
+
+  auto handle = wheel->schedule(expiry, cancelled);
+  wheel->schedule(expiry, kept);
+  REQUIRE(wheel->cancel(handle));
+  REQUIRE_FALSE(wheel->cancel(handle));
+  REQUIRE(cancelled.use_count() == 1);
+
+  // the slot of the cancelled entry is reused, but the stale handle must not cancel the new one
+  auto reused = std::make_shared<recording_listener>(expiry);
+  wheel->schedule(expiry, reused);
+  REQUIRE_FALSE(wheel->cancel(handle));
+
+  ctx.run();
+
+  REQUIRE(cancelled->number_of_calls() == 0);
+  REQUIRE(kept->number_of_calls() == 1);
+  REQUIRE(reused->number_of_calls() == 1);
+}
+
+TEST_CASE("unit: deadline_wheel fires deadlines that have already expired", "[unit]")
+{
+  asio::io_context ctx;
+  auto wheel = std::make_shared<deadline_wheel>(ctx);
+
+  auto listener = std::make_shared<recording_listener>(deadline_wheel::clock::now() -
+                                                       std::chrono::seconds{ 1 });
+  wheel->schedule(listener->expiry(), listener);
+
+  ctx.run();
+
+  REQUIRE(listener->number_of_calls() == 1);
+}
+
+TEST_CASE("unit: deadline_wheel drops pending deadlines when stopped", "[unit]")
+{
+  asio::io_context ctx;
+  auto wheel = std::make_shared<deadline_wheel>(ctx, std::chrono::milliseconds{ 2 }, 8);
+
+  const auto expiry = deadline_wheel::clock::now() + std::chrono::milliseconds{ 10 };
+  auto pending = std::make_shared<recording_listener>(expiry);
+  auto handle = wheel->schedule(expiry, pending);
+  REQUIRE(wheel->size() == 1);
+
+  wheel->stop();
+  REQUIRE(wheel->size() == 0);
+  REQUIRE(pending.use_count() == 1);
+  REQUIRE_FALSE(wheel->cancel(handle));
+
+  auto late = std::make_shared<recording_listener>(expiry);
+  wheel->schedule(expiry, late);
+  REQUIRE(late.use_count() == 1);
+
+  ctx.run();
+
+  REQUIRE(pending->number_of_calls() == 0);
+  REQUIRE(late->number_of_calls() == 0);
+  // the timer does not keep the wheel alive anymore
+  REQUIRE(wheel.use_count() == 1);
+}
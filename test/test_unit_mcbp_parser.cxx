@@ -18,9 +18,16 @@
 #include "test_helper.hxx"
 
 #include "core/io/mcbp_parser.hxx"
+#include "core/protocol/client_request.hxx"
+#include "core/protocol/datatype.hxx"
 #include "core/protocol/magic.hxx"
+#include "core/utils/byteswap.hxx"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
 
 #include <array>
+#include <cstddef>
+#include <string>
 #include <vector>
 
 namespace
@@ -55,6 +62,10 @@ struct frame_builder {
   {
     return set(4, v);
   }
+  auto datatype(std::uint8_t v) -> frame_builder& // byte 5
+  {
+    return set(5, v);
+  }
   auto bodylen(std::uint32_t v) -> frame_builder& // bytes 8-11
   {
     return set(8, static_cast<std::uint8_t>(v >> 24U))
@@ -62,7 +73,63 @@ struct frame_builder {
       .set(10, static_cast<std::uint8_t>(v >> 8U))
       .set(11, static_cast<std::uint8_t>(v));
   }
+  auto opaque(std::uint32_t v) -> frame_builder& // bytes 12-15
+  {
+    return set(12, static_cast<std::uint8_t>(v >> 24U))
+      .set(13, static_cast<std::uint8_t>(v >> 16U))
+      .set(14, static_cast<std::uint8_t>(v >> 8U))
+      .set(15, static_cast<std::uint8_t>(v));
+  }
 };
+
+// Concatenates the given number of response frames with value of the given size, as the server
+// would send them for pipelined requests.
+auto
+pipelined_frames(std::uint32_t number_of_frames, std::uint32_t value_size) -> std::vector<std::byte>
+{
+  std::vector<std::byte> wire;
+  wire.reserve(number_of_frames * (24 + value_size));
+  for (std::uint32_t i = 0; i < number_of_frames; ++i) {
+    auto header = frame_builder{}
+                    .magic_byte(magic::client_response)
+                    .opcode(0x00)
+                    .bodylen(value_size)
+                    .opaque(i)
+                    .bytes;
+    wire.insert(wire.end(), header.begin(), header.end());
+    wire.insert(wire.end(), value_size, std::byte{ static_cast<std::uint8_t>(i) });
+  }
+  return wire;
+}
+// Builds the response frame with 4 bytes of extras and the given value compressed with snappy, as
+// the server sends documents when snappy has been negotiated.
+auto
+compressed_frame(const std::vector<std::byte>& value) -> std::vector<std::byte>
+{
+  std::vector<std::byte> body(4, std::byte{ 0xff });
+  REQUIRE(couchbase::core::protocol::compress_value(value, body, 1.0));
+  auto header = frame_builder{}
+                  .magic_byte(magic::client_response)
+                  .opcode(0x00)
+                  .extlen(0x04)
+                  .datatype(static_cast<std::uint8_t>(couchbase::core::protocol::datatype::snappy))
+                  .bodylen(static_cast<std::uint32_t>(body.size()))
+                  .bytes;
+  std::vector<std::byte> wire(header.begin(), header.end());
+  wire.insert(wire.end(), body.begin(), body.end());
+  return wire;
+}
+
+auto
+compressible_value(std::size_t size) -> std::vector<std::byte>
+{
+  const std::string pattern{ R"({"name":"Couchbase","type":"document","tags":["a","b"]})" };
+  std::vector<std::byte> value(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    value[i] = static_cast<std::byte>(pattern[i % pattern.size()]);
+  }
+  return value;
+}
 } // namespace
 
 TEST_CASE("unit: mcbp_parser rejects frame whose prefix exceeds the body", "[unit]")
@@ -136,3 +203,110 @@ TEST_CASE("unit: mcbp_parser accepts a well-formed frame (positive control)", "[
   CHECK(parser.next(msg) == mcbp_parser::result::ok);
   CHECK(msg.body.size() == 7);
 }
+
+TEST_CASE("unit: mcbp_parser extracts pipelined frames in order", "[unit]")
+{
+  constexpr std::uint32_t number_of_frames = 100;
+  constexpr std::uint32_t value_size = 13;
+  auto wire = pipelined_frames(number_of_frames, value_size);
+
+  mcbp_parser parser;
+  // split the stream at an arbitrary point, so that one of the frames spans two reads
+  const auto split = wire.begin() + static_cast<std::ptrdiff_t>(wire.size() / 3);
+  parser.feed(wire.begin(), split);
+
+  std::uint32_t parsed = 0;
+  mcbp_message msg;
+  while (parser.next(msg) == mcbp_parser::result::ok) {
+    CHECK(msg.header.opaque == couchbase::core::utils::byte_swap(parsed));
+    ++parsed;
+  }
+  CHECK(parsed < number_of_frames);
+
+  parser.feed(split, wire.end());
+  while (parser.next(msg) == mcbp_parser::result::ok) {
+    CHECK(msg.header.opaque == couchbase::core::utils::byte_swap(parsed));
+    CHECK(msg.body.size() == value_size);
+    CHECK(msg.body.front() == std::byte{ static_cast<std::uint8_t>(parsed) });
+    ++parsed;
+  }
+  CHECK(parsed == number_of_frames);
+  CHECK(parser.available() == 0);
+}
+
+TEST_CASE("unit: mcbp_parser decompresses snappy value after the extras", "[unit]")
+{
+  const auto value = compressible_value(10'000);
+  auto wire = compressed_frame(value);
+  REQUIRE(wire.size() < value.size());
+
+  mcbp_parser parser;
+  parser.feed(wire.begin(), wire.end());
+
+  mcbp_message msg;
+  REQUIRE(parser.next(msg) == mcbp_parser::result::ok);
+  REQUIRE(couchbase::core::utils::byte_swap(msg.header.bodylen) == 4 + value.size());
+  REQUIRE(msg.body.size() == 4 + value.size());
+  CHECK(std::vector<std::byte>(msg.body.begin(), msg.body.begin() + 4) ==
+        std::vector<std::byte>(4, std::byte{ 0xff }));
+  CHECK(std::vector<std::byte>(msg.body.begin() + 4, msg.body.end()) == value);
+  CHECK(parser.available() == 0);
+}
+
+TEST_CASE("unit: mcbp_parser keeps the value that is not valid snappy", "[unit]")
+{
+  auto header = frame_builder{}
+                  .magic_byte(magic::client_response)
+                  .opcode(0x00)
+                  .datatype(static_cast<std::uint8_t>(couchbase::core::protocol::datatype::snappy))
+                  .bodylen(3)
+                  .bytes;
+  std::vector<std::byte> wire(header.begin(), header.end());
+  // the length prefix claims 16 bytes, but there is no data to decompress
+  wire.insert(wire.end(), { std::byte{ 0x10 }, std::byte{ 0xff }, std::byte{ 0xff } });
+
+  mcbp_parser parser;
+  parser.feed(wire.begin(), wire.end());
+
+  mcbp_message msg;
+  REQUIRE(parser.next(msg) == mcbp_parser::result::ok);
+  CHECK(msg.body == std::vector<std::byte>(wire.begin() + 24, wire.end()));
+}
+
+TEST_CASE("benchmark: mcbp_parser with snappy compressed values", "[.][benchmark]")
+{
+  for (const std::size_t value_size : { 1024U, 64U * 1024U, 1024U * 1024U }) {
+    auto wire = compressed_frame(compressible_value(value_size));
+
+    BENCHMARK("decompress " + std::to_string(value_size) + " byte value")
+    {
+      mcbp_parser parser;
+      parser.feed(wire.begin(), wire.end());
+      mcbp_message msg;
+      parser.next(msg);
+      return msg.body.size();
+    };
+  }
+}
+
+TEST_CASE("benchmark: mcbp_parser with pipelined frames", "[.][benchmark]")
+{
+  // 16 KiB is the size of the single socket read in mcbp_session
+  for (const std::uint32_t value_size : { 8U, 64U, 512U }) {
+    const std::uint32_t number_of_frames = 16384 / (24 + value_size);
+    auto wire = pipelined_frames(number_of_frames, value_size);
+
+    BENCHMARK("parse " + std::to_string(number_of_frames) + " frames with " +
+              std::to_string(value_size) + " byte values")
+    {
+      mcbp_parser parser;
+      parser.feed(wire.begin(), wire.end());
+      mcbp_message msg;
+      std::uint32_t parsed = 0;
+      while (parser.next(msg) == mcbp_parser::result::ok) {
+        ++parsed;
+      }
+      return parsed;
+    };
+  }
+}
@@ -27,6 +27,15 @@
 #include <spdlog/fmt/bundled/printf.h>
 
 #include <asio/io_context.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <tao/json/value.hpp>
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
 
 TEST_CASE("unit: metric attributes encoding", "[unit]")
 {
@@ -205,3 +214,228 @@ TEST_CASE("unit: logging_meter get_value_recorder", "[unit]")
     REQUIRE(kv_recorder != query_recorder);
   }
 }
+
+TEST_CASE("unit: logging_meter merges values recorded from multiple threads", "[unit]")
+{
+  asio::io_context ctx{};
+  couchbase::core::metrics::logging_meter_options options{};
+  options.percentiles = { 50.0, 99.5 };
+  options.number_of_shards = 3;
+  auto meter = std::make_shared<couchbase::core::metrics::logging_meter>(ctx, options);
+
+  const std::map<std::string, std::string> kv_get_tags{
+    { couchbase::core::tracing::attributes::op::service,
+      couchbase::core::tracing::service::key_value },
+    { couchbase::core::tracing::attributes::op::operation_name, "get" },
+  };
+  auto recorder =
+    meter->get_value_recorder(couchbase::core::metrics::operation_meter_name, kv_get_tags);
+
+  constexpr std::int64_t number_of_threads{ 8 };
+  constexpr std::int64_t values_per_thread{ 1'000 };
+  std::vector<std::thread> threads;
+  threads.reserve(number_of_threads);
+  for (std::int64_t t = 0; t < number_of_threads; ++t) {
+    threads.emplace_back([recorder]() {
+      for (std::int64_t i = 1; i <= values_per_thread; ++i) {
+        recorder->record_value(i);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  auto report = meter->report();
+  const auto& get_report = report.at("operations").at("kv").at("get");
+  REQUIRE(get_report.at("total_count").as<std::int64_t>() == number_of_threads * values_per_thread);
+  const auto& percentiles = get_report.at("percentiles_us").get_object();
+  REQUIRE(percentiles.size() == 2);
+  REQUIRE(percentiles.count("50.0") == 1);
+  REQUIRE(percentiles.count("99.5") == 1);
+  REQUIRE(percentiles.at("50.0").as<std::int64_t>() == 500);
+  REQUIRE(percentiles.at("99.5").as<std::int64_t>() == 995);
+
+  // every report resets the histograms
+  report = meter->report();
+  REQUIRE(report.at("operations").at("kv").at("get").at("total_count").as<std::int64_t>() == 0);
+
+  recorder->record_value(42);
+  report = meter->report();
+  REQUIRE(report.at("operations").at("kv").at("get").at("total_count").as<std::int64_t>() == 1);
+}
+
+TEST_CASE("unit: logging_meter includes report sections", "[unit]")
+{
+  asio::io_context ctx{};
+  auto meter = std::make_shared<couchbase::core::metrics::logging_meter>(
+    ctx, couchbase::core::metrics::logging_meter_options{});
+  auto wrapper = couchbase::core::metrics::meter_wrapper::create(
+    meter, std::make_shared<couchbase::core::cluster_label_listener>());
+
+  std::uint64_t hits{ 0 };
+  wrapper->add_report_section("query_cache", [&hits]() {
+    return tao::json::value{ { "hits", ++hits } };
+  });
+  wrapper->add_report_section("empty", []() {
+    return tao::json::value{ tao::json::null };
+  });
+
+  auto report = meter->report();
+  REQUIRE(report.at("query_cache").at("hits").as<std::uint64_t>() == 1);
+  REQUIRE(report.find("empty") == nullptr);
+  report = meter->report();
+  REQUIRE(report.at("query_cache").at("hits").as<std::uint64_t>() == 2);
+
+  wrapper->remove_report_section("query_cache");
+  report = meter->report();
+  REQUIRE(report.find("query_cache") == nullptr);
+  REQUIRE(hits == 2);
+}
+
+TEST_CASE("benchmark: logging_meter recording under contention", "[.][benchmark]")
+{
+  const std::map<std::string, std::string> kv_get_tags{
+    { couchbase::core::tracing::attributes::op::service,
+      couchbase::core::tracing::service::key_value },
+    { couchbase::core::tracing::attributes::op::operation_name, "get" },
+  };
+  constexpr std::int64_t values_per_thread{ 100'000 };
+
+  for (const std::size_t number_of_shards : { 1U, 4U, 16U }) {
+    asio::io_context ctx{};
+    couchbase::core::metrics::logging_meter_options options{};
+    options.number_of_shards = number_of_shards;
+    auto meter = std::make_shared<couchbase::core::metrics::logging_meter>(ctx, options);
+    auto recorder =
+      meter->get_value_recorder(couchbase::core::metrics::operation_meter_name, kv_get_tags);
+
+    for (const std::size_t number_of_threads : { 1U, 4U, 16U, 64U }) {
+      BENCHMARK(std::to_string(number_of_threads) + " threads, " +
+                std::to_string(number_of_shards) + " shards")
+      {
+        std::vector<std::thread> threads;
+        threads.reserve(number_of_threads);
+        for (std::size_t t = 0; t < number_of_threads; ++t) {
+          threads.emplace_back([recorder]() {
+            for (std::int64_t i = 1; i <= values_per_thread; ++i) {
+              recorder->record_value(i);
+            }
+          });
+        }
+        for (auto& thread : threads) {
+          thread.join();
+        }
+        return meter->report();
+      };
+    }
+  }
+}
+
+namespace
+{
+class counting_value_recorder : public couchbase::metrics::value_recorder
+{
+public:
+  explicit counting_value_recorder(std::map<std::string, std::string> tags)
+    : tags_{ std::move(tags) }
+  {
+  }
+
+  void record_value(std::int64_t /* value */) override
+  {
+    ++number_of_values_;
+  }
+
+  [[nodiscard]] auto tags() const -> const std::map<std::string, std::string>&
+  {
+    return tags_;
+  }
+
+  [[nodiscard]] auto number_of_values() const -> std::size_t
+  {
+    return number_of_values_;
+  }
+
+private:
+  std::map<std::string, std::string> tags_;
+  std::size_t number_of_values_{ 0 };
+};
+
+class counting_meter : public couchbase::metrics::meter
+{
+public:
+  auto get_value_recorder(const std::string& /* name */,
+                          const std::map<std::string, std::string>& tags)
+    -> std::shared_ptr<couchbase::metrics::value_recorder> override
+  {
+    auto recorder = std::make_shared<counting_value_recorder>(tags);
+    recorders_.push_back(recorder);
+    return recorder;
+  }
+
+  [[nodiscard]] auto recorders() const
+    -> const std::vector<std::shared_ptr<counting_value_recorder>>&
+  {
+    return recorders_;
+  }
+
+private:
+  std::vector<std::shared_ptr<counting_value_recorder>> recorders_{};
+};
+} // namespace
+
+TEST_CASE("unit: meter_wrapper interns value recorders", "[unit]")
+{
+  auto meter = std::make_shared<counting_meter>();
+  auto label_listener = std::make_shared<couchbase::core::cluster_label_listener>();
+  auto wrapper = couchbase::core::metrics::meter_wrapper::create(meter, label_listener);
+
+  couchbase::core::metrics::metric_attributes attrs{
+    couchbase::core::tracing::service::key_value,
+    "get",
+    {},
+    "test-bucket",
+    "test-scope",
+    "test-collection",
+  };
+
+  for (int i = 0; i < 10; ++i) {
+    wrapper->record_value(attrs, std::chrono::steady_clock::now());
+  }
+  REQUIRE(meter->recorders().size() == 1);
+  REQUIRE(meter->recorders()[0]->number_of_values() == 10);
+  REQUIRE(wrapper->value_recorder(attrs) == meter->recorders()[0]);
+
+  SECTION("different error code resolves separate recorder")
+  {
+    attrs.ec = couchbase::errc::key_value::document_not_found;
+    wrapper->record_value(attrs, std::chrono::steady_clock::now());
+    wrapper->record_value(attrs, std::chrono::steady_clock::now());
+    REQUIRE(meter->recorders().size() == 2);
+    REQUIRE(meter->recorders()[1]->tags().at("error.type") == "DocumentNotFound");
+    REQUIRE(meter->recorders()[1]->number_of_values() == 2);
+  }
+
+  SECTION("different collection resolves separate recorder")
+  {
+    attrs.collection_name = "other-collection";
+    wrapper->record_value(attrs, std::chrono::steady_clock::now());
+    REQUIRE(meter->recorders().size() == 2);
+    REQUIRE(meter->recorders()[1]->tags().at("couchbase.collection.name") == "other-collection");
+  }
+
+  SECTION("change of cluster labels resolves recorders again")
+  {
+    couchbase::core::topology::configuration config{};
+    config.cluster_name = "test-cluster";
+    label_listener->update_config(config);
+
+    wrapper->record_value(attrs, std::chrono::steady_clock::now());
+    REQUIRE(meter->recorders().size() == 2);
+    REQUIRE(meter->recorders()[1]->tags().at("couchbase.cluster.name") == "test-cluster");
+
+    wrapper->record_value(attrs, std::chrono::steady_clock::now());
+    REQUIRE(meter->recorders().size() == 2);
+  }
+}
@@ -0,0 +1,174 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2025-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test_helper.hxx"
+
+#include "utils/mock_mcbp_server.hxx"
+
+#include <couchbase/cluster.hxx>
+#include <couchbase/codec/tao_json_serializer.hxx>
+
+#include <spdlog/fmt/bundled/core.h>
+#include <tao/json/value.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace
+{
+auto
+make_value(std::string_view json) -> std::vector<std::byte>
+{
+  const auto* data = reinterpret_cast<const std::byte*>(json.data());
+  return { data, data + json.size() };
+}
+} // namespace
+
+TEST_CASE("unit: mock server stores and returns documents", "[unit]")
+{
+  test::utils::mock_mcbp_server server{};
+  server.upsert("preloaded", make_value(R"({"answer":42})"));
+
+  auto cluster = test::utils::connect(server);
+  auto collection = cluster.bucket(server.options().bucket_name).default_collection();
+
+  {
+    auto [err, result] = collection.get("preloaded").get();
+    REQUIRE_SUCCESS(err.ec());
+    REQUIRE(result.content_as<tao::json::value>() == tao::json::value{ { "answer", 42 } });
+  }
+
+  {
+    auto [err, result] = collection.upsert("foo", tao::json::value{ { "name", "mock" } }).get();
+    REQUIRE_SUCCESS(err.ec());
+    REQUIRE(result.cas().value() != 0);
+  }
+
+  {
+    auto [err, result] = collection.get("foo").get();
+    REQUIRE_SUCCESS(err.ec());
+    REQUIRE(result.content_as<tao::json::value>() == tao::json::value{ { "name", "mock" } });
+  }
+
+  {
+    auto [err, result] = collection.get("missing").get();
+    REQUIRE(err.ec() == couchbase::errc::key_value::document_not_found);
+  }
+
+  cluster.close().get();
+}
+
+TEST_CASE("unit: mock server injects not my vbucket", "[unit]")
+{
+  test::utils::mock_mcbp_server_options options{};
+  options.not_my_vbucket_every = 3;
+  test::utils::mock_mcbp_server server{ options };
+
+  auto cluster = test::utils::connect(server);
+  auto collection = cluster.bucket(server.options().bucket_name).default_collection();
+
+  for (int i = 0; i < 10; ++i) {
+    auto key = fmt::format("nmvb-{}", i);
+    {
+      auto [err, result] = collection.upsert(key, tao::json::value{ { "i", i } }).get();
+      REQUIRE_SUCCESS(err.ec());
+    }
+    {
+      auto [err, result] = collection.get(key).get();
+      REQUIRE_SUCCESS(err.ec());
+      REQUIRE(result.content_as<tao::json::value>() == tao::json::value{ { "i", i } });
+    }
+  }
+  REQUIRE(server.stats().injected_not_my_vbucket > 0);
+
+  cluster.close().get();
+}
+
+TEST_CASE("unit: mock server compresses responses", "[unit]")
+{
+  test::utils::mock_mcbp_server_options options{};
+  options.compress_responses = true;
+  test::utils::mock_mcbp_server server{ options };
+
+  const std::string text(4096, 'x');
+  server.upsert("compressible", make_value(fmt::format(R"({{"text":"{}"}})", text)));
+
+  auto cluster = test::utils::connect(server);
+  auto collection = cluster.bucket(server.options().bucket_name).default_collection();
+
+  auto [err, result] = collection.get("compressible").get();
+  REQUIRE_SUCCESS(err.ec());
+  REQUIRE(result.content_as<tao::json::value>() == tao::json::value{ { "text", text } });
+  REQUIRE(server.stats().compressed_responses == 1);
+
+  cluster.close().get();
+}
+
+TEST_CASE("unit: mock server delays responses", "[unit]")
+{
+  test::utils::mock_mcbp_server_options options{};
+  options.latency = std::chrono::milliseconds{ 20 };
+  test::utils::mock_mcbp_server server{ options };
+  server.upsert("slow", make_value(R"({})"));
+
+  auto cluster = test::utils::connect(server);
+  auto collection = cluster.bucket(server.options().bucket_name).default_collection();
+
+  const auto start = std::chrono::steady_clock::now();
+  auto [err, result] = collection.get("slow").get();
+  REQUIRE_SUCCESS(err.ec());
+  REQUIRE(std::chrono::steady_clock::now() - start >= options.latency);
+
+  cluster.close().get();
+}
+
+TEST_CASE("unit: mock server scans the collection", "[unit]")
+{
+  test::utils::mock_mcbp_server_options options{};
+  options.range_scan_batch_item_limit = 3;
+  test::utils::mock_mcbp_server server{ options };
+
+  std::set<std::string> expected{};
+  for (int i = 0; i < 50; ++i) {
+    auto key = fmt::format("scan-{:03}", i);
+    server.upsert(key, make_value(R"({})"));
+    expected.insert(key);
+  }
+  server.upsert("other", make_value(R"({})"));
+
+  auto cluster = test::utils::connect(server);
+  auto collection = cluster.bucket(server.options().bucket_name).default_collection();
+
+  auto [err, scan] = collection.scan(couchbase::prefix_scan{ "scan-" }, {}).get();
+  REQUIRE_SUCCESS(err.ec());
+
+  std::set<std::string> ids{};
+  while (true) {
+    auto [item_err, item] = scan.next().get();
+    REQUIRE_SUCCESS(item_err.ec());
+    if (!item) {
+      break;
+    }
+    REQUIRE(ids.insert(item->id()).second);
+  }
+  REQUIRE(ids == expected);
+
+  cluster.close().get();
+}
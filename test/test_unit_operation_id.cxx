@@ -0,0 +1,148 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2025-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test_helper.hxx"
+
+#include "core/io/operation_id.hxx"
+#include "core/io/operation_id_fmt.hxx"
+#include "core/platform/uuid.h"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <set>
+#include <string>
+
+namespace
+{
+std::atomic<std::size_t> number_of_allocations{ 0 };
+
+template<typename Function>
+auto
+count_allocations(Function&& function) -> std::size_t
+{
+  const auto before = number_of_allocations.load();
+  function();
+  return number_of_allocations.load() - before;
+}
+} // namespace
+
+// count allocations in this test binary
+auto
+operator new(std::size_t size) -> void*
+{
+  ++number_of_allocations;
+  if (void* ptr = std::malloc(size == 0 ? 1 : size); ptr != nullptr) {
+    return ptr;
+  }
+  throw std::bad_alloc{};
+}
+
+void
+operator delete(void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void
+operator delete(void* ptr, std::size_t /* size */) noexcept
+{
+  std::free(ptr);
+}
+
+TEST_CASE("unit: operation_id renders opcode, prefix and sequence", "[unit]")
+{
+  using couchbase::core::io::operation_id;
+
+  const operation_id first{ 0x01 };
+  const operation_id second{ 0x1d };
+  REQUIRE(second.sequence() > first.sequence());
+
+  REQUIRE(operation_id::prefix().size() == 8);
+  REQUIRE(first.to_string() ==
+          "01/" + operation_id::prefix() + "-" + fmt::format("{:x}", first.sequence()));
+  REQUIRE(fmt::format("{}", second) ==
+          "1d/" + operation_id::prefix() + "-" + fmt::format("{:x}", second.sequence()));
+}
+
+TEST_CASE("unit: operation_id is unique and does not allocate until rendered", "[unit]")
+{
+  using couchbase::core::io::operation_id;
+
+  // make sure the prefix is initialized
+  REQUIRE_FALSE(operation_id::prefix().empty());
+
+  std::set<std::uint64_t> sequences{};
+  const std::size_t allocations = count_allocations([]() {
+    for (int i = 0; i < 1000; ++i) {
+      const operation_id id{ 0x00 };
+      (void)id;
+    }
+  });
+  REQUIRE(allocations == 0);
+
+  for (int i = 0; i < 1000; ++i) {
+    sequences.insert(operation_id{ 0x00 }.sequence());
+  }
+  REQUIRE(sequences.size() == 1000);
+}
+
+TEST_CASE("benchmark: operation_id construction", "[.][benchmark]")
+{
+  using couchbase::core::io::operation_id;
+
+  auto legacy = []() {
+    return fmt::format("{:02x}/{}",
+                       static_cast<std::uint8_t>(0x00),
+                       couchbase::core::uuid::to_string(couchbase::core::uuid::random()));
+  };
+  (void)operation_id::prefix();
+
+  constexpr std::size_t number_of_operations{ 10'000 };
+  const auto legacy_allocations = count_allocations([&legacy]() {
+    for (std::size_t i = 0; i < number_of_operations; ++i) {
+      auto id = legacy();
+      (void)id;
+    }
+  });
+  const auto lazy_allocations = count_allocations([]() {
+    for (std::size_t i = 0; i < number_of_operations; ++i) {
+      const operation_id id{ 0x00 };
+      (void)id;
+    }
+  });
+  WARN(fmt::format("allocations per operation: uuid string={:.2f}, operation_id={:.2f}",
+                   static_cast<double>(legacy_allocations) / number_of_operations,
+                   static_cast<double>(lazy_allocations) / number_of_operations));
+
+  BENCHMARK("uuid string")
+  {
+    return legacy();
+  };
+
+  BENCHMARK("operation_id")
+  {
+    return operation_id{ 0x00 };
+  };
+
+  BENCHMARK("operation_id rendered")
+  {
+    return operation_id{ 0x00 }.to_string();
+  };
+}
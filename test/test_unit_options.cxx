@@ -19,6 +19,7 @@
 #include "profile.hxx"
 #include "test_helper.hxx"
 
+#include <couchbase/cluster_options.hxx>
 #include <couchbase/codec/tao_json_serializer.hxx>
 #include <couchbase/query_options.hxx>
 
@@ -59,3 +60,16 @@ TEST_CASE("unit: query options can encode named parameters automatically", "[uni
           couchbase::core::utils::to_binary(
             "{\"birth_year\":1970,\"full_name\":\"John Doe\",\"username\":\"john\"}"));
 }
+
+TEST_CASE("unit: network options clamp number of IO threads to at least one", "[unit]")
+{
+  couchbase::cluster_options options("Administrator", "password");
+  REQUIRE(options.build().network.num_io_threads ==
+          couchbase::network_options::default_num_io_threads);
+
+  options.network().num_io_threads(4);
+  REQUIRE(options.build().network.num_io_threads == 4);
+
+  options.network().num_io_threads(0);
+  REQUIRE(options.build().network.num_io_threads == 1);
+}
@@ -20,11 +20,18 @@
 #include "utils/move_only_context.hxx"
 
 #include "core/operations/document_query.hxx"
+#include "core/utils/json_streaming_lexer.hxx"
 
 #include <couchbase/codec/tao_json_serializer.hxx>
 
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <spdlog/fmt/bundled/core.h>
 #include <tao/json/value.hpp>
 
+#include <string>
+#include <string_view>
+#include <utility>
+
 couchbase::core::http_context
 make_http_context(couchbase::core::topology::configuration& config)
 {
@@ -148,3 +155,219 @@ TEST_CASE("unit: Public API query options - add/clear parameters", "[unit]")
             });
   }
 }
+
+TEST_CASE("unit: query cache evicts least recently used statements", "[unit]")
+{
+  // capacity is spread over 16 shards, so each shard keeps one statement
+  couchbase::core::query_cache cache{ 16 };
+
+  for (int i = 0; i < 1000; ++i) {
+    cache.put("SELECT " + std::to_string(i), "name-" + std::to_string(i));
+  }
+  auto stats = cache.stats();
+  REQUIRE(stats.size <= 16);
+  REQUIRE(stats.evictions == 1000 - stats.size);
+
+  auto entry = cache.get("SELECT 999");
+  REQUIRE(entry.has_value());
+  REQUIRE(entry->name == "name-999");
+  REQUIRE_FALSE(entry->plan.has_value());
+  REQUIRE_FALSE(cache.get("SELECT 0").has_value());
+
+  stats = cache.stats();
+  REQUIRE(stats.hits == 1);
+  REQUIRE(stats.misses == 1);
+}
+
+TEST_CASE("unit: query cache keeps the first prepared entry", "[unit]")
+{
+  couchbase::core::query_cache cache{};
+
+  cache.put("SELECT 1", "first", "plan");
+  cache.put("SELECT 1", "second");
+  auto entry = cache.get("SELECT 1");
+  REQUIRE(entry.has_value());
+  REQUIRE(entry->name == "first");
+  REQUIRE(entry->plan == "plan");
+
+  cache.erase("SELECT 1");
+  REQUIRE_FALSE(cache.get("SELECT 1").has_value());
+  REQUIRE(cache.stats().size == 0);
+}
+
+TEST_CASE("unit: query cache shrinks when capacity is lowered", "[unit]")
+{
+  couchbase::core::query_cache cache{};
+  REQUIRE(cache.capacity() == couchbase::core::query_cache::default_capacity);
+
+  for (int i = 0; i < 200; ++i) {
+    cache.put("SELECT " + std::to_string(i), "name-" + std::to_string(i));
+  }
+  REQUIRE(cache.stats().size == 200);
+
+  cache.set_capacity(16);
+  auto stats = cache.stats();
+  REQUIRE(stats.size <= 16);
+  REQUIRE(stats.evictions == 200 - stats.size);
+
+  cache.set_capacity(0);
+  REQUIRE_FALSE(cache.enabled());
+  stats = cache.stats();
+  REQUIRE(stats.size == 0);
+  REQUIRE(stats.evictions == 200);
+}
+
+TEST_CASE("unit: query runs statement ad hoc when the cache is disabled", "[unit]")
+{
+  couchbase::core::topology::configuration config{};
+  config.capabilities.cluster.insert(
+    couchbase::core::cluster_capability::n1ql_enhanced_prepared_statements);
+  couchbase::core::query_cache cache{ 0 };
+  couchbase::core::cluster_options cluster_options{};
+  couchbase::core::http_context ctx{ config, cluster_options, cache, {}, 0, {}, 0 };
+
+  cache.put("SELECT 1", "name");
+  REQUIRE_FALSE(cache.get("SELECT 1").has_value());
+  REQUIRE(cache.stats().size == 0);
+  REQUIRE(cache.stats().evictions == 0);
+
+  couchbase::core::io::http_request http_req;
+  couchbase::core::operations::query_request req{};
+  req.statement = "SELECT 1";
+  req.adhoc = false;
+  REQUIRE_SUCCESS(req.encode_to(http_req, ctx));
+  auto body = couchbase::core::utils::json::parse(http_req.body);
+  REQUIRE(body.get_object().at("statement").get_string() == "SELECT 1");
+  REQUIRE(body.get_object().count("prepared") == 0);
+  REQUIRE(body.get_object().count("auto_execute") == 0);
+}
+
+TEST_CASE("unit: query drops cached plan when the server reports it stale", "[unit]")
+{
+  couchbase::core::topology::configuration config{};
+  auto ctx = make_http_context(config);
+  ctx.cache.put("SELECT 'stale'", "stale-name", "stale-plan");
+
+  couchbase::core::io::http_request http_req;
+  couchbase::core::operations::query_request req{};
+  req.statement = "SELECT 'stale'";
+  req.adhoc = false;
+  REQUIRE_SUCCESS(req.encode_to(http_req, ctx));
+  auto body = couchbase::core::utils::json::parse(http_req.body);
+  REQUIRE(body.get_object().at("prepared").get_string() == "stale-name");
+
+  couchbase::core::io::http_response http_resp;
+  http_resp.status_code = 200;
+  http_resp.body.append(
+    R"({"requestID":"r","status":"fatal","errors":[{"code":4080,"msg":"name_encoded_plan_mismatch"}]})");
+  auto resp = req.make_response({}, http_resp);
+  REQUIRE(resp.ctx.ec == couchbase::errc::query::prepared_statement_failure);
+  REQUIRE_FALSE(ctx.cache.get("SELECT 'stale'").has_value());
+}
+
+namespace
+{
+auto
+make_query_response_body(std::size_t number_of_rows, std::string_view trailer) -> std::string
+{
+  std::string body{
+    R"({"requestID":"3b9d9fa5-9d6f-4f16-a1a4-5c2c2c3bfc4e","signature":{"*":"*"},"results":[)"
+  };
+  for (std::size_t i = 0; i < number_of_rows; ++i) {
+    if (i > 0) {
+      body += ',';
+    }
+    body += fmt::format(
+      R"({{"id":"airline_{}","type":"airline","name":"Airline {}","country":"United States"}})",
+      i,
+      i);
+  }
+  body += "],";
+  body += trailer;
+  body += '}';
+  return body;
+}
+
+constexpr std::string_view success_trailer{
+  R"("status":"success","metrics":{"elapsedTime":"1.5s","executionTime":"1.4s","resultCount":100000,"resultSize":9000000})"
+};
+
+auto
+stream_query_response(const std::string& body, std::size_t chunk_size)
+  -> std::pair<std::size_t, std::string>
+{
+  std::size_t number_of_rows{ 0 };
+  std::string meta{};
+  couchbase::core::utils::json::streaming_lexer lexer("/results/^", 4);
+  lexer.on_row([&number_of_rows](std::string&& /* row */) {
+    ++number_of_rows;
+    return couchbase::core::utils::json::stream_control::next_row;
+  });
+  lexer.on_complete([&meta](std::error_code /* ec */, std::size_t /* number_of_rows */,
+                            std::string&& metadata) {
+    meta = std::move(metadata);
+  });
+  for (std::size_t offset = 0; offset < body.size(); offset += chunk_size) {
+    lexer.feed(std::string_view{ body }.substr(offset, chunk_size));
+  }
+  return { number_of_rows, meta };
+}
+} // namespace
+
+TEST_CASE("unit: query response decoded from the metadata of the streamed rows", "[unit]")
+{
+  SECTION("success")
+  {
+    auto [number_of_rows, meta] =
+      stream_query_response(make_query_response_body(1'000, success_trailer), 1'024);
+    REQUIRE(number_of_rows == 1'000);
+
+    couchbase::core::operations::query_request req{};
+    couchbase::core::io::http_response http_resp;
+    http_resp.status_code = 200;
+    http_resp.body.append(meta);
+    auto resp = req.make_response({}, http_resp);
+    REQUIRE_SUCCESS(resp.ctx.ec);
+    REQUIRE(resp.rows.empty());
+    REQUIRE(resp.meta.status == "success");
+    REQUIRE(resp.meta.request_id == "3b9d9fa5-9d6f-4f16-a1a4-5c2c2c3bfc4e");
+    REQUIRE(resp.meta.metrics.has_value());
+    REQUIRE(resp.meta.metrics->result_count == 100'000);
+  }
+
+  SECTION("error reported after the rows")
+  {
+    auto [number_of_rows, meta] = stream_query_response(
+      make_query_response_body(
+        10, R"("errors":[{"code":1080,"msg":"Timeout 1s exceeded"}],"status":"timeout")"),
+      64);
+    REQUIRE(number_of_rows == 10);
+
+    couchbase::core::operations::query_request req{};
+    couchbase::core::io::http_response http_resp;
+    http_resp.status_code = 200;
+    http_resp.body.append(meta);
+    auto resp = req.make_response({}, http_resp);
+    REQUIRE(resp.ctx.ec == couchbase::errc::common::unambiguous_timeout);
+    REQUIRE(resp.rows.empty());
+  }
+}
+
+TEST_CASE("benchmark: large query result", "[.][benchmark]")
+{
+  const auto body = make_query_response_body(100'000, success_trailer);
+
+  BENCHMARK("buffered: parse body and re-encode rows")
+  {
+    couchbase::core::operations::query_request req{};
+    couchbase::core::io::http_response http_resp;
+    http_resp.status_code = 200;
+    http_resp.body.append(body);
+    return req.make_response({}, http_resp).rows.size();
+  };
+
+  BENCHMARK("streamed: lex rows from 16KiB chunks")
+  {
+    return stream_query_response(body, 16 * 1'024).first;
+  };
+}
@@ -0,0 +1,128 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2025-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test_helper.hxx"
+
+#include "utils/mock_mcbp_server.hxx"
+
+#include "core/crypto/cbcrypto.h"
+#include "core/sasl/scram-sha/salted_password_cache.h"
+
+#include <couchbase/cluster.hxx>
+#include <couchbase/codec/tao_json_serializer.hxx>
+
+#include <tao/json/value.hpp>
+
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+using couchbase::core::crypto::Algorithm;
+using couchbase::core::sasl::mechanism::scram::salted_password_cache;
+
+TEST_CASE("unit: salted password cache derives the key once", "[unit]")
+{
+  salted_password_cache cache{};
+
+  const auto expected =
+    couchbase::core::crypto::PBKDF2_HMAC(Algorithm::ALG_SHA512, "password", "salt", 1000);
+
+  std::vector<std::thread> threads{};
+  std::vector<std::string> results(8);
+  for (std::size_t i = 0; i < results.size(); ++i) {
+    threads.emplace_back([&cache, &results, i]() {
+      results[i] = cache.get(Algorithm::ALG_SHA512, "alice", "password", "salt", 1000);
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (const auto& result : results) {
+    REQUIRE(result == expected);
+  }
+  REQUIRE(cache.size() == 1);
+  REQUIRE(cache.derivations() == 1);
+
+  // every part of the server secret and the password makes a new entry
+  REQUIRE(cache.get(Algorithm::ALG_SHA512, "alice", "password", "pepper", 1000) != expected);
+  REQUIRE(cache.get(Algorithm::ALG_SHA512, "alice", "password", "salt", 2000) != expected);
+  REQUIRE(cache.get(Algorithm::ALG_SHA512, "alice", "secret", "salt", 1000) != expected);
+  REQUIRE(cache.get(Algorithm::ALG_SHA256, "alice", "password", "salt", 1000) != expected);
+  REQUIRE(cache.size() == 5);
+  REQUIRE(cache.derivations() == 5);
+}
+
+TEST_CASE("unit: salted password cache invalidates entries of the user", "[unit]")
+{
+  salted_password_cache cache{};
+
+  std::ignore = cache.get(Algorithm::ALG_SHA512, "alice", "password", "salt", 1000);
+  std::ignore = cache.get(Algorithm::ALG_SHA512, "alice", "password", "pepper", 1000);
+  std::ignore = cache.get(Algorithm::ALG_SHA512, "bob", "password", "salt", 1000);
+  REQUIRE(cache.size() == 3);
+
+  cache.invalidate("alice");
+  REQUIRE(cache.size() == 1);
+
+  std::ignore = cache.get(Algorithm::ALG_SHA512, "bob", "password", "salt", 1000);
+  REQUIRE(cache.derivations() == 3);
+  std::ignore = cache.get(Algorithm::ALG_SHA512, "alice", "password", "salt", 1000);
+  REQUIRE(cache.derivations() == 4);
+}
+
+TEST_CASE("unit: salted password cache evicts least recently used entry", "[unit]")
+{
+  salted_password_cache cache{ 2 };
+
+  std::ignore = cache.get(Algorithm::ALG_SHA512, "alice", "password", "salt", 1000);
+  std::ignore = cache.get(Algorithm::ALG_SHA512, "bob", "password", "salt", 1000);
+  std::ignore = cache.get(Algorithm::ALG_SHA512, "alice", "password", "salt", 1000);
+  std::ignore = cache.get(Algorithm::ALG_SHA512, "carol", "password", "salt", 1000);
+  REQUIRE(cache.size() == 2);
+  REQUIRE(cache.derivations() == 3);
+
+  // "bob" has been evicted, while "alice" is still there
+  std::ignore = cache.get(Algorithm::ALG_SHA512, "alice", "password", "salt", 1000);
+  REQUIRE(cache.derivations() == 3);
+  std::ignore = cache.get(Algorithm::ALG_SHA512, "bob", "password", "salt", 1000);
+  REQUIRE(cache.derivations() == 4);
+}
+
+TEST_CASE("unit: sessions reuse salted password during SCRAM bootstrap", "[unit]")
+{
+  test::utils::mock_mcbp_server_options options{};
+  options.scram_iteration_count = 10'000;
+  test::utils::mock_mcbp_server server{ options };
+
+  auto& cache = salted_password_cache::instance();
+  cache.clear();
+  const auto derivations = cache.derivations();
+
+  for (int i = 0; i < 3; ++i) {
+    auto cluster = test::utils::connect(server);
+    auto collection = cluster.bucket(options.bucket_name).default_collection();
+    auto [upsert_err, result] =
+      collection.upsert("foo", tao::json::value{ { "name", "scram" } }).get();
+    REQUIRE_SUCCESS(upsert_err.ec());
+    cluster.close().get();
+  }
+
+  // the cluster-level and the bucket sessions of all clusters share the single derivation
+  REQUIRE(cache.derivations() - derivations == 1);
+}
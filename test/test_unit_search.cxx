@@ -19,6 +19,9 @@
 
 #include "core/impl/encoded_search_query.hxx"
 #include "core/impl/encoded_search_sort.hxx"
+#include "core/operations/document_search.hxx"
+#include "core/utils/json.hxx"
+#include "core/utils/json_streaming_lexer.hxx"
 
 #include <couchbase/boolean_field_query.hxx>
 #include <couchbase/boolean_query.hxx>
@@ -468,3 +471,57 @@ TEST_CASE("unit: base64 vector query", "[unit]")
 }
 )"_json);
 }
+
+TEST_CASE("unit: search rows and facets decoded from the streamed response", "[unit]")
+{
+  const std::string body{
+    R"({"status":{"total":1,"failed":0,"successful":1},"request":{"query":{"query":"pool"}},)"
+    R"("hits":[)"
+    R"({"index":"travel_1","id":"hotel_1","score":1.5,"fields":{"name":"Pool Hotel"},)"
+    R"("locations":{"name":{"pool":[{"pos":1,"start":0,"end":4,"array_positions":null}]}}},)"
+    R"({"index":"travel_1","id":"hotel_2","score":0.5,"fragments":{"name":["<mark>pool</mark>"]}})"
+    R"(],"total_hits":2,"max_score":1.5,"took":1000,)"
+    R"("facets":{"type":{"field":"type","total":2,"missing":0,"other":0,)"
+    R"("terms":[{"term":"hotel","count":2}]}}})"
+  };
+
+  std::vector<couchbase::core::operations::search_response::search_row> rows{};
+  std::string meta{};
+  couchbase::core::utils::json::streaming_lexer lexer("/hits/^", 4);
+  lexer.on_row([&rows](std::string&& row) {
+    rows.emplace_back(
+      couchbase::core::operations::parse_search_row(couchbase::core::utils::json::parse(row)));
+    return couchbase::core::utils::json::stream_control::next_row;
+  });
+  lexer.on_complete([&meta](std::error_code /* ec */, std::size_t /* number_of_rows */,
+                            std::string&& metadata) {
+    meta = std::move(metadata);
+  });
+  for (std::size_t offset = 0; offset < body.size(); offset += 32) {
+    lexer.feed(std::string_view{ body }.substr(offset, 32));
+  }
+
+  REQUIRE(rows.size() == 2);
+  REQUIRE(rows[0].id == "hotel_1");
+  REQUIRE(rows[0].score == 1.5);
+  REQUIRE(rows[0].fields == R"({"name":"Pool Hotel"})");
+  REQUIRE(rows[0].locations.size() == 1);
+  REQUIRE(rows[0].locations[0].term == "pool");
+  REQUIRE_FALSE(rows[0].locations[0].array_positions.has_value());
+  REQUIRE(rows[1].id == "hotel_2");
+  REQUIRE(rows[1].fragments.at("name") == std::vector<std::string>{ "<mark>pool</mark>" });
+
+  couchbase::core::operations::search_request req{};
+  couchbase::core::io::http_response http_resp;
+  http_resp.status_code = 200;
+  http_resp.body.append(meta);
+  auto resp = req.make_response({}, http_resp);
+  REQUIRE_FALSE(resp.ctx.ec);
+  REQUIRE(resp.rows.empty());
+  REQUIRE(resp.meta.metrics.total_rows == 2);
+  REQUIRE(resp.meta.metrics.success_partition_count == 1);
+  REQUIRE(resp.facets.size() == 1);
+  REQUIRE(resp.facets[0].name == "type");
+  REQUIRE(resp.facets[0].terms.size() == 1);
+  REQUIRE(resp.facets[0].terms[0].count == 2);
+}
@@ -24,6 +24,7 @@
 #include <asio/io_context.hpp>
 #include <asio/ip/tcp.hpp>
 #include <asio/ssl.hpp>
+#include <asio/write.hpp>
 
 #include <cstring>
 #include <memory>
@@ -209,3 +210,83 @@ TEST_CASE("unit: TLS handshake configuration rejects an empty hostname", "[unit]
   const auto ec = couchbase::core::io::configure_tls_handshake(client_stream, "");
   CHECK(ec);
 }
+
+TEST_CASE("unit: TLS streams resume sessions of the same endpoint", "[unit]")
+{
+  asio::io_context io;
+
+  asio::ssl::context server_ctx{ asio::ssl::context::tls_server };
+  server_ctx.use_certificate_chain(asio::buffer(server_cert, std::strlen(server_cert)));
+  server_ctx.use_private_key(asio::buffer(server_key, std::strlen(server_key)),
+                             asio::ssl::context::pem);
+
+  auto client_ctx = std::make_shared<asio::ssl::context>(asio::ssl::context::tls_client);
+  client_ctx->add_certificate_authority(asio::buffer(server_cert, std::strlen(server_cert)));
+  client_ctx->set_verify_mode(asio::ssl::verify_peer);
+  couchbase::core::tls_context_provider provider{ client_ctx };
+
+  asio::ip::tcp::acceptor acceptor{
+    io, asio::ip::tcp::endpoint{ asio::ip::make_address("127.0.0.1"), 0 }
+  };
+  const asio::ip::tcp::endpoint endpoint{ asio::ip::make_address("127.0.0.1"),
+                                          acceptor.local_endpoint().port() };
+
+  // The server sends one byte after the handshake, so that the client receives the TLS 1.3
+  // session tickets, that follow the handshake, before the stream is closed.
+  const auto connect_and_close = [&]() {
+    asio::ssl::stream<asio::ip::tcp::socket> server_stream{ io, server_ctx };
+    acceptor.async_accept(server_stream.lowest_layer(), [&](std::error_code accept_ec) {
+      REQUIRE_FALSE(accept_ec);
+      server_stream.async_handshake(asio::ssl::stream_base::server, [&](std::error_code ec) {
+        REQUIRE_FALSE(ec);
+        asio::async_write(server_stream, asio::buffer("x", 1), [](std::error_code, std::size_t) {
+        });
+      });
+    });
+
+    couchbase::core::io::tls_stream_impl client_stream{ io, provider };
+    char byte{};
+    std::error_code client_ec{ asio::error::would_block };
+    client_stream.async_connect(endpoint, "correct.example", [&](std::error_code connect_ec) {
+      client_ec = connect_ec;
+      if (connect_ec) {
+        return;
+      }
+      client_stream.async_read_some(asio::buffer(&byte, 1),
+                                    [&](std::error_code read_ec, std::size_t /* bytes */) {
+                                      client_ec = read_ec;
+                                      client_stream.close([](std::error_code) {
+                                      });
+                                    });
+    });
+
+    io.restart();
+    io.run();
+    return client_ec;
+  };
+
+  const auto& sessions = provider.session_cache();
+
+  REQUIRE_FALSE(connect_and_close());
+  REQUIRE(sessions->size() == 1);
+  REQUIRE(sessions->stats().full_handshakes == 1);
+  REQUIRE(sessions->stats().resumed_handshakes == 0);
+
+  REQUIRE_FALSE(connect_and_close());
+  REQUIRE_FALSE(connect_and_close());
+  REQUIRE(sessions->stats().full_handshakes == 1);
+  REQUIRE(sessions->stats().resumed_handshakes == 2);
+
+  SECTION("new TLS context forgets the sessions")
+  {
+    auto new_ctx = std::make_shared<asio::ssl::context>(asio::ssl::context::tls_client);
+    new_ctx->add_certificate_authority(asio::buffer(server_cert, std::strlen(server_cert)));
+    new_ctx->set_verify_mode(asio::ssl::verify_peer);
+    provider.set_ctx(new_ctx);
+    REQUIRE(sessions->size() == 0);
+
+    REQUIRE_FALSE(connect_and_close());
+    REQUIRE(sessions->stats().full_handshakes == 2);
+    REQUIRE(sessions->stats().resumed_handshakes == 2);
+  }
+}
@@ -16,6 +16,7 @@
 
 #include "test_helper.hxx"
 
+#include "core/transactions/internal/atr_read_limiter.hxx"
 #include "core/transactions/internal/exceptions_internal.hxx"
 #include "core/transactions/internal/utils.hxx"
 
@@ -365,3 +366,41 @@ TEST_CASE("transaction_get_result: can convert core transaction_get_result to "
     REQUIRE(final_public_res.id().empty());
   }
 }
+
+TEST_CASE("atr_read_limiter: limits reads in flight", "[unit]")
+{
+  const auto now = atr_read_limiter::clock::now();
+  atr_read_limiter limiter{ 2, 0, now };
+  atr_read_limiter::clock::duration retry_after{};
+
+  REQUIRE(limiter.try_acquire(now, retry_after));
+  REQUIRE(limiter.try_acquire(now, retry_after));
+  REQUIRE(limiter.in_flight() == 2);
+  REQUIRE_FALSE(limiter.try_acquire(now, retry_after));
+  // the caller has to wait for release()
+  REQUIRE(retry_after == atr_read_limiter::clock::duration::zero());
+
+  limiter.release();
+  REQUIRE(limiter.in_flight() == 1);
+  REQUIRE(limiter.try_acquire(now, retry_after));
+}
+
+TEST_CASE("atr_read_limiter: limits rate of reads", "[unit]")
+{
+  const auto now = atr_read_limiter::clock::now();
+  atr_read_limiter limiter{ 100, 10, now };
+  atr_read_limiter::clock::duration retry_after{};
+
+  // allows burst of one second worth of reads
+  for (int i = 0; i < 10; ++i) {
+    REQUIRE(limiter.try_acquire(now, retry_after));
+    limiter.release();
+  }
+  REQUIRE_FALSE(limiter.try_acquire(now, retry_after));
+  REQUIRE(retry_after > atr_read_limiter::clock::duration::zero());
+  REQUIRE(retry_after <= std::chrono::milliseconds(100));
+
+  // one token is added every 100ms
+  REQUIRE(limiter.try_acquire(now + std::chrono::milliseconds(100), retry_after));
+  REQUIRE_FALSE(limiter.try_acquire(now + std::chrono::milliseconds(100), retry_after));
+}
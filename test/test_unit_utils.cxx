@@ -17,16 +17,19 @@
 
 #include "test_helper.hxx"
 
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/matchers/catch_matchers.hpp>
 #include <catch2/matchers/catch_matchers_exception.hpp>
 #include <catch2/matchers/catch_matchers_string.hpp>
 
+#include "core/document_id.hxx"
 #include "core/meta/version.hxx"
 #include "core/platform/base64.h"
-#include "core/utils/concurrent_fixed_priority_queue.hxx"
+#include "core/utils/concurrent_top_n_sampler.hxx"
 #include "core/utils/join_strings.hxx"
 #include "core/utils/json.hxx"
 #include "core/utils/movable_function.hxx"
+#include "core/utils/pool_allocator.hxx"
 #include "core/utils/url_codec.hxx"
 
 #include <couchbase/build_config.hxx>
@@ -37,6 +40,14 @@
 #include "include_ssl/crypto.h"
 #include <tao/json.hpp>
 
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
 TEST_CASE("unit: transformer to deduplicate JSON keys", "[unit]")
 {
   using Catch::Matchers::ContainsSubstring;
@@ -295,62 +306,134 @@ TEST_CASE("unit: semantic version string", "[unit]")
   REQUIRE(couchbase::core::meta::parse_git_describe_output("1.0.0-beta.4") == "1.0.0-beta.4");
 }
 
-TEST_CASE("unit: concurrent fixed queue", "[unit]")
+TEST_CASE("unit: concurrent top-n sampler", "[unit]")
 {
-  auto queue = couchbase::core::utils::concurrent_fixed_priority_queue<int>(3);
-  REQUIRE(queue.empty());
+  couchbase::core::utils::concurrent_top_n_sampler<int> sampler(3);
+  REQUIRE(sampler.empty());
 
   SECTION("fewer items than capacity")
   {
-    queue.emplace(1);
-    queue.emplace(2);
+    sampler.emplace(1, 1);
+    sampler.emplace(2, 2);
 
-    auto [data, dropped] = queue.steal_data();
+    auto [data, dropped] = sampler.steal_data();
     REQUIRE(dropped == 0);
-    REQUIRE(data.size() == 2);
-    REQUIRE(data.top() == 2);
-    data.pop();
-    REQUIRE(data.top() == 1);
-    data.pop();
+    REQUIRE(data == std::vector<int>{ 2, 1 });
   }
 
   SECTION("at capacity")
   {
-    queue.emplace(10);
-    queue.emplace(1);
-    queue.emplace(2);
+    sampler.emplace(10, 10);
+    sampler.emplace(1, 1);
+    sampler.emplace(2, 2);
 
-    auto [data, dropped] = queue.steal_data();
+    auto [data, dropped] = sampler.steal_data();
     REQUIRE(dropped == 0);
-    REQUIRE(data.size() == 3);
-    REQUIRE(data.top() == 10);
-    data.pop();
-    REQUIRE(data.top() == 2);
-    data.pop();
-    REQUIRE(data.top() == 1);
-    data.pop();
+    REQUIRE(data == std::vector<int>{ 10, 2, 1 });
   }
 
   SECTION("more items than capacity")
   {
-    queue.emplace(2);
-    queue.emplace(10);
-    queue.emplace(1);
-    queue.emplace(20);
-    queue.emplace(5);
+    sampler.emplace(2, 2);
+    sampler.emplace(10, 10);
+    sampler.emplace(1, 1);
+    sampler.emplace(20, 20);
+    sampler.emplace(5, 5);
 
-    auto [data, dropped] = queue.steal_data();
+    auto [data, dropped] = sampler.steal_data();
     REQUIRE(dropped == 2);
-    REQUIRE(data.size() == 3);
-    REQUIRE(data.top() == 20);
-    data.pop();
-    REQUIRE(data.top() == 10);
-    data.pop();
-    REQUIRE(data.top() == 5);
-    data.pop();
+    REQUIRE(data == std::vector<int>{ 20, 10, 5 });
+  }
+
+  SECTION("does not construct items below the floor")
+  {
+    std::size_t number_of_constructed{ 0 };
+    for (const int weight : { 10, 20, 30, 5, 10, 40 }) {
+      sampler.offer(weight, [&number_of_constructed, weight]() {
+        ++number_of_constructed;
+        return weight;
+      });
+    }
+    REQUIRE(number_of_constructed == 4);
+
+    auto [data, dropped] = sampler.steal_data();
+    REQUIRE(dropped == 3);
+    REQUIRE(data == std::vector<int>{ 40, 30, 20 });
+  }
+
+  SECTION("keeps the heaviest items offered from multiple threads")
+  {
+    constexpr int number_of_threads{ 16 };
+    constexpr int items_per_thread{ 1'000 };
+    std::vector<std::thread> threads;
+    threads.reserve(number_of_threads);
+    for (int t = 0; t < number_of_threads; ++t) {
+      threads.emplace_back([&sampler, t]() {
+        for (int i = 0; i < items_per_thread; ++i) {
+          const int value = i * number_of_threads + t;
+          sampler.emplace(value, int{ value });
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    constexpr int max_value = (number_of_threads * items_per_thread) - 1;
+    auto [data, dropped] = sampler.steal_data();
+    REQUIRE(dropped == (number_of_threads * items_per_thread) - 3);
+    REQUIRE(data == std::vector<int>{ max_value, max_value - 1, max_value - 2 });
   }
 
-  REQUIRE(queue.empty());
+  REQUIRE(sampler.empty());
+
+  // the floor is reset after stealing the data
+  sampler.emplace(0, 0);
+  auto [data, dropped] = sampler.steal_data();
+  REQUIRE(dropped == 0);
+  REQUIRE(data == std::vector<int>{ 0 });
+}
+
+TEST_CASE("unit: concurrent top-n sampler without capacity stays empty", "[unit]")
+{
+  couchbase::core::utils::concurrent_top_n_sampler<int> sampler(0);
+  REQUIRE_FALSE(sampler.emplace(1, 1));
+  REQUIRE(sampler.empty());
+
+  auto [data, dropped] = sampler.steal_data();
+  REQUIRE(data.empty());
+  REQUIRE(dropped == 1);
+}
+
+TEST_CASE("benchmark: concurrent top-n sampler", "[.][benchmark]")
+{
+  constexpr std::int64_t items_per_thread{ 100'000 };
+
+  for (const std::size_t number_of_threads : { 1U, 4U, 16U, 64U }) {
+    couchbase::core::utils::concurrent_top_n_sampler<std::string> sampler(10);
+
+    BENCHMARK("offer from " + std::to_string(number_of_threads) + " threads")
+    {
+      std::vector<std::thread> threads;
+      threads.reserve(number_of_threads);
+      for (std::size_t t = 0; t < number_of_threads; ++t) {
+        threads.emplace_back([&sampler, t]() {
+          std::mt19937_64 gen{ t };
+          std::lognormal_distribution<double> latency{ 7.0, 1.0 };
+          for (std::int64_t i = 0; i < items_per_thread; ++i) {
+            const auto weight = static_cast<std::int64_t>(latency(gen));
+            sampler.offer(weight, [weight]() {
+              return std::to_string(weight);
+            });
+          }
+        });
+      }
+      for (auto& thread : threads) {
+        thread.join();
+      }
+      return sampler.steal_data();
+    };
+  }
 }
 
 #if 0
@@ -385,3 +468,83 @@ TEST_CASE("unit: uuid collision", "[unit]")
     }
 }
 #endif
+
+TEST_CASE("unit: pool_allocator reuses released blocks", "[unit]")
+{
+  struct pooled_object {
+    std::array<char, 333> payload{};
+  };
+  couchbase::core::utils::pool_allocator<pooled_object> allocator{};
+
+  auto* first = allocator.allocate(1);
+  allocator.deallocate(first, 1);
+  auto* second = allocator.allocate(1);
+  REQUIRE(first == second);
+  allocator.deallocate(second, 1);
+
+  const void* block{ nullptr };
+  {
+    auto object = std::allocate_shared<pooled_object>(allocator);
+    block = object.get();
+  }
+  auto object = std::allocate_shared<pooled_object>(allocator);
+  REQUIRE(object.get() == block);
+
+  auto* many = allocator.allocate(4);
+  REQUIRE(many != nullptr);
+  allocator.deallocate(many, 4);
+}
+
+TEST_CASE("unit: pool_allocator reuses blocks released on another thread", "[unit]")
+{
+  struct pooled_object {
+    std::array<char, 777> payload{};
+  };
+  using pool = couchbase::core::utils::detail::fixed_size_pool<sizeof(pooled_object),
+                                                               alignof(pooled_object)>;
+  couchbase::core::utils::pool_allocator<pooled_object> allocator{};
+
+  std::vector<pooled_object*> objects{};
+  for (std::size_t i = 0; i < 2 * pool::batch_size; ++i) {
+    objects.push_back(allocator.allocate(1));
+  }
+  std::thread([&allocator, &objects]() {
+    for (auto* object : objects) {
+      allocator.deallocate(object, 1);
+    }
+  }).join();
+
+  auto* reused = allocator.allocate(1);
+  REQUIRE(std::find(objects.begin(), objects.end(), reused) != objects.end());
+  allocator.deallocate(reused, 1);
+}
+
+TEST_CASE("unit: document IDs share keyspace and its collection UID", "[unit]")
+{
+  auto keyspace = couchbase::core::make_keyspace("travel-sample", "inventory", "airline");
+
+  couchbase::core::document_id first{ keyspace, "airline_10" };
+  couchbase::core::document_id second{ keyspace, "airline_137" };
+  REQUIRE(first.bucket() == "travel-sample");
+  REQUIRE(first.scope() == "inventory");
+  REQUIRE(first.collection() == "airline");
+  REQUIRE(first.collection_path() == "inventory.airline");
+  REQUIRE(&first.collection_path() == &second.collection_path());
+  REQUIRE_FALSE(first.has_default_collection());
+
+  REQUIRE_FALSE(second.keyspace().collection_uid().has_value());
+  first.keyspace().collection_uid(0xffffffff);
+  REQUIRE(second.keyspace().collection_uid() == 0xffffffff);
+  first.keyspace().collection_uid(8);
+  REQUIRE(second.keyspace().collection_uid() == 8);
+  // the UID resolved for the request is not changed by the keyspace
+  REQUIRE_FALSE(second.is_collection_resolved());
+
+  couchbase::core::document_id legacy{ "travel-sample", "_default", "_default", "key" };
+  REQUIRE(legacy.collection_path() == "_default._default");
+  REQUIRE(legacy.has_default_collection());
+
+  const couchbase::core::document_id empty{};
+  REQUIRE(empty.bucket().empty());
+  REQUIRE(empty.collection_path().empty());
+}
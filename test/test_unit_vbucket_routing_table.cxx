@@ -0,0 +1,55 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2025-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test_helper.hxx"
+
+#include "core/topology/configuration.hxx"
+#include "core/topology/vbucket_routing_table.hxx"
+
+#include <string>
+
+TEST_CASE("unit: vbucket routing table matches configuration", "[unit]")
+{
+  couchbase::core::topology::configuration config{};
+  config.vbmap = couchbase::core::topology::configuration::vbucket_map{
+    { 0, 1 }, { 1, 2 }, { 2, -1 }, { -1, 0 }, { 1, 0 }, { 2, 1 }, { 0, 2 }, { 1, -1 },
+  };
+  const couchbase::core::topology::vbucket_routing_table table{ config };
+  REQUIRE(table.number_of_vbuckets() == 8);
+
+  for (std::size_t i = 0; i < 100; ++i) {
+    const auto key = "key_" + std::to_string(i);
+    for (std::size_t index = 0; index < 2; ++index) {
+      CHECK(table.map_key(key, index) == config.map_key(key, index));
+    }
+  }
+
+  CHECK_FALSE(table.server_by_vbucket(2, 1).has_value());
+  CHECK(table.server_by_vbucket(3, 1) == 0);
+  CHECK_FALSE(table.server_by_vbucket(8, 0).has_value());
+  CHECK_FALSE(table.server_by_vbucket(0, 2).has_value());
+}
+
+TEST_CASE("unit: vbucket routing table without partition map", "[unit]")
+{
+  const couchbase::core::topology::configuration config{};
+  const couchbase::core::topology::vbucket_routing_table table{ config };
+  CHECK(table.empty());
+  auto [vbucket, server] = table.map_key(std::string{ "foo" }, 0);
+  CHECK(vbucket == 0);
+  CHECK_FALSE(server.has_value());
+}
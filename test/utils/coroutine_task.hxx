@@ -0,0 +1,63 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2025-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include <coroutine>
+#include <exception>
+#include <future>
+
+namespace test::utils
+{
+/**
+ * Eagerly started coroutine, that reports its result through std::future, so that the test can
+ * wait for it and check the result on the main thread.
+ */
+template<typename T>
+struct coroutine_task {
+  struct promise_type {
+    std::promise<T> result{};
+
+    auto get_return_object() -> coroutine_task
+    {
+      return { result.get_future() };
+    }
+
+    auto initial_suspend() noexcept -> std::suspend_never
+    {
+      return {};
+    }
+
+    auto final_suspend() noexcept -> std::suspend_never
+    {
+      return {};
+    }
+
+    void return_value(T value)
+    {
+      result.set_value(std::move(value));
+    }
+
+    void unhandled_exception()
+    {
+      result.set_exception(std::current_exception());
+    }
+  };
+
+  std::future<T> result;
+};
+} // namespace test::utils
@@ -0,0 +1,1055 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2025-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "mock_mcbp_server.hxx"
+
+#include "core/crypto/cbcrypto.h"
+#include "core/error_context/key_value_status_code.hxx"
+#include "core/platform/base64.h"
+#include "core/protocol/client_opcode.hxx"
+#include "core/protocol/client_request.hxx"
+#include "core/protocol/datatype.hxx"
+#include "core/protocol/hello_feature.hxx"
+#include "core/protocol/magic.hxx"
+#include "core/utils/crc32.hxx"
+#include "core/utils/unsigned_leb128.hxx"
+
+#include <asio.hpp>
+#include <spdlog/fmt/bundled/core.h>
+#include <tao/json.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <list>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace test::utils
+{
+namespace
+{
+using couchbase::core::key_value_status_code;
+namespace protocol = couchbase::core::protocol;
+
+constexpr std::size_t header_size{ 24 };
+
+auto
+read_uint16(const std::byte* data) -> std::uint16_t
+{
+  return static_cast<std::uint16_t>((std::to_integer<std::uint16_t>(data[0]) << 8U) |
+                                    std::to_integer<std::uint16_t>(data[1]));
+}
+
+auto
+read_uint32(const std::byte* data) -> std::uint32_t
+{
+  return (std::to_integer<std::uint32_t>(data[0]) << 24U) |
+         (std::to_integer<std::uint32_t>(data[1]) << 16U) |
+         (std::to_integer<std::uint32_t>(data[2]) << 8U) | std::to_integer<std::uint32_t>(data[3]);
+}
+
+template<typename T>
+void
+write_big_endian(std::vector<std::byte>& output, T value)
+{
+  for (std::size_t i = sizeof(T); i > 0; --i) {
+    output.push_back(static_cast<std::byte>((value >> ((i - 1) * 8U)) & 0xffU));
+  }
+}
+
+void
+write_leb128(std::vector<std::byte>& output, std::size_t value)
+{
+  const couchbase::core::utils::unsigned_leb128<std::uint64_t> encoded(value);
+  output.insert(output.end(), encoded.begin(), encoded.end());
+}
+
+auto
+to_bytes(std::string_view text) -> std::vector<std::byte>
+{
+  const auto* data = reinterpret_cast<const std::byte*>(text.data());
+  return { data, data + text.size() };
+}
+
+struct mock_request {
+  std::uint8_t opcode{};
+  std::uint8_t datatype{};
+  std::uint16_t vbucket{};
+  std::array<std::byte, 4> opaque{};
+  std::uint64_t cas{};
+  std::vector<std::byte> extras{};
+  std::string key{};
+  std::vector<std::byte> value{};
+};
+
+struct mock_response {
+  key_value_status_code status{ key_value_status_code::success };
+  std::vector<std::byte> extras{};
+  std::vector<std::byte> value{};
+  std::uint8_t datatype{ 0 };
+  std::uint64_t cas{ 0 };
+};
+
+struct mock_document {
+  std::vector<std::byte> value{};
+  std::uint32_t flags{};
+  std::uint8_t datatype{};
+  std::uint64_t cas{};
+};
+
+struct mock_range_scan {
+  std::vector<std::pair<std::string, mock_document>> items{};
+  std::size_t position{ 0 };
+  bool ids_only{ false };
+};
+
+auto
+encode_response(const mock_request& request, const mock_response& response)
+  -> std::vector<std::byte>
+{
+  std::vector<std::byte> packet;
+  packet.reserve(header_size + response.extras.size() + response.value.size());
+  packet.push_back(static_cast<std::byte>(protocol::magic::client_response));
+  packet.push_back(static_cast<std::byte>(request.opcode));
+  write_big_endian<std::uint16_t>(packet, 0); // key is never sent back
+  packet.push_back(static_cast<std::byte>(response.extras.size()));
+  packet.push_back(static_cast<std::byte>(response.datatype));
+  write_big_endian(packet, static_cast<std::uint16_t>(response.status));
+  write_big_endian(packet,
+                   static_cast<std::uint32_t>(response.extras.size() + response.value.size()));
+  packet.insert(packet.end(), request.opaque.begin(), request.opaque.end());
+  write_big_endian(packet, response.cas);
+  packet.insert(packet.end(), response.extras.begin(), response.extras.end());
+  packet.insert(packet.end(), response.value.begin(), response.value.end());
+  return packet;
+}
+
+auto
+is_data_operation(protocol::client_opcode opcode) -> bool
+{
+  switch (opcode) {
+    case protocol::client_opcode::get:
+    case protocol::client_opcode::upsert:
+    case protocol::client_opcode::insert:
+    case protocol::client_opcode::replace:
+    case protocol::client_opcode::remove:
+    case protocol::client_opcode::range_scan_create:
+    case protocol::client_opcode::range_scan_continue:
+    case protocol::client_opcode::range_scan_cancel:
+      return true;
+    default:
+      break;
+  }
+  return false;
+}
+} // namespace
+
+class mock_connection;
+
+class mock_mcbp_server_impl
+{
+public:
+  explicit mock_mcbp_server_impl(mock_mcbp_server_options options)
+    : options_{ std::move(options) }
+  {
+    if (options_.scram_iteration_count > 0) {
+      // like the real server, derive the secret once, and not for every authentication
+      scram_salted_password_ = couchbase::core::crypto::PBKDF2_HMAC(
+        couchbase::core::crypto::Algorithm::ALG_SHA512,
+        options_.password,
+        scram_salt_,
+        options_.scram_iteration_count);
+    }
+    const asio::ip::tcp::endpoint endpoint{ asio::ip::address_v4::loopback(), 0 };
+    acceptor_.open(endpoint.protocol());
+    acceptor_.set_option(asio::ip::tcp::acceptor::reuse_address(true));
+    acceptor_.bind(endpoint);
+    acceptor_.listen();
+    port_ = acceptor_.local_endpoint().port();
+    do_accept();
+    thread_ = std::thread([this]() {
+      io_.run();
+    });
+  }
+
+  mock_mcbp_server_impl(const mock_mcbp_server_impl&) = delete;
+  mock_mcbp_server_impl(mock_mcbp_server_impl&&) = delete;
+  auto operator=(const mock_mcbp_server_impl&) -> mock_mcbp_server_impl& = delete;
+  auto operator=(mock_mcbp_server_impl&&) -> mock_mcbp_server_impl& = delete;
+
+  ~mock_mcbp_server_impl()
+  {
+    stop();
+  }
+
+  void stop();
+
+  [[nodiscard]] auto port() const -> std::uint16_t
+  {
+    return port_;
+  }
+
+  [[nodiscard]] auto options() const -> const mock_mcbp_server_options&
+  {
+    return options_;
+  }
+
+  [[nodiscard]] auto scram_salt() const -> const std::string&
+  {
+    return scram_salt_;
+  }
+
+  [[nodiscard]] auto scram_salted_password() const -> const std::string&
+  {
+    return scram_salted_password_;
+  }
+
+  [[nodiscard]] auto stats() const -> mock_mcbp_server_stats
+  {
+    return {
+      connections_count_.load(),
+      requests_count_.load(),
+      injected_not_my_vbucket_count_.load(),
+      compressed_responses_count_.load(),
+    };
+  }
+
+  void count_request()
+  {
+    ++requests_count_;
+  }
+
+  void count_compressed_response()
+  {
+    ++compressed_responses_count_;
+  }
+
+  /**
+   * Decides whether the data operation has to be rejected with "not my vbucket".
+   */
+  auto inject_not_my_vbucket() -> bool
+  {
+    if (options_.not_my_vbucket_every == 0) {
+      return false;
+    }
+    if (++data_operations_count_ % options_.not_my_vbucket_every != 0) {
+      return false;
+    }
+    ++injected_not_my_vbucket_count_;
+    return true;
+  }
+
+  [[nodiscard]] auto vbucket_of(const std::string& key) const -> std::uint16_t
+  {
+    return static_cast<std::uint16_t>(couchbase::core::utils::hash_crc32(key.data(), key.size()) %
+                                      options_.number_of_vbuckets);
+  }
+
+  [[nodiscard]] auto configuration(bool with_bucket) const -> std::string
+  {
+    tao::json::value node = {
+      { "thisNode", true },
+      { "hostname", "127.0.0.1" },
+      { "services", { { "kv", static_cast<std::uint64_t>(port_) } } },
+    };
+    tao::json::value config = {
+      { "rev", 1 },
+      { "revEpoch", 1 },
+      { "nodesExt", tao::json::empty_array },
+    };
+    config["nodesExt"].emplace_back(std::move(node));
+    if (with_bucket) {
+      tao::json::value vbucket_map = tao::json::empty_array;
+      for (std::uint16_t vbucket = 0; vbucket < options_.number_of_vbuckets; ++vbucket) {
+        tao::json::value active_node = tao::json::empty_array;
+        active_node.emplace_back(0);
+        vbucket_map.emplace_back(std::move(active_node));
+      }
+      tao::json::value server_list = tao::json::empty_array;
+      server_list.emplace_back(fmt::format("127.0.0.1:{}", port_));
+      tao::json::value capabilities = tao::json::empty_array;
+      for (const auto* capability : { "cccp", "collections", "nodesExt", "rangeScan", "xattr" }) {
+        capabilities.emplace_back(capability);
+      }
+      config["name"] = options_.bucket_name;
+      config["uuid"] = "6d6f636b5f6d6362705f736572766572";
+      config["nodeLocator"] = "vbucket";
+      config["bucketCapabilities"] = std::move(capabilities);
+      config["vBucketServerMap"] = {
+        { "hashAlgorithm", "CRC" },
+        { "numReplicas", 0 },
+        { "serverList", std::move(server_list) },
+        { "vBucketMap", std::move(vbucket_map) },
+      };
+    }
+    return tao::json::to_string(config);
+  }
+
+  void upsert(const std::string& key,
+              std::vector<std::byte> value,
+              std::uint32_t flags,
+              std::uint8_t datatype)
+  {
+    const std::scoped_lock lock(mutex_);
+    documents_[key] = { std::move(value), flags, datatype, next_cas() };
+  }
+
+  auto store(const mock_request& request, std::string key) -> mock_response
+  {
+    const std::scoped_lock lock(mutex_);
+    auto it = documents_.find(key);
+    const auto opcode = static_cast<protocol::client_opcode>(request.opcode);
+    if (opcode == protocol::client_opcode::insert && it != documents_.end()) {
+      return { key_value_status_code::exists };
+    }
+    if (opcode == protocol::client_opcode::replace) {
+      if (it == documents_.end()) {
+        return { key_value_status_code::not_found };
+      }
+      if (request.cas != 0 && request.cas != it->second.cas) {
+        return { key_value_status_code::exists };
+      }
+    }
+    mock_document document{
+      request.value,
+      request.extras.size() >= 4 ? read_uint32(request.extras.data()) : 0,
+      request.datatype,
+      next_cas(),
+    };
+    mock_response response{};
+    response.cas = document.cas;
+    documents_[std::move(key)] = std::move(document);
+    return response;
+  }
+
+  auto remove(const mock_request& request, const std::string& key) -> mock_response
+  {
+    const std::scoped_lock lock(mutex_);
+    auto it = documents_.find(key);
+    if (it == documents_.end()) {
+      return { key_value_status_code::not_found };
+    }
+    if (request.cas != 0 && request.cas != it->second.cas) {
+      return { key_value_status_code::exists };
+    }
+    documents_.erase(it);
+    mock_response response{};
+    response.cas = next_cas();
+    return response;
+  }
+
+  auto find(const std::string& key) const -> std::optional<mock_document>
+  {
+    const std::scoped_lock lock(mutex_);
+    if (auto it = documents_.find(key); it != documents_.end()) {
+      return it->second;
+    }
+    return {};
+  }
+
+  auto next_sequence_number() -> std::uint64_t
+  {
+    return ++sequence_number_;
+  }
+
+  auto create_range_scan(const mock_request& request) -> mock_response
+  {
+    tao::json::value body;
+    try {
+      body = tao::json::from_string(
+        std::string_view{ reinterpret_cast<const char*>(request.value.data()), request.value.size() });
+    } catch (const std::exception&) {
+      return { key_value_status_code::invalid };
+    }
+    if (const auto* collection = body.find("collection");
+        collection != nullptr && collection->get_string() != "0") {
+      return { key_value_status_code::unknown_collection };
+    }
+
+    mock_range_scan scan{};
+    scan.ids_only = body.optional<bool>("key_only").value_or(false);
+
+    std::string from{};
+    std::string to{ "\xff" };
+    bool exclusive_from{ false };
+    bool exclusive_to{ false };
+    std::size_t limit{ std::numeric_limits<std::size_t>::max() };
+    if (const auto* range = body.find("range"); range != nullptr) {
+      if (const auto* term = range->find("start"); term != nullptr) {
+        from = couchbase::core::base64::decode_to_string(term->get_string());
+      } else if (const auto* excl = range->find("excl_start"); excl != nullptr) {
+        from = couchbase::core::base64::decode_to_string(excl->get_string());
+        exclusive_from = true;
+      }
+      if (const auto* term = range->find("end"); term != nullptr) {
+        to = couchbase::core::base64::decode_to_string(term->get_string());
+      } else if (const auto* excl = range->find("excl_end"); excl != nullptr) {
+        to = couchbase::core::base64::decode_to_string(excl->get_string());
+        exclusive_to = true;
+      }
+    } else if (const auto* sampling = body.find("sampling"); sampling != nullptr) {
+      limit = sampling->at("samples").as<std::size_t>();
+    }
+
+    {
+      const std::scoped_lock lock(mutex_);
+      for (auto it = documents_.lower_bound(from);
+           it != documents_.end() && scan.items.size() < limit;
+           ++it) {
+        const auto& key = it->first;
+        if (key > to || (exclusive_to && key == to)) {
+          break;
+        }
+        if (exclusive_from && key == from) {
+          continue;
+        }
+        if (vbucket_of(key) == request.vbucket) {
+          scan.items.emplace_back(key, it->second);
+        }
+      }
+    }
+    if (scan.items.empty()) {
+      return { key_value_status_code::not_found };
+    }
+
+    mock_response response{};
+    response.value.resize(16);
+    const auto id = ++range_scans_count_;
+    std::memcpy(response.value.data(), &id, sizeof(id));
+    const std::scoped_lock lock(mutex_);
+    range_scans_.emplace(std::string{ reinterpret_cast<const char*>(response.value.data()),
+                                      response.value.size() },
+                         std::move(scan));
+    return response;
+  }
+
+  /**
+   * Takes the next batch of the range scan.
+   *
+   * @return items of the batch, and flag that tells whether the scan is complete, or empty
+   * optional if the scan does not exist
+   */
+  auto continue_range_scan(const std::string& uuid, std::uint32_t item_limit)
+    -> std::optional<std::pair<mock_range_scan, bool>>
+  {
+    const std::scoped_lock lock(mutex_);
+    auto it = range_scans_.find(uuid);
+    if (it == range_scans_.end()) {
+      return {};
+    }
+    auto& scan = it->second;
+    mock_range_scan batch{};
+    batch.ids_only = scan.ids_only;
+    const auto limit =
+      std::min<std::size_t>(item_limit == 0 ? options_.range_scan_batch_item_limit : item_limit,
+                            options_.range_scan_batch_item_limit);
+    while (scan.position < scan.items.size() && batch.items.size() < limit) {
+      batch.items.emplace_back(std::move(scan.items[scan.position++]));
+    }
+    const bool complete = scan.position == scan.items.size();
+    if (complete) {
+      range_scans_.erase(it);
+    }
+    return std::make_pair(std::move(batch), complete);
+  }
+
+  auto cancel_range_scan(const std::string& uuid) -> bool
+  {
+    const std::scoped_lock lock(mutex_);
+    return range_scans_.erase(uuid) > 0;
+  }
+
+private:
+  void do_accept();
+
+  auto next_cas() -> std::uint64_t
+  {
+    return ++cas_;
+  }
+
+  const mock_mcbp_server_options options_;
+  const std::string scram_salt_{ "mock-mcbp-server-salt" };
+  std::string scram_salted_password_{};
+  asio::io_context io_{};
+  asio::executor_work_guard<asio::io_context::executor_type> work_guard_{ io_.get_executor() };
+  asio::ip::tcp::acceptor acceptor_{ io_ };
+  std::uint16_t port_{};
+  std::thread thread_{};
+  std::atomic_bool stopped_{ false };
+  std::list<std::weak_ptr<mock_connection>> connections_{};
+
+  mutable std::mutex mutex_{};
+  std::map<std::string, mock_document> documents_{};
+  std::map<std::string, mock_range_scan> range_scans_{};
+  std::uint64_t cas_{ 0x1650000000000000 };
+
+  std::atomic_uint64_t sequence_number_{ 0 };
+  std::atomic_uint64_t range_scans_count_{ 0 };
+  std::atomic_size_t data_operations_count_{ 0 };
+  std::atomic_size_t connections_count_{ 0 };
+  std::atomic_size_t requests_count_{ 0 };
+  std::atomic_size_t injected_not_my_vbucket_count_{ 0 };
+  std::atomic_size_t compressed_responses_count_{ 0 };
+};
+
+class mock_connection : public std::enable_shared_from_this<mock_connection>
+{
+public:
+  mock_connection(asio::ip::tcp::socket socket, mock_mcbp_server_impl& server)
+    : socket_{ std::move(socket) }
+    , server_{ server }
+  {
+  }
+
+  void start()
+  {
+    std::error_code ignored;
+    socket_.set_option(asio::ip::tcp::no_delay(true), ignored);
+    do_read_header();
+  }
+
+  void stop()
+  {
+    std::error_code ignored;
+    socket_.shutdown(asio::ip::tcp::socket::shutdown_both, ignored);
+    socket_.close(ignored);
+  }
+
+private:
+  void do_read_header()
+  {
+    asio::async_read(
+      socket_,
+      asio::buffer(header_),
+      [self = shared_from_this()](std::error_code ec, std::size_t /* bytes_transferred */) {
+        if (ec) {
+          return;
+        }
+        self->body_.resize(read_uint32(self->header_.data() + 8));
+        if (self->body_.empty()) {
+          self->handle_request();
+          return self->do_read_header();
+        }
+        asio::async_read(
+          self->socket_,
+          asio::buffer(self->body_),
+          [self](std::error_code body_ec, std::size_t /* bytes_transferred */) {
+            if (body_ec) {
+              return;
+            }
+            self->handle_request();
+            self->do_read_header();
+          });
+      });
+  }
+
+  void handle_request()
+  {
+    server_.count_request();
+    mock_request request{};
+    const auto magic = static_cast<protocol::magic>(header_[0]);
+    request.opcode = std::to_integer<std::uint8_t>(header_[1]);
+    std::size_t framing_extras_size{ 0 };
+    std::size_t key_size{ read_uint16(header_.data() + 2) };
+    if (magic == protocol::magic::alt_client_request) {
+      framing_extras_size = std::to_integer<std::size_t>(header_[2]);
+      key_size = std::to_integer<std::size_t>(header_[3]);
+    }
+    const auto extras_size = std::to_integer<std::size_t>(header_[4]);
+    request.datatype = std::to_integer<std::uint8_t>(header_[5]);
+    request.vbucket = read_uint16(header_.data() + 6);
+    std::memcpy(request.opaque.data(), header_.data() + 12, request.opaque.size());
+    request.cas = (static_cast<std::uint64_t>(read_uint32(header_.data() + 16)) << 32U) |
+                  read_uint32(header_.data() + 20);
+
+    auto offset = framing_extras_size;
+    request.extras.assign(body_.begin() + static_cast<std::ptrdiff_t>(offset),
+                          body_.begin() + static_cast<std::ptrdiff_t>(offset + extras_size));
+    offset += extras_size;
+    request.key.assign(reinterpret_cast<const char*>(body_.data()) + offset, key_size);
+    offset += key_size;
+    request.value.assign(body_.begin() + static_cast<std::ptrdiff_t>(offset), body_.end());
+
+    const auto opcode = static_cast<protocol::client_opcode>(request.opcode);
+    if (is_data_operation(opcode) && opcode != protocol::client_opcode::range_scan_continue &&
+        opcode != protocol::client_opcode::range_scan_cancel && server_.inject_not_my_vbucket()) {
+      mock_response response{ key_value_status_code::not_my_vbucket };
+      response.value = to_bytes(server_.configuration(true));
+      response.datatype = static_cast<std::uint8_t>(protocol::datatype::json);
+      return send(encode_response(request, response), true);
+    }
+
+    switch (opcode) {
+      case protocol::client_opcode::hello:
+        return send(encode_response(request, hello(request)), false);
+
+      case protocol::client_opcode::sasl_list_mechs: {
+        mock_response response{};
+        response.value = to_bytes(server_.options().scram_iteration_count > 0 ? "SCRAM-SHA512 PLAIN"
+                                                                              : "PLAIN");
+        return send(encode_response(request, response), false);
+      }
+
+      case protocol::client_opcode::sasl_auth:
+        return send(encode_response(request, authenticate(request)), false);
+
+      case protocol::client_opcode::sasl_step:
+        return send(encode_response(request, scram_final(request)), false);
+
+      case protocol::client_opcode::select_bucket: {
+        if (request.key != server_.options().bucket_name) {
+          return send(encode_response(request, { key_value_status_code::no_access }), false);
+        }
+        bucket_selected_ = true;
+        return send(encode_response(request, {}), false);
+      }
+
+      case protocol::client_opcode::get_cluster_config: {
+        mock_response response{};
+        response.value = to_bytes(server_.configuration(bucket_selected_));
+        response.datatype = static_cast<std::uint8_t>(protocol::datatype::json);
+        return send(encode_response(request, response), false);
+      }
+
+      case protocol::client_opcode::get_collection_id: {
+        const std::string path{ reinterpret_cast<const char*>(request.value.data()),
+                                request.value.size() };
+        if (path != "_default._default" && path != "." && !path.empty()) {
+          return send(encode_response(request, { key_value_status_code::unknown_collection }),
+                      false);
+        }
+        mock_response response{};
+        write_big_endian<std::uint64_t>(response.extras, 0); // manifest uid
+        write_big_endian<std::uint32_t>(response.extras, 0); // collection uid
+        return send(encode_response(request, response), false);
+      }
+
+      case protocol::client_opcode::noop:
+        return send(encode_response(request, {}), false);
+
+      case protocol::client_opcode::get:
+      case protocol::client_opcode::upsert:
+      case protocol::client_opcode::insert:
+      case protocol::client_opcode::replace:
+      case protocol::client_opcode::remove:
+        return send(encode_response(request, document_operation(request)), true);
+
+      case protocol::client_opcode::range_scan_create:
+        return send(encode_response(request, server_.create_range_scan(request)), true);
+
+      case protocol::client_opcode::range_scan_continue:
+        return send(encode_response(request, continue_range_scan(request)), true);
+
+      case protocol::client_opcode::range_scan_cancel: {
+        const std::string uuid{ reinterpret_cast<const char*>(request.extras.data()),
+                                request.extras.size() };
+        if (!server_.cancel_range_scan(uuid)) {
+          return send(encode_response(request, { key_value_status_code::not_found }), true);
+        }
+        return send(encode_response(request, {}), true);
+      }
+
+      default:
+        break;
+    }
+    send(encode_response(request, { key_value_status_code::unknown_command }), false);
+  }
+
+  auto hello(const mock_request& request) -> mock_response
+  {
+    mock_response response{};
+    for (std::size_t i = 0; i + 1 < request.value.size(); i += 2) {
+      const auto feature = static_cast<protocol::hello_feature>(read_uint16(&request.value[i]));
+      switch (feature) {
+        case protocol::hello_feature::snappy:
+          snappy_ = true;
+          break;
+        case protocol::hello_feature::collections:
+          collections_ = true;
+          break;
+        case protocol::hello_feature::mutation_seqno:
+          mutation_tokens_ = true;
+          break;
+        case protocol::hello_feature::tcp_nodelay:
+        case protocol::hello_feature::xattr:
+        case protocol::hello_feature::select_bucket:
+        case protocol::hello_feature::json:
+        case protocol::hello_feature::unordered_execution:
+        case protocol::hello_feature::alt_request_support:
+          break;
+        default:
+          continue;
+      }
+      write_big_endian(response.value, static_cast<std::uint16_t>(feature));
+    }
+    return response;
+  }
+
+  auto authenticate(const mock_request& request) -> mock_response
+  {
+    const std::string payload{ reinterpret_cast<const char*>(request.value.data()),
+                               request.value.size() };
+    const auto& options = server_.options();
+    if (request.key == "SCRAM-SHA512" && options.scram_iteration_count > 0) {
+      return scram_first(payload);
+    }
+    if (request.key != "PLAIN") {
+      return { key_value_status_code::auth_error };
+    }
+    // PLAIN: authzid NUL authcid NUL passwd
+    if (payload.substr(payload.find('\0') + 1) !=
+        options.username + std::string(1, '\0') + options.password) {
+      return { key_value_status_code::auth_error };
+    }
+    return {};
+  }
+
+  /**
+   * client-first-message: "n,,n=<username>,r=<client nonce>"
+   * server-first-message: "r=<client nonce><server nonce>,s=<salt>,i=<iteration count>"
+   */
+  auto scram_first(const std::string& payload) -> mock_response
+  {
+    const auto& options = server_.options();
+    if (payload.rfind("n,,", 0) != 0) {
+      return { key_value_status_code::auth_error };
+    }
+    scram_client_first_bare_ = payload.substr(3);
+    const auto nonce = scram_client_first_bare_.find(",r=");
+    if (nonce == std::string::npos ||
+        scram_client_first_bare_.substr(0, nonce) != "n=" + options.username) {
+      return { key_value_status_code::auth_error };
+    }
+    // the server part of the nonce does not have to be random for the tests
+    scram_server_first_ = fmt::format("r={}6d6f636b,s={},i={}",
+                                      scram_client_first_bare_.substr(nonce + 3),
+                                      couchbase::core::base64::encode(server_.scram_salt()),
+                                      options.scram_iteration_count);
+    mock_response response{ key_value_status_code::auth_continue };
+    response.value = to_bytes(scram_server_first_);
+    return response;
+  }
+
+  /**
+   * client-final-message: "c=biws,r=<nonce>,p=<client proof>"
+   * server-final-message: "v=<server signature>"
+   */
+  auto scram_final(const mock_request& request) -> mock_response
+  {
+    using couchbase::core::crypto::Algorithm;
+    using couchbase::core::crypto::CBC_HMAC;
+
+    const std::string payload{ reinterpret_cast<const char*>(request.value.data()),
+                               request.value.size() };
+    const auto proof_offset = payload.rfind(",p=");
+    if (request.key != "SCRAM-SHA512" || scram_server_first_.empty() ||
+        proof_offset == std::string::npos) {
+      return { key_value_status_code::auth_error };
+    }
+    const auto auth_message = fmt::format(
+      "{},{},{}", scram_client_first_bare_, scram_server_first_, payload.substr(0, proof_offset));
+    const auto& salted_password = server_.scram_salted_password();
+    const auto client_key = CBC_HMAC(Algorithm::ALG_SHA512, salted_password, "Client Key");
+    const auto stored_key = couchbase::core::crypto::digest(Algorithm::ALG_SHA512, client_key);
+    auto expected_proof = CBC_HMAC(Algorithm::ALG_SHA512, stored_key, auth_message);
+    for (std::size_t i = 0; i < expected_proof.size(); ++i) {
+      expected_proof[i] = static_cast<char>(expected_proof[i] ^ client_key[i]);
+    }
+    if (couchbase::core::base64::decode_to_string(payload.substr(proof_offset + 3)) !=
+        expected_proof) {
+      return { key_value_status_code::auth_error };
+    }
+    const auto server_key = CBC_HMAC(Algorithm::ALG_SHA512, salted_password, "Server Key");
+    mock_response response{};
+    response.value = to_bytes(
+      "v=" +
+      couchbase::core::base64::encode(CBC_HMAC(Algorithm::ALG_SHA512, server_key, auth_message)));
+    return response;
+  }
+
+  auto document_operation(const mock_request& request) -> mock_response
+  {
+    std::string key = request.key;
+    if (collections_) {
+      auto encoded = gsl::make_span(reinterpret_cast<std::byte*>(key.data()), key.size());
+      auto [collection_id, remaining] = couchbase::core::utils::decode_unsigned_leb128<std::uint32_t>(
+        encoded, couchbase::core::utils::leb_128_no_throw{});
+      if (remaining.data() == nullptr) {
+        return { key_value_status_code::invalid };
+      }
+      if (collection_id != 0) {
+        return { key_value_status_code::unknown_collection };
+      }
+      key = std::string{ reinterpret_cast<const char*>(remaining.data()), remaining.size() };
+    }
+
+    if (static_cast<protocol::client_opcode>(request.opcode) == protocol::client_opcode::get) {
+      auto document = server_.find(key);
+      if (!document) {
+        return { key_value_status_code::not_found };
+      }
+      mock_response response{};
+      response.cas = document->cas;
+      write_big_endian(response.extras, document->flags);
+      response.datatype = document->datatype;
+      response.value = maybe_compress(std::move(document->value), response.datatype);
+      return response;
+    }
+
+    mock_response response =
+      static_cast<protocol::client_opcode>(request.opcode) == protocol::client_opcode::remove
+        ? server_.remove(request, key)
+        : server_.store(request, std::move(key));
+    if (response.status == key_value_status_code::success && mutation_tokens_) {
+      write_big_endian<std::uint64_t>(response.extras, 0x6d6f636b); // vbucket uuid
+      write_big_endian(response.extras, server_.next_sequence_number());
+    }
+    return response;
+  }
+
+  auto continue_range_scan(const mock_request& request) -> mock_response
+  {
+    if (request.extras.size() < 20) {
+      return { key_value_status_code::invalid };
+    }
+    const std::string uuid{ reinterpret_cast<const char*>(request.extras.data()), 16 };
+    auto batch = server_.continue_range_scan(uuid, read_uint32(request.extras.data() + 16));
+    if (!batch) {
+      return { key_value_status_code::not_found };
+    }
+    auto& [scan, complete] = batch.value();
+
+    mock_response response{};
+    response.status = complete ? key_value_status_code::range_scan_complete
+                               : key_value_status_code::range_scan_more;
+    write_big_endian<std::uint32_t>(response.extras, scan.ids_only ? 0 : 1);
+    for (auto& [key, document] : scan.items) {
+      if (scan.ids_only) {
+        write_leb128(response.value, key.size());
+        const auto key_bytes = to_bytes(key);
+        response.value.insert(response.value.end(), key_bytes.begin(), key_bytes.end());
+        continue;
+      }
+      auto datatype = document.datatype;
+      auto value = maybe_compress(std::move(document.value), datatype);
+      write_big_endian(response.value, document.flags);
+      write_big_endian<std::uint32_t>(response.value, 0); // expiry
+      write_big_endian<std::uint64_t>(response.value, 0); // sequence number
+      write_big_endian(response.value, document.cas);
+      response.value.push_back(static_cast<std::byte>(datatype));
+      write_leb128(response.value, key.size());
+      const auto key_bytes = to_bytes(key);
+      response.value.insert(response.value.end(), key_bytes.begin(), key_bytes.end());
+      write_leb128(response.value, value.size());
+      response.value.insert(response.value.end(), value.begin(), value.end());
+    }
+    return response;
+  }
+
+  auto maybe_compress(std::vector<std::byte> value, std::uint8_t& datatype)
+    -> std::vector<std::byte>
+  {
+    const auto snappy = static_cast<std::uint8_t>(protocol::datatype::snappy);
+    if (!snappy_ || !server_.options().compress_responses || (datatype & snappy) != 0) {
+      return value;
+    }
+    std::vector<std::byte> compressed;
+    if (!protocol::compress_value(value, compressed, 1.0)) {
+      return value;
+    }
+    datatype |= snappy;
+    server_.count_compressed_response();
+    return compressed;
+  }
+
+  void send(std::vector<std::byte> packet, bool delayed)
+  {
+    const auto latency = server_.options().latency;
+    if (!delayed || latency == std::chrono::microseconds::zero()) {
+      return enqueue(std::move(packet));
+    }
+    auto timer = std::make_shared<asio::steady_timer>(socket_.get_executor());
+    timer->expires_after(latency);
+    timer->async_wait(
+      [self = shared_from_this(), timer, packet = std::move(packet)](std::error_code ec) mutable {
+        if (ec == asio::error::operation_aborted) {
+          return;
+        }
+        self->enqueue(std::move(packet));
+      });
+  }
+
+  void enqueue(std::vector<std::byte> packet)
+  {
+    output_.emplace_back(std::move(packet));
+    if (!writing_) {
+      do_write();
+    }
+  }
+
+  void do_write()
+  {
+    if (output_.empty()) {
+      writing_ = false;
+      return;
+    }
+    writing_ = true;
+    // send all queued responses at once
+    std::vector<std::byte> buffer;
+    for (auto& packet : output_) {
+      buffer.insert(buffer.end(), packet.begin(), packet.end());
+    }
+    output_.clear();
+    auto data = std::make_shared<std::vector<std::byte>>(std::move(buffer));
+    asio::async_write(
+      socket_,
+      asio::buffer(*data),
+      [self = shared_from_this(), data](std::error_code ec, std::size_t /* bytes_transferred */) {
+        if (ec) {
+          self->writing_ = false;
+          return;
+        }
+        self->do_write();
+      });
+  }
+
+  asio::ip::tcp::socket socket_;
+  mock_mcbp_server_impl& server_;
+  std::array<std::byte, header_size> header_{};
+  std::vector<std::byte> body_{};
+  std::deque<std::vector<std::byte>> output_{};
+  bool writing_{ false };
+  std::string scram_client_first_bare_{};
+  std::string scram_server_first_{};
+  bool bucket_selected_{ false };
+  bool snappy_{ false };
+  bool collections_{ false };
+  bool mutation_tokens_{ false };
+};
+
+void
+mock_mcbp_server_impl::do_accept()
+{
+  acceptor_.async_accept([this](std::error_code ec, asio::ip::tcp::socket socket) {
+    if (ec) {
+      return;
+    }
+    ++connections_count_;
+    auto connection = std::make_shared<mock_connection>(std::move(socket), *this);
+    connections_.remove_if([](const auto& c) {
+      return c.expired();
+    });
+    connections_.emplace_back(connection);
+    connection->start();
+    do_accept();
+  });
+}
+
+void
+mock_mcbp_server_impl::stop()
+{
+  if (stopped_.exchange(true)) {
+    return;
+  }
+  asio::post(io_, [this]() {
+    std::error_code ignored;
+    acceptor_.close(ignored);
+    for (const auto& c : connections_) {
+      if (auto connection = c.lock(); connection) {
+        connection->stop();
+      }
+    }
+  });
+  // the loop exits as soon as the pending handlers of the closed sockets have been completed
+  work_guard_.reset();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+mock_mcbp_server::mock_mcbp_server(mock_mcbp_server_options options)
+  : impl_{ std::make_unique<mock_mcbp_server_impl>(std::move(options)) }
+{
+}
+
+mock_mcbp_server::~mock_mcbp_server() = default;
+
+auto
+mock_mcbp_server::port() const -> std::uint16_t
+{
+  return impl_->port();
+}
+
+auto
+mock_mcbp_server::connection_string() const -> std::string
+{
+  return fmt::format("couchbase://127.0.0.1:{}", impl_->port());
+}
+
+auto
+mock_mcbp_server::options() const -> const mock_mcbp_server_options&
+{
+  return impl_->options();
+}
+
+auto
+mock_mcbp_server::stats() const -> mock_mcbp_server_stats
+{
+  return impl_->stats();
+}
+
+void
+mock_mcbp_server::upsert(const std::string& key,
+                         std::vector<std::byte> value,
+                         std::uint32_t flags,
+                         std::uint8_t datatype)
+{
+  impl_->upsert(key, std::move(value), flags, datatype);
+}
+
+void
+mock_mcbp_server::stop()
+{
+  impl_->stop();
+}
+
+auto
+connect(const mock_mcbp_server& server) -> couchbase::cluster
+{
+  const auto& options = server.options();
+  auto authenticator = options.scram_iteration_count > 0
+                         ? couchbase::password_authenticator{ options.username, options.password }
+                         : couchbase::password_authenticator::ldap_compatible(options.username,
+                                                                               options.password);
+  auto [err, cluster] =
+    couchbase::cluster::connect(server.connection_string(),
+                                couchbase::cluster_options{ std::move(authenticator) })
+      .get();
+  if (err.ec()) {
+    throw std::runtime_error(fmt::format("unable to connect to mock server: {}", err.message()));
+  }
+  return cluster;
+}
+} // namespace test::utils
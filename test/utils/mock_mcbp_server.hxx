@@ -0,0 +1,108 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2025-Present Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include <couchbase/cluster.hxx>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace test::utils
+{
+struct mock_mcbp_server_options {
+  std::string bucket_name{ "default" };
+  std::string username{ "Administrator" };
+  std::string password{ "password" };
+  /// number of vbuckets in the bucket configuration, all of them are active on the mock
+  std::uint16_t number_of_vbuckets{ 64 };
+  /// delay before the response to each data operation
+  std::chrono::microseconds latency{ 0 };
+  /// reply with "not my vbucket" to every N-th data operation, zero disables injection
+  std::size_t not_my_vbucket_every{ 0 };
+  /// compress the values in the responses, if the client has negotiated snappy
+  bool compress_responses{ false };
+  /// number of items in the range scan batch, unless the client asks for less
+  std::uint32_t range_scan_batch_item_limit{ 50 };
+  /// advertise SCRAM-SHA512 with the given iteration count of the server secret, zero leaves
+  /// PLAIN as the only mechanism
+  std::uint32_t scram_iteration_count{ 0 };
+};
+
+struct mock_mcbp_server_stats {
+  std::size_t connections{};
+  std::size_t requests{};
+  std::size_t injected_not_my_vbucket{};
+  std::size_t compressed_responses{};
+};
+
+class mock_mcbp_server_impl;
+
+/**
+ * Memcached binary protocol server, that runs on the loopback interface of the test process, so
+ * that the KV path of the SDK can be exercised and benchmarked without the cluster.
+ *
+ * The server keeps the documents in memory and implements just enough of the protocol for the
+ * bootstrap (HELLO, SASL, select_bucket, get_cluster_config, get_collection_id) and for
+ * get, upsert, insert, replace, remove and range scans on the default collection.
+ *
+ * Unless mock_mcbp_server_options::scram_iteration_count is set, only PLAIN authentication is
+ * supported, so the cluster has to be opened with
+ * couchbase::password_authenticator::ldap_compatible(). connect() picks the authenticator.
+ */
+class mock_mcbp_server
+{
+public:
+  explicit mock_mcbp_server(mock_mcbp_server_options options = {});
+  mock_mcbp_server(const mock_mcbp_server&) = delete;
+  mock_mcbp_server(mock_mcbp_server&&) = delete;
+  auto operator=(const mock_mcbp_server&) -> mock_mcbp_server& = delete;
+  auto operator=(mock_mcbp_server&&) -> mock_mcbp_server& = delete;
+  ~mock_mcbp_server();
+
+  [[nodiscard]] auto port() const -> std::uint16_t;
+  [[nodiscard]] auto connection_string() const -> std::string;
+  [[nodiscard]] auto options() const -> const mock_mcbp_server_options&;
+  [[nodiscard]] auto stats() const -> mock_mcbp_server_stats;
+
+  /**
+   * Stores the document directly, bypassing the network.
+   */
+  void upsert(const std::string& key,
+              std::vector<std::byte> value,
+              std::uint32_t flags = 0,
+              std::uint8_t datatype = 0x01 /* json */);
+
+  void stop();
+
+private:
+  std::unique_ptr<mock_mcbp_server_impl> impl_;
+};
+
+/**
+ * Opens the cluster on the mock server with the credentials from its options. The client uses
+ * SCRAM when the server has been configured for it, otherwise PLAIN.
+ *
+ * @throws std::runtime_error if the cluster cannot be opened
+ */
+[[nodiscard]] auto
+connect(const mock_mcbp_server& server) -> couchbase::cluster;
+} // namespace test::utils
@@ -88,6 +88,11 @@ public:
                "Server group name for --replica-read-mode=selected_server_group*.")
       ->transform(CLI::IsMember(allowed_replica_read_modes));
 
+    add_flag("--batch",
+             batch_,
+             "Fetch all IDs with one batch operation (not compatible with --use-replica and "
+             "--inlined-keyspace).");
+
     add_flag("--hexdump",
              hexdump_,
              "Print value using hexdump encoding (safe for binary data on STDOUT).");
@@ -106,6 +111,10 @@ public:
   {
     apply_logger_options(common_options_.logger);
 
+    if (batch_ && (inlined_keyspace_ || (!use_replica_.empty() && use_replica_ != "none"))) {
+      fail("--batch cannot be combined with --inlined-keyspace or --use-replica");
+    }
+
     auto cluster_options = build_cluster_options(common_options_);
 
     if (auto server_group = replica_server_group_; server_group) {
@@ -122,6 +131,12 @@ public:
         "Failed to connect to the cluster at \"{}\": {}", connection_string, connect_err));
     }
 
+    if (batch_) {
+      get_batch(cluster);
+      cluster.close().get();
+      return 0;
+    }
+
     for (const auto& id : ids_) {
       auto bucket_name = bucket_name_;
       auto scope_name = scope_name_;
@@ -202,6 +217,29 @@ public:
   }
 
 private:
+  void get_batch(const couchbase::cluster& cluster) const
+  {
+    auto collection = cluster.bucket(bucket_name_).scope(scope_name_).collection(collection_name_);
+
+    couchbase::get_options get_options{};
+    if (with_expiry_) {
+      get_options.with_expiry(true);
+    }
+    if (!projections_.empty()) {
+      get_options.project(projections_);
+    }
+
+    auto results = collection.get_multi(ids_, get_options).get();
+    for (const auto& id : ids_) {
+      const auto& [err, resp] = results.at(id);
+      if (json_lines_) {
+        print_result_json_line(bucket_name_, scope_name_, collection_name_, id, err, resp);
+      } else {
+        print_result(bucket_name_, scope_name_, collection_name_, id, err, resp);
+      }
+    }
+  }
+
   void print_result_json_line(const std::string& bucket_name,
                               const std::string& scope_name,
                               const std::string& collection_name,
@@ -392,6 +430,7 @@ private:
   bool pretty_json_{ false };
   bool json_lines_{ false };
   bool verbose_{ false };
+  bool batch_{ false };
 
   std::string use_replica_{ "none" };
   std::string replica_read_mode_{ "no_preference" };
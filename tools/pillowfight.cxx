@@ -42,6 +42,7 @@
 #include <deque>
 #include <memory>
 #include <numeric>
+#include <optional>
 #include <random>
 #include <thread>
 
@@ -352,6 +353,10 @@ public:
       ->default_val(default_operation_batch_size);
     add_option("--batch-wait", batch_wait_, "Time to wait after the batch.")
       ->default_val(default_batch_wait);
+    add_flag("--use-multi-operations",
+             use_multi_operations_,
+             "Send the gets and deletes of the batch, and the populated keys, with get_multi, "
+             "remove_multi and upsert_multi operations.");
     add_option("--query-statement",
                query_statement_,
                "The N1QL query statement to use ({bucket_name}, {scope_name} and {collection_name} "
@@ -519,6 +524,9 @@ private:
                                std::future<std::pair<couchbase::error, couchbase::query_result>>>>>
         futures;
 
+      std::vector<std::string> get_ids{};
+      std::vector<std::string> remove_ids{};
+
       auto known_keys_distribution =
         std::uniform_int_distribution<std::size_t>(0, known_keys.size() - 1);
       for (std::size_t i = 0; i < operation_batch_size_; ++i) {
@@ -528,6 +536,10 @@ private:
                                     : uniq_id("id");
         switch (operation) {
           case operation::cmd_get:
+            if (use_multi_operations_) {
+              get_ids.push_back(document_id);
+              break;
+            }
             futures.emplace_back(std::chrono::system_clock::now(), collection.get(document_id));
             break;
           case operation::cmd_replace:
@@ -535,6 +547,10 @@ private:
                                  collection.replace<raw_json_transcoder>(document_id, json_doc));
             break;
           case operation::cmd_delete:
+            if (use_multi_operations_) {
+              remove_ids.push_back(document_id);
+              break;
+            }
             futures.emplace_back(std::chrono::system_clock::now(), collection.remove(document_id));
             break;
           case operation::cmd_insert:
@@ -549,6 +565,16 @@ private:
         }
       }
 
+      const auto multi_start = std::chrono::system_clock::now();
+      std::optional<std::future<couchbase::get_multi_result>> get_multi{};
+      if (!get_ids.empty()) {
+        get_multi.emplace(collection.get_multi(std::move(get_ids)));
+      }
+      std::optional<std::future<couchbase::remove_multi_result>> remove_multi{};
+      if (!remove_ids.empty()) {
+        remove_multi.emplace(collection.remove_multi(std::move(remove_ids)));
+      }
+
       for (auto&& [start, future] : futures) {
         std::visit(
           [&stopping, start = start, verbose = verbose_](auto f) mutable {
@@ -573,6 +599,13 @@ private:
           std::move(future));
       }
 
+      if (get_multi) {
+        wait_for_multi_operation(multi_start, std::move(get_multi.value()), stopping);
+      }
+      if (remove_multi) {
+        wait_for_multi_operation(multi_start, std::move(remove_multi.value()), stopping);
+      }
+
       if (stopping || (operations_limit_ > 0 && total >= operations_limit_)) {
         running.clear();
       } else {
@@ -584,6 +617,35 @@ private:
     running.clear();
   }
 
+  /**
+   * Waits for the batch, and records the latency of the whole batch for each of its operations.
+   */
+  template<typename Results>
+  void wait_for_multi_operation(std::chrono::system_clock::time_point start,
+                                std::future<Results> future,
+                                bool& stopping) const
+  {
+    while (future.wait_for(std::chrono::milliseconds{ 200 }) != std::future_status::ready) {
+      if (!running.test_and_set()) {
+        stopping = true;
+        running.clear();
+        return;
+      }
+    }
+    const auto latency = (std::chrono::system_clock::now() - start).count();
+    for (const auto& [document_id, outcome] : future.get()) {
+      hdr_record_value_atomic(histogram, latency);
+      ++total;
+      if (const auto& err = outcome.first; err.ec()) {
+        const std::scoped_lock lock(errors_mutex);
+        ++errors[err.ec()];
+        if (verbose_) {
+          fmt::print(stderr, "\r\033[K{}\n", err.ctx().to_json());
+        }
+      }
+    }
+  }
+
   void populate_keys(const couchbase::cluster& cluster,
                      std::vector<std::vector<std::string>>& known_keys) const
   {
@@ -611,6 +673,25 @@ private:
 
         auto batch_size = std::min(keys_left, std::max(operation_batch_size_, minimum_batch_size));
 
+        if (use_multi_operations_) {
+          std::vector<std::pair<std::string, std::vector<std::byte>>> documents{};
+          documents.reserve(batch_size);
+          for (std::size_t k = 0; k < batch_size; ++k) {
+            documents.emplace_back(uniq_id("id"), json_doc);
+          }
+          for (auto& [document_id, outcome] :
+               collection.upsert_multi<raw_json_transcoder>(std::move(documents)).get()) {
+            if (outcome.first.ec()) {
+              ++retried_keys;
+            } else {
+              known_keys[i].emplace_back(document_id);
+              ++stored_keys;
+              --keys_left;
+            }
+          }
+          continue;
+        }
+
         std::vector<std::pair<std::string,
                               std::future<std::pair<couchbase::error, couchbase::mutation_result>>>>
           futures;
@@ -652,6 +733,7 @@ private:
   bool verbose_{ false };
   std::size_t operation_batch_size_{};
   std::chrono::milliseconds batch_wait_{};
+  bool use_multi_operations_{ false };
   std::size_t number_of_io_threads_{};
   std::size_t number_of_worker_threads_{};
   std::size_t number_of_keys_to_populate_{};
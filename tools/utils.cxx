@@ -322,6 +322,9 @@ add_options(CLI::App* app, compression_options& options)
                  options.minimum_ratio,
                  "The minimum compression ratio to allow compressed form to be used.")
     ->default_val(defaults.compression.min_ratio);
+  group->add_flag("--disable-adaptive-compression",
+                  options.disable_adaptive,
+                  "Keep compressing values even if they repeatedly do not compress well.");
 }
 
 void
@@ -364,6 +367,10 @@ add_options(CLI::App* app, network_options& options)
                  "Period to wait before calling HTTP connection idle.")
     ->default_val(defaults.network.idle_http_connection_timeout)
     ->type_name("DURATION");
+  group
+    ->add_option(
+      "--io-threads", options.num_io_threads, "Number of threads to drive IO of the cluster.")
+    ->default_val(defaults.network.num_io_threads);
 }
 
 void
@@ -409,6 +416,16 @@ add_options(CLI::App* app, transactions_options& options)
   group->add_option("--transactions-cleanup-window", options.cleanup_window, "Cleanup window.")
     ->default_val(defaults.transactions.cleanup_config.cleanup_window)
     ->type_name("DURATION");
+  group
+    ->add_option("--transactions-cleanup-max-concurrent-atr-reads",
+                 options.cleanup_max_concurrent_atr_reads,
+                 "Maximum number of ATRs read concurrently by the lost attempts cleanup.")
+    ->default_val(defaults.transactions.cleanup_config.max_concurrent_atr_reads);
+  group
+    ->add_option("--transactions-cleanup-max-atr-reads-per-second",
+                 options.cleanup_max_atr_reads_per_second,
+                 "Maximum rate of ATR reads by the lost attempts cleanup (0 for unlimited).")
+    ->default_val(defaults.transactions.cleanup_config.max_atr_reads_per_second);
   group->add_flag("--transactions-cleanup-ignore-lost-attempts",
                   options.cleanup_ignore_lost_attempts,
                   "Do not cleanup lost attempts.");
@@ -734,6 +751,7 @@ apply_options(couchbase::cluster_options& options, const compression_options& co
   options.compression().enabled(!compression.disable);
   options.compression().min_size(compression.minimum_size);
   options.compression().min_ratio(compression.minimum_ratio);
+  options.compression().adaptive(!compression.disable_adaptive);
 }
 
 void
@@ -756,6 +774,7 @@ apply_options(couchbase::cluster_options& options, const network_options& networ
   options.network().tcp_keep_alive_interval(network.tcp_keep_alive_interval);
   options.network().config_poll_interval(network.config_poll_interval);
   options.network().idle_http_connection_timeout(network.idle_http_connection_timeout);
+  options.network().num_io_threads(network.num_io_threads);
 }
 
 void
@@ -795,6 +814,10 @@ apply_options(couchbase::cluster_options& options, const transactions_options& t
   options.transactions().cleanup_config().cleanup_client_attempts(
     !transactions.cleanup_ignore_client_attempts);
   options.transactions().cleanup_config().cleanup_window(transactions.cleanup_window);
+  options.transactions().cleanup_config().max_concurrent_atr_reads(
+    transactions.cleanup_max_concurrent_atr_reads);
+  options.transactions().cleanup_config().max_atr_reads_per_second(
+    transactions.cleanup_max_atr_reads_per_second);
 }
 
 #ifdef COUCHBASE_CXX_CLIENT_BUILD_OPENTELEMETRY
@@ -123,6 +123,7 @@ struct compression_options {
   bool disable{ false };
   std::size_t minimum_size{};
   double minimum_ratio{};
+  bool disable_adaptive{ false };
 };
 
 struct dns_srv_options {
@@ -136,6 +137,7 @@ struct network_options {
   std::chrono::milliseconds tcp_keep_alive_interval{};
   std::chrono::milliseconds config_poll_interval{};
   std::chrono::milliseconds idle_http_connection_timeout{};
+  std::size_t num_io_threads{};
 };
 
 struct transactions_options {
@@ -148,6 +150,8 @@ struct transactions_options {
   bool cleanup_ignore_lost_attempts{};
   bool cleanup_ignore_client_attempts{};
   std::chrono::milliseconds cleanup_window{};
+  std::size_t cleanup_max_concurrent_atr_reads{};
+  std::size_t cleanup_max_atr_reads_per_second{};
 };
 
 struct opentelemetry_metrics_options {